@@ -0,0 +1,137 @@
+"""
+Gera src/RemoteIOBoards.h a partir de data_files/*/model.json.
+
+Cada placa vira um perfil constexpr (ref, pino, tipo e nível seguro de cada
+IO), escolhido
+em compilação por -DREMOTEIO_BOARD=BOARD_<modelo>. O nível seguro vem do
+campo "safe" ("LOW" ou "HIGH") de cada pino, LOW quando ausente; pinos de
+strapping, como GPIO2 (HIGH) e GPIO15 (LOW), precisam dele. Roda antes de cada build
+do PlatformIO (extra_scripts = pre:scripts/board_profiles.py) ou direto:
+
+    python scripts/board_profiles.py
+
+O header só é reescrito quando o conteúdo muda, para não forçar recompilação.
+"""
+
+import glob
+import json
+import os
+import re
+
+IO_TYPES = {
+    "OUTPUT": "IO_OUTPUT",
+    "INPUT": "IO_INPUT",
+    "INPUT_PULLUP": "IO_INPUT_PULLUP",
+    "INPUT_PULLDOWN": "IO_INPUT_PULLDOWN",
+    "INPUT_ANALOG": "IO_INPUT_ANALOG",
+}
+
+SAFE_LEVELS = ("LOW", "HIGH")
+
+HEADER = """/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Perfis das placas: tabela de IOs de cada modelo, gerada por    ##
+##   scripts/board_profiles.py a partir de data_files. Não editar.  ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOBoards_h
+#define RemoteIOBoards_h
+
+#include <stdint.h>
+
+#define BOARD_PIN_VIRTUAL 0xFF   // ref sem pino físico ("pin": "")
+
+struct BoardPin
+{
+  const char *ref;
+  uint8_t pin;
+  uint8_t type;           // IO_NONE, IO_OUTPUT, IO_INPUT...
+  uint8_t safeLevel;      // LOW ou HIGH, nível das saídas no boot ("safe" em model.json)
+};
+
+struct BoardProfile
+{
+  const char *model;
+  const BoardPin *pins;
+  uint8_t count;
+};
+"""
+
+FOOTER = """
+#endif
+"""
+
+
+def identifier(model):
+    return re.sub(r"[^A-Za-z0-9]", "_", model).upper()
+
+
+def load_profiles(project_dir):
+    profiles = []
+
+    for path in sorted(glob.glob(os.path.join(project_dir, "data_files", "*", "model.json"))):
+        with open(path, encoding="utf-8") as file:
+            model = json.load(file)
+
+        pins = []
+        for item in model.get("gpio", []):
+            pin = str(item.get("pin", "")).strip()
+            safe = item.get("safe", "LOW")
+            if safe not in SAFE_LEVELS:
+                raise ValueError('%s: "safe" de %s deve ser LOW ou HIGH' % (path, item["ref"]))
+            pins.append((item["ref"], int(pin) if pin else None, IO_TYPES.get(item.get("type"), "IO_NONE"), safe))
+
+        profiles.append((model["model"], pins))
+
+    return profiles
+
+
+def render(profiles):
+    lines = [HEADER]
+
+    for index, (model, _) in enumerate(profiles):
+        lines.append("#define BOARD_%s %d" % (identifier(model), index))
+    lines.append("#define BOARD_PROFILE_COUNT %d" % len(profiles))
+    lines.append("")
+
+    for model, pins in profiles:
+        lines.append("static constexpr BoardPin BOARD_PINS_%s[] = {" % identifier(model))
+        for ref, pin, io_type, safe in pins:
+            lines.append('  { "%s", %s, %s, %s },' % (ref, "BOARD_PIN_VIRTUAL" if pin is None else pin, io_type, safe))
+        lines.append("};")
+        lines.append("")
+
+    lines.append("static constexpr BoardProfile BOARD_PROFILES[BOARD_PROFILE_COUNT] = {")
+    for model, pins in profiles:
+        name = identifier(model)
+        lines.append('  { "%s", BOARD_PINS_%s, %d },' % (model, name, len(pins)))
+    lines.append("};")
+    lines.append(FOOTER)
+
+    return "\n".join(lines)
+
+
+def generate(project_dir):
+    output = os.path.join(project_dir, "src", "RemoteIOBoards.h")
+    content = render(load_profiles(project_dir))
+
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as file:
+            if file.read() == content:
+                return
+
+    with open(output, "w", encoding="utf-8", newline="\r\n") as file:
+        file.write(content)
+    print("board_profiles: %s atualizado" % output)
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,103 @@
+"""
+Gera src/index_html.h a partir de web/index.html.
+
+A página do portal de configuração é minificada, comprimida com gzip e gravada
+como array PROGMEM, junto do tamanho e de um ETag forte (hash do conteúdo).
+Roda antes de cada build do PlatformIO (extra_scripts = pre:scripts/web_assets.py)
+ou direto:
+
+    python scripts/web_assets.py
+
+O gzip é gerado sem data e nome de arquivo, então o mesmo HTML produz sempre os
+mesmos bytes e o mesmo ETag; o header só é reescrito quando o conteúdo muda.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+HEADER = """/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Portal de configuração (web/index.html) minificado e gzip,     ##
+##   gerado por scripts/web_assets.py. Não editar.                  ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef INDEX_HTML_H
+#define INDEX_HTML_H
+
+#include <pgmspace.h>
+
+// %d bytes do HTML original, %d minificado
+#define PAGE_SETUP_GZ_LENGTH %d
+#define PAGE_SETUP_ETAG "\\"%s\\""
+
+const uint8_t page_setup_gz[PAGE_SETUP_GZ_LENGTH] PROGMEM = {
+"""
+
+FOOTER = """};
+
+#endif
+"""
+
+
+def minify_css(match):
+    css = re.sub(r"/\*.*?\*/", "", match.group(2), flags=re.S)
+    css = re.sub(r"\s*([{};,])\s*", r"\1", css)
+    css = re.sub(r":\s+", ":", css)
+    css = re.sub(r"\s+", " ", css).strip()
+    return match.group(1) + css + match.group(3)
+
+
+def minify(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    html = re.sub(r"(<style[^>]*>)(.*?)(</style>)", minify_css, html, flags=re.S | re.I)
+
+    # só remove indentação e linhas vazias: quebras de linha são mantidas entre tags e textos
+    lines = [line.strip() for line in html.splitlines()]
+    return "\n".join(line for line in lines if line)
+
+
+def render(source, minified, compressed):
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
+    lines = [HEADER % (len(source), len(minified), len(compressed), etag)]
+
+    for offset in range(0, len(compressed), 16):
+        chunk = compressed[offset:offset + 16]
+        lines.append("  " + ", ".join("0x%02x" % byte for byte in chunk) + ",\n")
+
+    lines.append(FOOTER)
+    return "".join(lines)
+
+
+def generate(project_dir):
+    source_path = os.path.join(project_dir, "web", "index.html")
+    output = os.path.join(project_dir, "src", "index_html.h")
+
+    with open(source_path, encoding="utf-8") as file:
+        source = file.read()
+
+    minified = minify(source).encode("utf-8")
+    compressed = gzip.compress(minified, compresslevel=9, mtime=0)
+    content = render(source.encode("utf-8"), minified, compressed)
+
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as file:
+            if file.read() == content:
+                return
+
+    with open(output, "w", encoding="utf-8", newline="\r\n") as file:
+        file.write(content)
+    print("web_assets: %s atualizado (%d -> %d bytes)" % (output, len(source), len(compressed)))
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO/SCons)
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -9,13 +9,40 @@
 ######################################################################
 */
 
-#include "ESP8266RemoteIO.h";
-#include "index_html.h";
-
-RemoteIO::RemoteIO()
+#include "ESP8266RemoteIO.h"
+#include "index_html.h"
+#include "RemoteIOEvent.h"
+#include <StreamString.h>
+
+static const char JOIN_ROOM_FRAME[] = "[\"joinRoom\"]";
+
+// orçamento de RAM estática: a instância (tabela de IO, filas, arena JSON) é global no firmware;
+// só vale para o layout de 32 bits do ESP8266, não para o build nativo dos testes
+#ifdef ARDUINO
+static_assert(sizeof(RemoteIO) <= REMOTEIO_STATIC_RAM_BUDGET, "RemoteIO excede REMOTEIO_STATIC_RAM_BUDGET");
+#endif
+
+static_assert(IO_TABLE_CAPACITY <= SCHEDULER_CAPACITY, "IO_TABLE_CAPACITY excede SCHEDULER_CAPACITY");
+
+#ifdef REMOTEIO_BOARD
+static_assert((REMOTEIO_BOARD >= 0) && (REMOTEIO_BOARD < BOARD_PROFILE_COUNT), "REMOTEIO_BOARD deve ser um BOARD_<modelo> de RemoteIOBoards.h");
+#endif
+
+RemoteIO::RemoteIO() :
+  wifiBackoff(WIFI_BACKOFF_BASE, WIFI_BACKOFF_MAX),
+  authBackoff(AUTH_BACKOFF_BASE, AUTH_BACKOFF_MAX),
+  socketBackoff(SOCKET_BACKOFF_BASE, SOCKET_BACKOFF_MAX),
+  uplinkBackoff(UPLINK_BACKOFF_BASE, UPLINK_BACKOFF_MAX)
 {
   _appPort = 5000;
   server = new AsyncWebServer(80);
+  localSocket = new AsyncWebSocket("/ws");
+  localServerOpen = false;
+  provisioned = false;
+  localCommandHead = 0;
+  localCommandTail = 0;
+  localCommandsDropped = 0;
+  localCleanupTimestamp = 0;
 
   appBaseUrl = "https://api.nodeiot.app.br/api";
   appVerifyUrl = appBaseUrl + "/devices/verify";
@@ -26,6 +53,19 @@ RemoteIO::RemoteIO()
     
   configurations = configurationDocument.to<JsonArray>();
   setIO = configurations.createNestedObject();
+  ioCount = 0;
+
+
+  inputEventHead = 0;
+  inputEventTail = 0;
+  inputEventsDropped = 0;
+  analogPollTimestamp = 0;
+
+  adcHead = 0;
+  adcTail = 0;
+  adcDropped = 0;
+  adcFiltered = -1;
+  aggregateCount = 0;
 
   Connected = false;
   Socketed = 0;
@@ -35,37 +75,151 @@ RemoteIO::RemoteIO()
   next_state = INICIALIZATION;
 
   start_debounce_time = 0;
-  start_reconnect_time = 0;
-  reconnect_counter = 0;
+
+  link_state = LINK_IDLE;
+
+  userCallback = nullptr;
+  userContext = nullptr;
+  storedCallbackFunction = nullptr;
+
+  restart_requested = false;
+  restart_timestamp = 0;
+  restart_delay = 0;
+
+  // sessão HTTPS única (keep-alive e retomada de sessão TLS), avançada a cada loop()
+  httpsOwner = HTTPS_OWNER_NONE;
+  httpsAuthorized = false;
+  httpsRecorded = false;
+  httpsStart = 0;
+  tlsSized = false;
+
+  uplinkHead = 0;
+  uplinkCount = 0;
+  uplinkBatchSize = UPLINK_BATCH_SIZE;
+  uplinkInFlight = 0;
+  uplinkFlushReason = nullptr;
+  uplinkFlushRequested = false;
+  uplinkMaxLatency = UPLINK_BATCH_LATENCY;
+  uplinkOldestTime = 0;
+  memset(&uplinkStats, 0, sizeof(uplinkStats));
+  socketUplink = false;
+  journalReplayTimestamp = 0;
+  journalInFlight = 0;
+  journalAttempts = 0;
+
+  outputsDirty = false;
+  outputsSavedTimestamp = 0;
+  revalidatePending = false;
+  revalidateTimestamp = 0;
+  memset(&bootMetrics, 0, sizeof(bootMetrics));
+  board = nullptr;
+
+  wireMsgPack = false;
+
+  metrics.setArena(&jsonArena);
+  describeMemory();
+  metricsPushInterval = 0;
+  metricsPushTimestamp = 0;
+
+  memset(&wifiLease, 0, sizeof(wifiLease));
+  memset(&wifiStats, 0, sizeof(wifiStats));
+  wifiJoinDirected = false;
+  wifiLeaseUnverified = false;
+  leaseProbe = LEASE_PROBE_IDLE;
+  leaseProbeTimestamp = 0;
+  leaseProbeResume = LINK_IDLE;
+  wifiDirectStreak = 0;
+  wifiJoinStart = 0;
+  wifiJoinTimestamp = 0;
+}
+
+void RemoteIO::describeMemory()
+{
+  // relatório da RAM estática por membro, no log do begin() e nas métricas; o restante
+  // (Strings, backoffs, estados e o próprio socket) entra como "other"
+  const MetricsMemoryEntry parts[] = {
+    { "io_table", sizeof(ioTable) + sizeof(ioIndex) + sizeof(irqContexts) },
+    { "input_events", sizeof(inputEvents) },
+    { "input_schedule", sizeof(inputSchedule) },
+    { "adc", sizeof(adcRing) + sizeof(adcFilter) },
+    { "aggregates", sizeof(aggregates) },
+    { "rules", sizeof(rules) },
+    { "local_commands", sizeof(localCommands) },
+    { "uplink_queue", sizeof(uplinkQueue) },
+    { "json_arena", sizeof(jsonArena) },
+    { "https", sizeof(httpsSession) + sizeof(latestArray) },
+    { "journal", sizeof(journal) },
+    { "metrics", sizeof(metrics) },
+  };
+  uint32_t listed = 0;
+
+  for (const MetricsMemoryEntry &part : parts)
+  {
+    metrics.addMemory(part.name, part.bytes);
+    listed += part.bytes;
+  }
+  metrics.addMemory("other", sizeof(RemoteIO) - listed);
 }
 
 void RemoteIO::begin(void (*userCallbackFunction)(String ref, String value))
 {
   storedCallbackFunction = userCallbackFunction;
+  begin(userCallbackFunction != nullptr ? legacyCallbackAdapter : nullptr, this);
+}
+
+void RemoteIO::begin(RemoteIOCallback callback, void *context)
+{
+  userCallback = callback;
+  userContext = context;
+
+#ifdef REMOTEIO_BOARD
+  // placa definida em compilação: saídas em estado seguro antes de qualquer acesso à flash ou à rede
+  board = &BOARD_PROFILES[REMOTEIO_BOARD];
+  _model = board->model;
+  applyBoardProfile();
+#endif
+
   Serial.begin(115200);
+  REMOTEIO_LOGI("[begin] RAM estática: %u bytes, heap livre: %u", (unsigned)sizeof(RemoteIO), (unsigned)ESP.getFreeHeap());
+  for (uint8_t i = 0; i < metrics.memoryEntries(); i++)
+  {
+    REMOTEIO_LOGI("[begin]   %s: %lu bytes", metrics.memoryEntry(i).name, (unsigned long)metrics.memoryEntry(i).bytes);
+  }
 
   if (!SPIFFS.begin()) 
   {
-    Serial.println("Erro ao montar o sistema de arquivos");
+    REMOTEIO_LOGE("Erro ao montar o sistema de arquivos");
+    remoteIOLog.drain(Serial);
     ESP.restart();
   }
 
+  journal.begin(SPIFFS);
+
+  // horário real para os timestamps, inclusive das amostras guardadas no diário
+  configTime(0, 0, "pool.ntp.org", "time.google.com");
+
+#ifndef REMOTEIO_BOARD
   getPCBModel();
+  applyBoardProfile();
+#endif
+  if (board != nullptr) REMOTEIO_LOGI("[begin] Placa %s, saídas em estado seguro em %lu us", _model.c_str(), (unsigned long)bootMetrics.boardDefaults);
+
+  // boot rápido: pinos e saídas voltam ao último estado antes do ponto de acesso e da rede
+  restoreBootCache();
 
-  JsonDocument nvsDoc;
-  bool hasConfig = true;
-  File file = SPIFFS.open("/config.json", "r");
+  recoverConfig();
+
+  JsonDocument nvsDoc(&jsonArena);
+  File file = SPIFFS.open(CONFIG_FILE, "r");
 
   if (!file) 
   {
-    Serial.println("[begin] Não encontrei credenciais na spiffs");
-    hasConfig = false;
+    REMOTEIO_LOGI("[begin] Não encontrei credenciais na spiffs");
   }
   else 
   {
-    Serial.println("[begin] Encontrei credenciais na spiffs");
+    REMOTEIO_LOGI("[begin] Encontrei credenciais na spiffs");
     deserializeJson(nvsDoc, file);
-    serializeJson(nvsDoc, Serial);
   }
   file.close();
 
@@ -73,13 +227,32 @@ void RemoteIO::begin(void (*userCallbackFunction)(String ref, String value))
   _deviceId = nvsDoc["deviceId"].as<String>();
   _ssid = nvsDoc["ssid"].as<String>();
   _password = nvsDoc["password"].as<String>();
+  loadWiFiLease(nvsDoc["wifiCache"].as<JsonObject>());
+
+  // chave da API local: gerada no primeiro boot e mantida junto das credenciais
+  localKey = nvsDoc["localKey"] | "";
+  if (localKey.length() < LOCAL_KEY_LENGTH)
+  {
+    char key[LOCAL_KEY_LENGTH + 1];
+    for (int i = 0; i < LOCAL_KEY_LENGTH; i++) key[i] = "0123456789abcdef"[secureRandom(16)];
+    key[LOCAL_KEY_LENGTH] = '\0';
+    localKey = key;
+
+    // gravada mesmo sem credenciais: a chave não muda a cada boot até a configuração
+    nvsDoc["localKey"] = localKey;
+    writeConfig(nvsDoc);
+  }
+  // o registro também sai por /log e pela serial: só o início da chave, em qualquer nível
+  REMOTEIO_LOGI("[begin] API local: usuário %s, chave %.4s...", LOCAL_API_USER, localKey.c_str());
+
+  provisioned = (_ssid != "") && (_ssid != "null") && (_password != "") && (_password != "null");
 
   startAccessPoint();
   openLocalServer();
 
-  if ((_ssid != "") && (_ssid != "null") && (_password != "") && (_password != "null"))
+  if (provisioned)
   {
-    nodeIotConnection(userCallbackFunction);
+    nodeIotConnection();
   }
 }
 
@@ -89,15 +262,63 @@ void RemoteIO::getPCBModel()
   
   if (!file)
   {
-    Serial.println("Failed to open file for reading");
+    REMOTEIO_LOGE("Failed to open file for reading");
   }
 
-  JsonDocument document;
+  JsonDocument document(&jsonArena);
   deserializeJson(document, file);
   file.close();
 
   if (document["model"].as<String>() == "") _model = "ESP_8266";
   else _model = document["model"].as<String>();
+
+  for (int i = 0; i < BOARD_PROFILE_COUNT; i++)
+  {
+    if (_model == BOARD_PROFILES[i].model) board = &BOARD_PROFILES[i];
+  }
+}
+
+void RemoteIO::applyBoardProfile()
+{
+  if (board == nullptr) return;
+
+  for (uint8_t i = 0; i < board->count; i++)
+  {
+    const BoardPin &io = board->pins[i];
+
+    if ((io.pin == BOARD_PIN_VIRTUAL) || (io.type != IO_OUTPUT)) continue;
+
+    // nível gravado antes do modo: a saída já nasce no estado seguro, que nos pinos de
+    // strapping (GPIO2 em HIGH, GPIO15 em LOW) é o exigido pelo próximo boot
+    digitalWrite(io.pin, io.safeLevel);
+    pinMode(io.pin, OUTPUT);
+  }
+
+  bootMetrics.boardDefaults = micros();
+}
+
+bool RemoteIO::boardAccepts(int pin, uint8_t type)
+{
+  // virtuais e a entrada analógica (A0) não ocupam GPIO
+  if ((type == IO_NONE) || (type == IO_INPUT_ANALOG)) return true;
+
+  // GPIO6 a GPIO11 são ligados à flash
+  if ((pin < 0) || (pin > 16) || ((pin >= 6) && (pin <= 11))) return false;
+
+  if (board == nullptr) return true;
+
+  bool hasOutputs = false;
+
+  for (uint8_t i = 0; i < board->count; i++)
+  {
+    const BoardPin &io = board->pins[i];
+
+    if (io.type == IO_OUTPUT) hasOutputs = true;
+    if (io.pin == pin) return (io.type == IO_OUTPUT) == (type == IO_OUTPUT);
+  }
+
+  // placas com relés: saídas só nos pinos dos relés; entradas livres nos demais pinos
+  return !(hasOutputs && (type == IO_OUTPUT));
 }
 
 void RemoteIO::startAccessPoint()
@@ -110,40 +331,62 @@ void RemoteIO::startAccessPoint()
   
   if (!result) 
   {
-    Serial.println("Erro ao configurar o ponto de acesso");
+    REMOTEIO_LOGE("Erro ao configurar o ponto de acesso");
     ESP.restart();
   }
   
   WiFi.softAPConfig(apIP, apIP, IPAddress(255, 255, 255, 0));
   IPAddress IP = WiFi.softAPIP();
 
-  Serial.print("[startAccessPoint] IP do ponto de acesso: ");
-  Serial.println(IP);
+  REMOTEIO_LOGI("[startAccessPoint] IP do ponto de acesso: %s", IP.toString().c_str());
   
   String LOCAL_DOMAIN = String("remoteio-device");
 
   if (!MDNS.begin(LOCAL_DOMAIN)) 
   {
-    Serial.println("Erro ao configurar o mDNS");
+    REMOTEIO_LOGE("Erro ao configurar o mDNS");
   }
 }
 
 void RemoteIO::openLocalServer()
 {
-  Serial.println("[openLocalServer] Opening local http endpoints");
+  // chamado a cada queda de conexão: rotas, cabeçalhos e serviço mDNS só podem ser registrados uma vez
+  if (localServerOpen) return;
+  localServerOpen = true;
+
+  REMOTEIO_LOGI("[openLocalServer] Opening local http endpoints");
 
   server->on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
-    request->send_P(200, "text/html", page_setup);
+    // página já comprimida em PROGMEM: enviada em blocos direto da flash, sem cópia em RAM
+    const AsyncWebHeader *ifNoneMatch = request->getHeader("If-None-Match");
+    bool cached = (ifNoneMatch != nullptr) && (ifNoneMatch->value() == PAGE_SETUP_ETAG);
+
+    AsyncWebServerResponse *response = cached ? request->beginResponse(304) : request->beginResponse_P(200, "text/html", page_setup_gz, PAGE_SETUP_GZ_LENGTH);
+
+    if (!cached) response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", PAGE_SETUP_ETAG);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
   });
 
   server->on("/get", HTTP_GET, [this](AsyncWebServerRequest *request) {
 
+    // a primeira configuração é livre; depois dela, trocar as credenciais exige a chave local
+    if (provisioned && !authorizeLocal(request)) return;
+
     if (request->hasParam("ssid") && request->hasParam("password") && request->hasParam("companyName") && request->hasParam("deviceId"))
     {
       String arg_deviceId = request->getParam("deviceId")->value();;
       String arg_ssid = request->getParam("ssid")->value();
       String arg_password = request->getParam("password")->value();
       String arg_companyName = request->getParam("companyName")->value();
+      String arg_localKey = request->hasParam("localKey") ? request->getParam("localKey")->value() : localKey;
+
+      if (arg_localKey.length() < LOCAL_KEY_LENGTH)
+      {
+        request->send(400, "text/plain", "A chave local deve ter ao menos " + String(LOCAL_KEY_LENGTH) + " caracteres");
+        return;
+      }
 
       JsonDocument doc;
       
@@ -153,17 +396,16 @@ void RemoteIO::openLocalServer()
       doc["password"] = arg_password;
       doc["model"] = _model;
       doc["ssidAuth"] = false;
+      doc["localKey"] = arg_localKey;
 
-      File file = SPIFFS.open("/config.json", "w");
-      serializeJson(doc, file);
-      
-      file.close();
+      writeConfig(doc);
       doc.clear();
 
-      Serial.println("[/get] Credenciais recebidas!");
+      clearBootCache();
+
+      REMOTEIO_LOGI("[/get] Credenciais recebidas!");
       request->send(200, "text/plain", "Credenciais recebidas com sucesso. Tentando conexão...");
-      delay(2000); 
-      ESP.restart();
+      scheduleRestart(2000);
     }
     else 
     {
@@ -177,14 +419,233 @@ void RemoteIO::openLocalServer()
   DefaultHeaders::Instance().addHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
   DefaultHeaders::Instance().addHeader("Access-Control-Allow-Headers", "Content-Type");
 
+  openMetricsEndpoints();
+  openLocalApi();
+
   server->onNotFound(std::bind(&RemoteIO::notFound, this, std::placeholders::_1));
   server->begin();
 }
 
+void RemoteIO::openMetricsEndpoints()
+{
+  server->on("/metrics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!authorizeLocal(request)) return;
+
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+    metrics.printPrometheus(*response);
+    request->send(response);
+  });
+
+  server->on("/metrics.json", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!authorizeLocal(request)) return;
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    metrics.printJson(*response);
+    request->send(response);
+  });
+}
+
+void RemoteIO::openLocalApi()
+{
+  // tabela de IO: GET /api/io lista todas as refs, GET /api/io?ref=x devolve uma
+  server->on("/api/io", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!authorizeLocal(request)) return;
+
+    int slot = request->hasParam("ref") ? findIO(request->getParam("ref")->value().c_str()) : -1;
+
+    if (request->hasParam("ref") && (slot < 0))
+    {
+      notFound(request);
+      return;
+    }
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+
+    if (slot >= 0)
+    {
+      printIO(*response, slot);
+    }
+    else
+    {
+      response->print("[");
+      for (uint8_t i = 0; i < ioCount; i++)
+      {
+        if (i) response->print(",");
+        printIO(*response, ioIndex[i]);
+      }
+      response->print("]");
+    }
+    request->send(response);
+  });
+
+  // POST /api/io?ref=x&value=y: o comando é aplicado no próximo loop(), pelo mesmo caminho da plataforma
+  server->on("/api/io", HTTP_POST, [this](AsyncWebServerRequest *request) {
+    if (!authorizeLocal(request)) return;
+
+    if (!request->hasParam("ref") || !request->hasParam("value"))
+    {
+      request->send(400, "application/json", "{\"message\":\"ref and value are required\"}");
+      return;
+    }
+
+    if (queueLocalCommand(request->getParam("ref")->value().c_str(), request->getParam("value")->value().c_str()))
+    {
+      request->send(202, "application/json", "{\"message\":\"queued\"}");
+    }
+    else
+    {
+      request->send(503, "application/json", "{\"message\":\"queue full\"}");
+    }
+  });
+
+  server->on("/log", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!authorizeLocal(request)) return;
+
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; charset=utf-8");
+    remoteIOLog.print(*response);
+    request->send(response);
+  });
+
+  // websocket: recebe comandos ["setIO",{"ref":..,"value":..}] e envia ["ioChanged",{"ref":..,"value":..}]
+  localSocket->setAuthentication(LOCAL_API_USER, localKey.c_str());
+  localSocket->onEvent([this](AsyncWebSocket *, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t length) {
+    AwsFrameInfo *info = (AwsFrameInfo *)arg;
+
+    // só mensagens de texto completas, em um único quadro
+    if ((type == WS_EVT_DATA) && !(info->final && (info->index == 0) && (info->len == length) && (info->opcode == WS_TEXT))) return;
+    this->localSocketEvent(client, type, data, length);
+  });
+  server->addHandler(localSocket);
+}
+
+bool RemoteIO::authorizeLocal(AsyncWebServerRequest *request)
+{
+  if (request->authenticate(LOCAL_API_USER, localKey.c_str())) return true;
+
+  request->requestAuthentication();
+  return false;
+}
+
+void RemoteIO::printIO(Print &out, int slot)
+{
+  IOEntry &entry = ioTable[slot];
+  static const char *const types[] = { "N/L", "OUTPUT", "INPUT", "INPUT_PULLUP", "INPUT_PULLDOWN", "INPUT_ANALOG" };
+
+  out.printf("{\"ref\":\"%s\",\"pin\":%u,\"type\":\"%s\",\"value\":%ld}", entry.ref, entry.pin, types[entry.type], (long)entry.value);
+}
+
+bool RemoteIO::queueLocalCommand(const char *ref, const char *value)
+{
+  // produtor único (servidor assíncrono), consumidor único (loop)
+  uint8_t next = (localCommandHead + 1) % LOCAL_COMMAND_QUEUE_CAPACITY;
+
+  if ((next == localCommandTail) || (strlen(ref) >= IO_REF_LENGTH) || (strlen(value) >= LOCAL_VALUE_LENGTH))
+  {
+    localCommandsDropped++;
+    return false;
+  }
+
+  strcpy(localCommands[localCommandHead].ref, ref);
+  strcpy(localCommands[localCommandHead].value, value);
+  localCommandHead = next;
+  return true;
+}
+
+void RemoteIO::localSocketEvent(AsyncWebSocketClient *client, AwsEventType type, uint8_t *data, size_t length)
+{
+  if (type != WS_EVT_DATA) return;
+
+  // o quadro é copiado: o parser altera o buffer e precisa de um byte após o fim
+  char frame[128];
+  if (length >= sizeof(frame))
+  {
+    client->text("{\"message\":\"frame too long\"}");
+    return;
+  }
+  memcpy(frame, data, length);
+  frame[length] = '\0';
+
+  RemoteIOEvent event;
+  if (!parseRemoteIOEvent(frame, length + 1, event) || (strcmp(event.name, "setIO") != 0))
+  {
+    client->text("{\"message\":\"invalid command\"}");
+    return;
+  }
+
+  if (!queueLocalCommand(event.ref, event.value)) client->text("{\"message\":\"queue full\"}");
+}
+
+void RemoteIO::pushLocal(int slot)
+{
+  if (localSocket->count() == 0) return;
+
+  char frame[IO_REF_LENGTH + 64];
+  snprintf(frame, sizeof(frame), "[\"ioChanged\",{\"ref\":\"%s\",\"value\":%ld}]", ioTable[slot].ref, (long)ioTable[slot].value);
+  localSocket->textAll(frame);
+}
+
+void RemoteIO::localLogic()
+{
+  while (localCommandTail != localCommandHead)
+  {
+    LocalCommand &local = localCommands[localCommandTail];
+    int slot = findIO(local.ref);
+
+    if ((slot >= 0) && (ioTable[slot].type == IO_OUTPUT))
+    {
+      ioTable[slot].value = strtol(local.value, NULL, 10);
+      writeOutput(slot);
+      reportOutput(slot);
+    }
+
+    if (userCallback != nullptr)
+    {
+      RemoteIOCommand command;
+      char *end = NULL;
+
+      command.ref = local.ref;
+      command.refLength = strlen(local.ref);
+      command.value = local.value;
+      command.valueLength = strlen(local.value);
+      command.number = strtod(local.value, &end);
+      command.isNumeric = (command.valueLength > 0) && (end == local.value + command.valueLength);
+
+      userCallback(command, userContext);
+    }
+
+    localCommandTail = (localCommandTail + 1) % LOCAL_COMMAND_QUEUE_CAPACITY;
+  }
+
+  if (millis() - localCleanupTimestamp >= LOCAL_WS_CLEANUP_INTERVAL)
+  {
+    localCleanupTimestamp = millis();
+    localSocket->cleanupClients();
+  }
+}
+
 void RemoteIO::loop()
 {
+  uint32_t loopStart = micros();
+
+  if (restart_requested && (millis() - restart_timestamp >= restart_delay)) ESP.restart();
+
   switchState();
   stateLogic();
+  httpsLogic();
+  linkLogic();
+  adcLogic();
+  schedulerLogic();
+  inputLogic();
+  rulesLogic();
+  uplinkLogic();
+  journalLogic();
+  cacheLogic();
+  localLogic();
+  metricsLogic();
+
+  metrics.recordLoop(micros() - loopStart);
+
+  remoteIOLog.drain(Serial);
 }
 
 void RemoteIO::switchState()
@@ -194,7 +655,13 @@ void RemoteIO::switchState()
     case INICIALIZATION:
       if ((WiFi.status() == WL_CONNECTED) && (Connected == true))
       {
-        Serial.println("[INICIALIZATION] vai pro CONNECTED");
+        REMOTEIO_LOGI("[INICIALIZATION] vai pro CONNECTED");
+
+        if (bootMetrics.connected == 0)
+        {
+          bootMetrics.connected = millis();
+          REMOTEIO_LOGI("[INICIALIZATION] Saídas restauradas em %lu ms, conectado em %lu ms", (unsigned long)bootMetrics.outputsRestored, (unsigned long)bootMetrics.connected);
+        }
 
         WiFi.mode(WIFI_STA);
 
@@ -209,14 +676,18 @@ void RemoteIO::switchState()
     case CONNECTED:
       if (WiFi.status() != WL_CONNECTED)
       {
-        Serial.println("[CONNECTED] vai pro NO_WIFI");
+        REMOTEIO_LOGI("[CONNECTED] vai pro NO_WIFI");
+        wifiBackoff.reset();
         startAccessPoint();
         openLocalServer();
         next_state = NO_WIFI;
       }
       else if (!Connected)
       {
-        Serial.println("[CONNECTED] vai pro DISCONNECTED");
+        REMOTEIO_LOGI("[CONNECTED] vai pro DISCONNECTED");
+        // o websocket costuma voltar sozinho; o fluxo completo só é refeito após um tempo sorteado
+        authBackoff.reset();
+        authBackoff.defer(SOCKET_REJOIN_DELAY + secureRandom(0, SOCKET_REJOIN_DELAY));
         startAccessPoint();
         openLocalServer();
         next_state = DISCONNECTED;
@@ -230,7 +701,7 @@ void RemoteIO::switchState()
     case NO_WIFI:
       if (WiFi.status() == WL_CONNECTED)
       {
-        Serial.println("[NO_WIFI] vai pro DISCONNECTED");
+        REMOTEIO_LOGI("[NO_WIFI] vai pro DISCONNECTED");
         start_debounce_time = 0;
         next_state = DISCONNECTED;
       }
@@ -243,14 +714,13 @@ void RemoteIO::switchState()
     case DISCONNECTED:
       if (Connected)
       {
-        reconnect_counter = 0;
-        Serial.println("[DISCONNECTED] vai pro CONNECTED");
+        REMOTEIO_LOGI("[DISCONNECTED] vai pro CONNECTED");
         WiFi.mode(WIFI_STA); 
         next_state = CONNECTED;
       }
       else if (WiFi.status() != WL_CONNECTED)
       {
-        Serial.println("[DISCONNECTED] vai pro NO_WIFI");  
+        REMOTEIO_LOGI("[DISCONNECTED] vai pro NO_WIFI");  
         next_state = NO_WIFI;
       }
       else 
@@ -260,6 +730,7 @@ void RemoteIO::switchState()
       break;
   }
   connection_state = next_state;
+  metrics.recordState(connection_state);
 }
 
 void RemoteIO::stateLogic()
@@ -268,8 +739,8 @@ void RemoteIO::stateLogic()
   {
     case INICIALIZATION:
       
-      socketIO.loop(); 
-      if (Connected == false)
+      socketIOLoop(); 
+      if ((Connected == false) && (link_state == LINK_IDLE))
       {
         socketIOConnect();
       }
@@ -277,56 +748,95 @@ void RemoteIO::stateLogic()
       
     case CONNECTED:
       
-      socketIO.loop();
+      socketIOLoop();
       break;
       
     case NO_WIFI:
 
-      if (millis() - start_reconnect_time >= 10000)
+      if ((link_state == LINK_IDLE) && wifiBackoff.ready())
       {
-        start_reconnect_time = millis();
+        wifiBackoff.attempt();
         start_debounce_time = millis();
-        nodeIotConnection(storedCallbackFunction); 
+        nodeIotConnection(); 
       }
       break;
 
     case DISCONNECTED:
       
-      socketIO.loop();
-      socketIOConnect();
+      socketIOLoop();
+      if (link_state == LINK_IDLE) socketIOConnect();
       
-      if (millis() - start_reconnect_time >= 60000)
+      // a plataforma fora do ar não reinicia o dispositivo: as tentativas apenas se espaçam
+      if ((link_state == LINK_IDLE) && authBackoff.ready())
       {
-        if (reconnect_counter >= 3) ESP.restart();
-        else reconnect_counter++;
-        start_reconnect_time = millis();
         start_debounce_time = millis();
-        Serial.println("[DISCONNECTED] Trying reconnection...");
-        nodeIotConnection(storedCallbackFunction); 
+        REMOTEIO_LOGI("[DISCONNECTED] Trying reconnection (%lu)...", (unsigned long)authBackoff.failures);
+        nodeIotConnection(); 
       }
       break;
   }
 }
 
+void RemoteIO::socketIOLoop()
+{
+  uint32_t start = micros();
+  socketIO.loop();
+  metrics.recordSocketLoop(micros() - start);
+}
+
+void RemoteIO::metricsLogic()
+{
+  if (metrics.sampleHeap())
+  {
+    REMOTEIO_LOGE("[metricsLogic] Heap livre abaixo de %u bytes: %u", (unsigned)METRICS_HEAP_FLOOR, (unsigned)ESP.getFreeHeap());
+  }
+
+  if ((metricsPushInterval == 0) || (connection_state != CONNECTED) || (millis() - metricsPushTimestamp < metricsPushInterval)) return;
+  metricsPushTimestamp = millis();
+
+  StreamString frame;
+  frame.print("[\"" SOCKET_METRICS_EVENT "\",{\"deviceId\":\"");
+  frame.print(_deviceId);
+  frame.print("\",\"metrics\":");
+  metrics.printJson(frame);
+  frame.print("}]");
+
+  socketIO.sendEVENT(frame);
+}
+
+void RemoteIO::legacyCallbackAdapter(const RemoteIOCommand &command, void *context)
+{
+  RemoteIO *device = (RemoteIO *)context;
+  device->storedCallbackFunction(String(command.ref), String(command.value));
+}
+
 void RemoteIO::rebootDevice()
 {
   ESP.restart();
 }
 
-void RemoteIO::eraseDeviceSettings()
+void RemoteIO::scheduleRestart(unsigned long delayTime)
 {
-  if (SPIFFS.remove("/config.json")) Serial.printf("\nApagando configurações salvas na memória não volátil...\n");
-  else Serial.printf("\nFalha ao remover configurações armazenadas na memória não volátil. Por favor, tente novamente.\n");
-  delay(1000);
-  ESP.restart();
+  // reinicia a partir do loop(), sem bloquear o callback que pediu o reinício
+  restart_timestamp = millis();
+  restart_delay = delayTime;
+  restart_requested = true;
 }
 
-void RemoteIO::infoUpdatedEventHandler(JsonDocument payload_doc)
+void RemoteIO::eraseDeviceSettings()
 {
-  String function = payload_doc[1]["function"].as<String>();
+  clearBootCache();
+
+  SPIFFS.remove(CONFIG_TEMP_FILE);
+  if (SPIFFS.remove(CONFIG_FILE)) REMOTEIO_LOGI("Apagando configurações salvas na memória não volátil...");
+  else REMOTEIO_LOGE("Falha ao remover configurações armazenadas na memória não volátil. Por favor, tente novamente.");
+  scheduleRestart(1000);
+}
 
-  if (function == "restart") rebootDevice();
-  else if (function == "reset") eraseDeviceSettings();
+void RemoteIO::infoUpdatedEventHandler(const char *function)
+{
+  if (strcmp(function, "restart") == 0) rebootDevice();
+  else if (strcmp(function, "reset") == 0) eraseDeviceSettings();
 }
 
 void RemoteIO::socketIOEvent(socketIOmessageType_t type, uint8_t *payload, size_t length)
@@ -335,61 +845,69 @@ void RemoteIO::socketIOEvent(socketIOmessageType_t type, uint8_t *payload, size_
   {
     case sIOtype_DISCONNECT:
       Connected = false;
+      socketIO.setReconnectInterval(socketBackoff.attempt());
       break;
     case sIOtype_CONNECT:
+      socketBackoff.reset();
       socketIO.send(sIOtype_CONNECT, "/");
       break;
     case sIOtype_EVENT:
-      char *sptr = NULL;
-      int id = strtol((char *)payload, &sptr, 10);
+    {
+      REMOTEIO_LOGD("[IOc] get event: %.*s", (int)length, (const char *)payload);
 
-      Serial.printf("[IOc] get event: %s id: %d\n", payload, id);
-      
-      if (id)
+      // o payload é lido uma única vez, no próprio buffer do websocket
+      RemoteIOEvent event;
+      if (!parseRemoteIOEvent((char *)payload, length, event)) return;
+
+      if (strcmp(event.name, "infoUpdated") == 0)
       {
-        payload = (uint8_t *)sptr;
+        infoUpdatedEventHandler(event.function);
+        break;
       }
 
-      StaticJsonDocument<1024> doc;
-      DeserializationError error = deserializeJson(doc, payload, length);
+      // só comandos chegam ao callback: eventos sem "ref" são avisos da plataforma
+      if (strcmp(event.ref, "null") == 0) break;
 
-      if (error) return;
-      
-      String eventName = doc[0];
+      if (strcmp(event.ref, "restart") == 0) rebootDevice();
+      else if (strcmp(event.ref, "reset") == 0) eraseDeviceSettings();
+
+      int slot = findIO(event.ref);
 
-      if (eventName == "infoUpdated")
+      if ((slot >= 0) && (ioTable[slot].type == IO_OUTPUT))
       {
-        infoUpdatedEventHandler(doc);
+        ioTable[slot].value = strtol(event.value, NULL, 10);
+        writeOutput(slot);
       }
-      else 
-      {
-        String ref = doc[1]["ref"].as<String>();
-        String value = doc[1]["value"].as<String>();
 
-        if (ref == "restart") rebootDevice();
-        else if (ref == "reset") eraseDeviceSettings();
+      if (userCallback != nullptr)
+      {
+        RemoteIOCommand command;
+        char *end = NULL;
 
-        setIO[ref]["value"] = value;
+        command.ref = event.ref;
+        command.refLength = event.refLength;
+        command.value = event.value;
+        command.valueLength = event.valueLength;
+        command.number = strtod(event.value, &end);
+        command.isNumeric = (event.valueLength > 0) && (end == event.value + event.valueLength);
 
-        if (setIO[ref]["type"].as<String>() == "OUTPUT")
-        {
-          updatePinOutput(ref);
-        }
-        
-        doc.clear();
-        break;
+        userCallback(command, userContext);
       }
+      break;
+    }
+    default:
+      break;
   }
 }
 
-void RemoteIO::tryWiFiConnection()
+bool RemoteIO::tryWiFiConnection()
 {
   Connected = false;
 
   if ((_ssid == "") || (_ssid == "null") || (_password == "") || (_password == "null"))
   {
-    Serial.println("[tryWiFiConnection] No Wi-Fi network info available...");
-    return;
+    REMOTEIO_LOGW("[tryWiFiConnection] No Wi-Fi network info available...");
+    return false;
   }
 
   if (_deviceId != "" && _deviceId != "null")
@@ -399,345 +917,1883 @@ void RemoteIO::tryWiFiConnection()
     WiFi.setHostname(hostname.c_str());
   }
 
-  Serial.printf("\n[tryWiFi] Trying connection on %s...\n", _ssid);
-  WiFi.begin(_ssid, _password);
+  REMOTEIO_LOGI("[tryWiFi] Trying connection on %s...", _ssid.c_str());
+  wifiJoinStart = millis();
+  startWiFiJoin(wifiLease.valid);
+  return true;
+}
+
+void RemoteIO::startWiFiJoin(bool directed)
+{
+  wifiJoinDirected = directed;
+  wifiJoinTimestamp = millis();
+
+  if (directed)
+  {
+    // conexão direta: sem busca de canais e sem DHCP
+    WiFi.config(IPAddress(wifiLease.ip), IPAddress(wifiLease.gateway), IPAddress(wifiLease.subnet), IPAddress(wifiLease.dns));
+    WiFi.begin(_ssid, _password, wifiLease.channel, wifiLease.bssid);
+  }
+  else
+  {
+    WiFi.config(0u, 0u, 0u);
+    WiFi.begin(_ssid, _password);
+  }
+}
+
+void RemoteIO::wifiJoined()
+{
+  uint32_t joinTime = millis() - wifiJoinStart;
+
+  wifiStats.lastJoinTime = joinTime;
+  wifiStats.lastJoinDirected = wifiJoinDirected;
+  if (joinTime > wifiStats.maxJoinTime) wifiStats.maxJoinTime = joinTime;
 
-  while (WiFi.status() != WL_CONNECTED)
+  wifiBackoff.reset();
+  wifiLeaseUnverified = wifiJoinDirected;
+
+  if (wifiJoinDirected)
   {
-    delay(500);
-    if ((start_debounce_time != 0) && (millis() - start_debounce_time >= 2000) && (connection_state == NO_WIFI))
-    {
-      WiFi.disconnect();
-      return;
-    }
+    wifiStats.directJoins++;
+    wifiDirectStreak = 0;
+    return;
   }
 
+  wifiStats.scanJoins++;
+
+  // guarda a rede e a concessão DHCP atuais; a flash só é gravada quando algo mudou
+  WiFiLease lease;
+  memset(&lease, 0, sizeof(lease));
+  lease.valid = true;
+  memcpy(lease.bssid, WiFi.BSSID(), sizeof(lease.bssid));
+  lease.channel = WiFi.channel();
+  lease.ip = (uint32_t)WiFi.localIP();
+  lease.gateway = (uint32_t)WiFi.gatewayIP();
+  lease.subnet = (uint32_t)WiFi.subnetMask();
+  lease.dns = (uint32_t)WiFi.dnsIP(0);
+
+  if (wifiLease.valid && (memcmp(&lease, &wifiLease, sizeof(lease)) == 0)) return;
+
+  wifiLease = lease;
+  wifiDirectStreak = 0;
+  saveWiFiLease();
 }
 
-void RemoteIO::nodeIotConnection(void (*userCallbackFunction)(String ref, String value))
+bool RemoteIO::checkWiFiLease(int statusCode)
 {
-  if (connection_state == INICIALIZATION || connection_state == NO_WIFI) tryWiFiConnection();
-  
-  if (WiFi.status() == WL_CONNECTED) 
+  if (!wifiLeaseUnverified) return false;
+
+  wifiLeaseUnverified = false;
+  if (statusCode > 0) return false;
+
+  // a primeira requisição nem chegou ao servidor: se a associação se mantém e o DNS responde
+  // pelo gateway da concessão, a rede está boa e quem falhou foi a plataforma. A consulta é
+  // assíncrona (WiFi.hostByName bloquearia o loop()) e a resposta é esperada em LINK_LEASE_PROBE
+  ip_addr_t address;
+  String host = appBaseUrl.substring(appBaseUrl.indexOf("://") + 3);
+  host = host.substring(0, host.indexOf('/'));
+
+  REMOTEIO_LOGW("[checkWiFiLease] Falha de transporte após conexão direta (%i), consultando o DNS", statusCode);
+
+  if (WiFi.status() != WL_CONNECTED)
   {
-    Serial.printf("[nodeIotConnection] WiFi connected %s\n", WiFi.localIP().toString().c_str());
+    invalidateWiFiLease();
+    return true;
   }
 
-  appLastDataUrl.replace(" ", "%20");
+  leaseProbe = LEASE_PROBE_PENDING;
+  err_t result = dns_gethostbyname(host.c_str(), &address, leaseProbeFound, this);
 
-  while (state != "accepted")
+  if (result == ERR_OK)
   {
-    if ((start_debounce_time != 0) && (millis() - start_debounce_time >= 2000))
-    {
-      return;
-    }
-    tryAuthenticate();
+    // endereço já em cache no lwIP: a rede respondeu há pouco
+    leaseProbe = LEASE_PROBE_IDLE;
+    return false;
   }
-  
-  String appSocketPath = "/socket.io/?token=" + token + "&EIO=4";
-
-  fetchLatestData();
 
-  socketIO.begin(_appHost, _appPort, appSocketPath); 
-  socketIO.onEvent([this, userCallbackFunction](socketIOmessageType_t type, uint8_t* payload, size_t length) 
+  if (result != ERR_INPROGRESS)
   {
-    this->socketIOEvent(type, payload, length);
+    leaseProbe = LEASE_PROBE_IDLE;
+    invalidateWiFiLease();
+    return true;
+  }
 
-    if ((userCallbackFunction != nullptr) && (type == sIOtype_EVENT)) 
-    {
-      char *sptr = NULL;
-      int id = strtol((char *)payload, &sptr, 10);
+  // com a rede boa, a etapa que falhou é repetida; na revalidação, o websocket segue com o token em cache
+  leaseProbeTimestamp = millis();
+  leaseProbeResume = (link_state == LINK_REVALIDATE) ? LINK_IDLE : link_state;
+  link_state = LINK_LEASE_PROBE;
+  return true;
+}
 
-      if (id)
-      {
-        payload = (uint8_t *)sptr;
-      }
+void RemoteIO::leaseProbeFound(const char *, const ip_addr_t *address, void *context)
+{
+  RemoteIO *device = (RemoteIO *)context;
 
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, payload, length);
+  // respostas que chegam depois de WIFI_LEASE_DNS_TIMEOUT são ignoradas
+  if (device->leaseProbe != LEASE_PROBE_PENDING) return;
+  device->leaseProbe = (address != nullptr) ? LEASE_PROBE_RESOLVED : LEASE_PROBE_FAILED;
+}
 
-      if (error) return;
+void RemoteIO::invalidateWiFiLease()
+{
+  // o IP fixo da concessão não vale mais nesta rede
+  REMOTEIO_LOGW("[invalidateWiFiLease] Falha de rede após conexão direta, refazendo com DHCP");
+  wifiLease.valid = false;
+  wifiDirectStreak = 0;
+  wifiStats.leaseInvalidations++;
+  saveWiFiLease();
+
+  WiFi.disconnect();
+  wifiJoinStart = millis();
+  startWiFiJoin(false);
+  if (start_debounce_time != 0) start_debounce_time = millis();
+  link_state = LINK_WIFI_JOIN;
+}
 
-      String ref = doc[1]["ref"];
-      String value = doc[1]["value"];
+void RemoteIO::loadWiFiLease(JsonObject cache)
+{
+  unsigned int bssid[6];
+  IPAddress ip, gateway, subnet, dns;
 
-      userCallbackFunction(ref, value);
-    }
-  });
+  wifiLease.valid = false;
+
+  if (cache.isNull()) return;
+
+  if ((sscanf(cache["bssid"] | "", "%x:%x:%x:%x:%x:%x", &bssid[0], &bssid[1], &bssid[2], &bssid[3], &bssid[4], &bssid[5]) != 6) ||
+      !ip.fromString(cache["ip"] | "") || !gateway.fromString(cache["gateway"] | "") ||
+      !subnet.fromString(cache["subnet"] | "") || !dns.fromString(cache["dns"] | ""))
+  {
+    return;
+  }
+
+  for (int i = 0; i < 6; i++) wifiLease.bssid[i] = bssid[i];
+  wifiLease.channel = cache["channel"] | 0;
+  wifiLease.ip = (uint32_t)ip;
+  wifiLease.gateway = (uint32_t)gateway;
+  wifiLease.subnet = (uint32_t)subnet;
+  wifiLease.dns = (uint32_t)dns;
+  wifiLease.valid = (wifiLease.channel > 0);
 }
 
-void RemoteIO::socketIOConnect()
+void RemoteIO::saveWiFiLease()
 {
-  uint64_t now = millis();
-  if (Socketed == 0)
-  {
-    StaticJsonDocument<JSON_DOCUMENT_CAPACITY> doc;
-    JsonArray array = doc.to<JsonArray>();
-    array.add("connection");
-    JsonObject query = array.createNestedObject();
-    query["Query"]["token"] = token;
+  JsonDocument document(&jsonArena);
+  File file = SPIFFS.open(CONFIG_FILE, "r");
 
-    String output;
-    serializeJson(doc, output);
-    Socketed = socketIO.sendEVENT(output);
-    Socketed = 1;
+  if (!file) return;
+
+  DeserializationError error = deserializeJson(document, file);
+  file.close();
+
+  if (error) return;
+
+  if (wifiLease.valid)
+  {
+    char bssid[18];
+    snprintf(bssid, sizeof(bssid), "%02x:%02x:%02x:%02x:%02x:%02x", wifiLease.bssid[0], wifiLease.bssid[1], wifiLease.bssid[2], wifiLease.bssid[3], wifiLease.bssid[4], wifiLease.bssid[5]);
+
+    JsonObject cache = document["wifiCache"].to<JsonObject>();
+    cache["bssid"] = bssid;
+    cache["channel"] = wifiLease.channel;
+    cache["ip"] = IPAddress(wifiLease.ip).toString();
+    cache["gateway"] = IPAddress(wifiLease.gateway).toString();
+    cache["subnet"] = IPAddress(wifiLease.subnet).toString();
+    cache["dns"] = IPAddress(wifiLease.dns).toString();
   }
-  if ((Socketed == 1) && (now - messageTimestamp > 2000) && (Connected == 0))
+  else
   {
-    StaticJsonDocument<JSON_DOCUMENT_CAPACITY> doc;
-    JsonArray array = doc.to<JsonArray>();
-    messageTimestamp = now;
-    array.add("joinRoom");
-    String output;
-    serializeJson(doc, output);
-    Connected = socketIO.sendEVENT(output);
-    if (Connected) Serial.println("[socketIOConnect] Connected");
-    else Serial.println("[socketIOConnect] Failed connecting");
+    document.remove("wifiCache");
   }
+
+  writeConfig(document);
 }
 
-void RemoteIO::setIOsAndEvents(JsonDocument document)
+bool RemoteIO::writeConfig(JsonDocument &document)
 {
-  if (document.containsKey("token")) token = document["token"].as<String>();
-  
-  if (document.containsKey("serverAddr")) extractIPAddress(document["serverAddr"].as<String>());
+  // a nova versão é gravada inteira ao lado da atual: uma queda de energia no meio da
+  // gravação deixa CONFIG_FILE intacto, e depois do remove() recoverConfig() completa a troca
+  File file = SPIFFS.open(CONFIG_TEMP_FILE, "w");
+  if (!file) return false;
+
+  size_t length = measureJson(document);
+  bool written = (serializeJson(document, file) == length);
+  file.close();
+
+  if (!written)
+  {
+    REMOTEIO_LOGE("[writeConfig] Falha ao gravar %s", CONFIG_TEMP_FILE);
+    SPIFFS.remove(CONFIG_TEMP_FILE);
+    return false;
+  }
+
+  SPIFFS.remove(CONFIG_FILE);
+  return SPIFFS.rename(CONFIG_TEMP_FILE, CONFIG_FILE);
+}
+
+void RemoteIO::recoverConfig()
+{
+  if (!SPIFFS.exists(CONFIG_TEMP_FILE)) return;
+
+  // com CONFIG_FILE presente, a cópia temporária pode estar incompleta e é descartada;
+  // sem ele, a energia caiu entre o remove() e o rename() de writeConfig()
+  if (SPIFFS.exists(CONFIG_FILE)) SPIFFS.remove(CONFIG_TEMP_FILE);
+  else if (SPIFFS.rename(CONFIG_TEMP_FILE, CONFIG_FILE)) REMOTEIO_LOGW("[recoverConfig] Configuração recuperada de %s", CONFIG_TEMP_FILE);
+}
+
+void RemoteIO::nodeIotConnection()
+{
+  if (connection_state == INICIALIZATION || connection_state == NO_WIFI) 
+  {
+    link_state = tryWiFiConnection() ? LINK_WIFI_JOIN : LINK_IDLE;
+  }
+  else 
+  {
+    link_state = LINK_AUTHENTICATE;
+  }
+}
+
+void RemoteIO::linkLogic()
+{
+  // cada passagem executa no máximo uma etapa da conexão; as requisições HTTPS avançam em
+  // httpsLogic, e a etapa que as iniciou só segue quando o resultado chega
+  switch (link_state)
+  {
+    case LINK_IDLE:
+      break;
+
+    case LINK_WIFI_JOIN:
+      if (WiFi.status() == WL_CONNECTED)
+      {
+        wifiJoined();
+        REMOTEIO_LOGI("[linkLogic] WiFi connected %s em %lu ms (%s)", WiFi.localIP().toString().c_str(), (unsigned long)wifiStats.lastJoinTime, wifiJoinDirected ? "direta" : "busca");
+        link_state = LINK_AUTHENTICATE;
+      }
+      else if (wifiJoinDirected && (millis() - wifiJoinTimestamp >= WIFI_DIRECT_TIMEOUT))
+      {
+        // a rede em cache não respondeu (AP trocou de canal, BSSID ou sub-rede): busca completa com DHCP
+        wifiStats.directFailures++;
+        if (++wifiDirectStreak >= WIFI_DIRECT_MAX_FAILURES)
+        {
+          REMOTEIO_LOGW("[linkLogic] Descartando rede WiFi em cache");
+          wifiLease.valid = false;
+          wifiDirectStreak = 0;
+          wifiStats.leaseInvalidations++;
+          saveWiFiLease();
+        }
+
+        WiFi.disconnect();
+        startWiFiJoin(false);
+        if (start_debounce_time != 0) start_debounce_time = millis();
+      }
+      else if ((start_debounce_time != 0) && (millis() - start_debounce_time >= 2000) && (connection_state == NO_WIFI))
+      {
+        WiFi.disconnect();
+        link_state = LINK_IDLE;
+      }
+      break;
+
+    case LINK_AUTHENTICATE:
+      if (httpsOwner == HTTPS_OWNER_VERIFY)
+      {
+        int statusCode = httpsResult(HTTPS_OWNER_VERIFY);
+        if (statusCode != HTTPS_PENDING) checkWiFiLease(finishAuthenticate(statusCode));
+        break;
+      }
+
+      if (!tlsSized)
+      {
+        // uma sondagem por boot, antes da primeira requisição, numa passagem só dela
+        sizeTlsBuffers();
+        break;
+      }
+
+      if ((state == "accepted") && (connection_state == DISCONNECTED) && (authBackoff.failures >= AUTH_REVERIFY_AFTER))
+      {
+        // o websocket não volta com o token em cache: ele pode ter expirado ou sido revogado
+        REMOTEIO_LOGW("[linkLogic] %lu reconexões sem sucesso, autenticando de novo", (unsigned long)authBackoff.failures);
+        state = "";
+      }
+
+      if (state == "accepted")
+      {
+        // com o token ainda válido a reconexão pula a autenticação, mas conta como tentativa
+        if (connection_state == DISCONNECTED) authBackoff.attempt();
+
+        // no boot rápido os últimos valores vêm do cache; a busca acontece na revalidação
+        link_state = revalidatePending ? LINK_SOCKET_JOIN : LINK_FETCH_LATEST;
+      }
+      else if ((start_debounce_time != 0) && (millis() - start_debounce_time >= 2000))
+      {
+        link_state = LINK_IDLE;
+      }
+      else if (authBackoff.ready() && !httpsBusy())
+      {
+        authBackoff.attempt();
+        startAuthenticate();
+      }
+      break;
+
+    case LINK_FETCH_LATEST:
+    {
+      if (httpsOwner != HTTPS_OWNER_LATEST)
+      {
+        if (httpsBusy()) break;
+
+        appLastDataUrl = appBaseUrl + "/devices/getdata";
+        appLastDataUrl.replace(" ", "%20");
+        latestArray.begin();
+        httpsStartRequest(HTTPS_OWNER_LATEST, "GET", appLastDataUrl, nullptr, 0, true, false);
+        break;
+      }
+
+      int statusCode = httpsResult(HTTPS_OWNER_LATEST);
+      if ((statusCode == HTTPS_PENDING) || !readLatestData(statusCode)) break;
+
+      httpsFinish();
+      if (checkWiFiLease(statusCode)) break;
+
+      if (state != "accepted")
+      {
+        // token recusado pelo getdata: autentica de novo antes de abrir o websocket
+        if (start_debounce_time != 0) start_debounce_time = millis();
+        link_state = (connection_state == CONNECTED) ? LINK_IDLE : LINK_AUTHENTICATE;
+        break;
+      }
+
+      // na revalidação o websocket já está aberto
+      link_state = (connection_state == CONNECTED) ? LINK_IDLE : LINK_SOCKET_JOIN;
+      break;
+    }
+
+    case LINK_REVALIDATE:
+    {
+      if (httpsOwner != HTTPS_OWNER_VERIFY)
+      {
+        if (httpsBusy()) break;
+
+        authBackoff.attempt();
+        startAuthenticate();
+        break;
+      }
+
+      int statusCode = httpsResult(HTTPS_OWNER_VERIFY);
+      if (statusCode == HTTPS_PENDING) break;
+
+      // o token em cache só deixa de valer com a resposta do verify
+      state = "";
+      statusCode = finishAuthenticate(statusCode);
+
+      if (checkWiFiLease(statusCode))
+      {
+        // o token em cache continua valendo até a revalidação pela nova conexão
+        state = "accepted";
+        break;
+      }
+
+      if (state == "accepted")
+      {
+        revalidatePending = false;
+        link_state = LINK_FETCH_LATEST;
+        break;
+      }
+
+      // só um state decodificado diferente de "accepted", ou 401/403, é recusa; um 200 com corpo
+      // ilegível (state vazio) conta como falha de transporte, e a revalidação é repetida com espera
+      bool rejected = ((statusCode == HTTP_CODE_OK) && (state != "")) || (statusCode == HTTP_CODE_UNAUTHORIZED) || (statusCode == HTTP_CODE_FORBIDDEN);
+
+      if (rejected)
+      {
+        // credenciais recusadas: descarta o cache e refaz o fluxo completo a partir do boot
+        REMOTEIO_LOGW("[linkLogic] Autenticação recusada, descartando cache de boot");
+        clearBootCache();
+        scheduleRestart(0);
+      }
+      else
+      {
+        state = "accepted";
+      }
+      link_state = LINK_IDLE;
+      break;
+    }
+
+    case LINK_LEASE_PROBE:
+      if (leaseProbe == LEASE_PROBE_RESOLVED)
+      {
+        REMOTEIO_LOGW("[linkLogic] DNS respondeu pela rede em cache, a falha foi da plataforma");
+        leaseProbe = LEASE_PROBE_IDLE;
+        link_state = leaseProbeResume;
+      }
+      else if ((leaseProbe == LEASE_PROBE_FAILED) || (millis() - leaseProbeTimestamp >= WIFI_LEASE_DNS_TIMEOUT))
+      {
+        leaseProbe = LEASE_PROBE_IDLE;
+        invalidateWiFiLease();
+      }
+      break;
+
+    case LINK_SOCKET_JOIN:
+    {
+      String appSocketPath = "/socket.io/?token=" + token + "&EIO=4";
+
+      socketIO.begin(_appHost, _appPort, appSocketPath); 
+      socketIO.onEvent([this](socketIOmessageType_t type, uint8_t* payload, size_t length) 
+      {
+        this->socketIOEvent(type, payload, length);
+      });
+      socketBackoff.reset();
+      socketIO.setReconnectInterval(socketBackoff.attempt());
+
+      link_state = LINK_IDLE;
+      if (revalidatePending) revalidateTimestamp = millis();
+      break;
+    }
+  }
+}
+
+void RemoteIO::socketIOConnect()
+{
+  uint64_t now = millis();
+  if (Socketed == 0)
+  {
+    // o token é um JWT (base64url com pontos), não precisa de escape no JSON
+    String output = "[\"connection\",{\"Query\":{\"token\":\"" + token + "\"}}]";
+    Socketed = socketIO.sendEVENT(output);
+    Socketed = 1;
+  }
+  if ((Socketed == 1) && (now - messageTimestamp > 2000) && (Connected == 0))
+  {
+    messageTimestamp = now;
+    Connected = socketIO.sendEVENT(JOIN_ROOM_FRAME, sizeof(JOIN_ROOM_FRAME) - 1);
+    if (Connected) REMOTEIO_LOGI("[socketIOConnect] Connected");
+    else REMOTEIO_LOGW("[socketIOConnect] Failed connecting");
+  }
+}
+
+void RemoteIO::setIOsAndEvents(JsonDocument &document)
+{
+  if (document.containsKey("token")) token = document["token"].as<String>();
+  
+  if (document.containsKey("serverAddr")) extractIPAddress(document["serverAddr"].as<String>());
+
+  // a plataforma responde "encoding": "msgpack" quando aceita a codificação oferecida no verify
+  wireMsgPack = (document["encoding"] == WIRE_MSGPACK);
   
+  // os modos são refeitos a cada configuração recebida: a interrupção sai do pino atual antes
+  // que registerIO o altere (ou que a ref deixe de existir), e os canais de agregação são redistribuídos
+  aggregateCount = 0;
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    if (ioTable[slot].mode == IO_MODE_INTERRUPT) detachInterrupt(ioTable[slot].pin);
+    ioTable[slot].mode = IO_MODE_CYCLIC;
+  }
+
+  removeUnlistedIOs(document["gpio"].as<JsonArray>());
+
   for (size_t i = 0; i < document["gpio"].size(); i++)
   {
     String ref = document["gpio"][i]["ref"];
     int pin = document["gpio"][i]["pin"].as<int>();
     String type = document["gpio"][i]["type"];
     String mode = document["gpio"][i]["mode"]; // modo de operação. Ex. p/ INPUTs: interrupção, cíclica, em horário definido...
+    int delayTime = document["gpio"][i]["delay"].as<int>(); // s, opcional
+
+    if (!boardAccepts(pin, ioTypeFromString(type)))
+    {
+      REMOTEIO_LOGW("[setIOsAndEvents] IO incompatível com a placa %s: %s (pino %d, %s)", _model.c_str(), ref.c_str(), pin, type.c_str());
+      continue;
+    }
+
+    int slot = registerIO(ref.c_str(), pin, ioTypeFromString(type));
+
+    // refeita a cada configuração: campos que saíram da configuração não ficam para trás
+    JsonObject config = setIO[ref].to<JsonObject>();
 
     if (type == "INPUT" || type == "INPUT_ANALOG")
     {
-      setIO[ref]["pin"] = pin;
-      setIO[ref]["type"] = type;
-      setIO[ref]["mode"] = mode;
+      config["pin"] = pin;
+      config["type"] = type;
+      config["mode"] = mode;
       pinMode(pin, INPUT);
     }
     else if (type == "INPUT_PULLUP")
     {
-      setIO[ref]["pin"] = pin;
-      setIO[ref]["type"] = type;
-      setIO[ref]["mode"] = mode;
+      config["pin"] = pin;
+      config["type"] = type;
+      config["mode"] = mode;
       pinMode(pin, INPUT_PULLUP);
     }
     else if (type == "OUTPUT")
     {
-      setIO[ref]["pin"] = pin;
-      setIO[ref]["type"] = type;
+      config["pin"] = pin;
+      config["type"] = type;
       pinMode(pin, OUTPUT);
     } 
     else 
     {
-      setIO[ref]["pin"] = pin;
-      setIO[ref]["type"] = "N/L";
+      config["pin"] = pin;
+      config["type"] = "N/L";
     }
-  }
-}
-
-void RemoteIO::tryAuthenticate()
-{
-  WiFiClientSecure client;
-  HTTPClient https;
-  StaticJsonDocument<JSON_DOCUMENT_CAPACITY> document;
-  String request;
-  
-  client.setInsecure();
 
-  if (_deviceId != "" && _deviceId != "null") document["deviceId"] = _deviceId;
-  document["companyName"] = _companyName;
-  document["mac"] = WiFi.macAddress();
-  document["ipAddress"] = WiFi.localIP().toString();
-  document["deviceModel"] = _model;
-  document["version"] = VERSION;
+    // sem "delay", volta ao intervalo padrão
+    if (slot >= 0) ioTable[slot].delay = (delayTime > 0) ? delayTime * 1000 : INPUT_MIN_DELAY;
+    if (delayTime > 0) config["delay"] = delayTime;
+    if (slot >= 0) config["value"] = ioTable[slot].value;
 
-  serializeJson(document, request);
-
-  https.begin(client, appVerifyUrl);
-  https.addHeader("Content-Type", "application/json");
+    if (slot >= 0) configureInputMode(slot, mode, document["gpio"][i].as<JsonObject>());
+  }
 
-  int statusCode = https.POST(request);
-  String response = https.getString(); 
+  buildInputSchedule();
+  compileRules(document["rules"].as<JsonArray>());
+  checkAnalogPins();
+}
 
-  document.clear();
-  deserializeJson(document, response);
-  Serial.println(response);
+void RemoteIO::compileRules(JsonArray config)
+{
+  rules.clear();
 
-  if (statusCode == HTTP_CODE_OK)
+  // {"if": ref, "op": ">", "value": n, "hysteresis": n, "for": ms, "then": ref, "set": n, "else": n}
+  for (JsonObject item : config)
   {
-    state = document["state"].as<String>();
+    Rule rule;
+    int input = findIO(item["if"] | "");
+    int output = findIO(item["then"] | "");
+
+    rule.op = RemoteIORules::opFromString(item["op"] | "");
 
-    if (state != "accepted") 
+    if ((input < 0) || (output < 0) || (ioTable[output].type != IO_OUTPUT) || (rule.op == RULE_INVALID))
     {
-      document.clear();
-      https.end();
-      return;
+      REMOTEIO_LOGW("[compileRules] Regra ignorada: %s -> %s", item["if"] | "?", item["then"] | "?");
+      continue;
     }
 
-    setIOsAndEvents(document);
+    rule.input = input;
+    rule.output = output;
+    rule.threshold = item["value"] | 0;
+    rule.hysteresis = item["hysteresis"] | 0;
+    rule.holdTime = item["for"] | 0;
+    rule.onValue = item["set"] | 1;
+    rule.offValue = item["else"] | 0;
+    rule.flags = item["else"].isNull() ? 0 : RULE_HAS_ELSE;
+
+    if (!rules.add(rule)) break;
   }
-  
-  document.clear();
-  https.end();
+
+  if (rules.size() > 0) REMOTEIO_LOGI("[compileRules] %u regras locais", rules.size());
 }
 
-void RemoteIO::fetchLatestData()
-{ 
-  WiFiClientSecure client;
-  HTTPClient https;
+bool RemoteIO::ruleRead(uint8_t slot, int32_t &value, void *context)
+{
+  RemoteIO *device = (RemoteIO *)context;
+  IOEntry &entry = device->ioTable[slot];
 
-  client.setInsecure();
-  
-  appLastDataUrl = appBaseUrl + "/devices/getdata";
+  // no modo cíclico, entry.value só muda a cada "delay": a regra lê o pino na hora
+  if ((entry.mode == IO_MODE_CYCLIC) && (entry.type == IO_INPUT || entry.type == IO_INPUT_PULLDOWN || entry.type == IO_INPUT_PULLUP))
+  {
+    value = digitalRead(entry.pin);
+    return true;
+  }
 
-  https.begin(client, appLastDataUrl);
-  https.addHeader("Content-Type", "application/json");
-  https.addHeader("Authorization", "Bearer " + token);
+  // A0 com o filtro ativo: a última saída da cadeia, sem outra leitura do ADC
+  if ((entry.type == IO_INPUT_ANALOG) && (entry.pin == A0) && (device->adcFiltered >= 0))
+  {
+    value = device->adcFiltered;
+    return true;
+  }
 
-  int statusCode = https.GET();
+  // entradas valem 0 até a primeira leitura enviada: antes disso a regra agiria sobre um valor inventado
+  if ((entry.type != IO_OUTPUT) && (entry.reported < 0)) return false;
 
-  if (statusCode == HTTP_CODE_OK)
-  {
-    StaticJsonDocument<JSON_DOCUMENT_CAPACITY> document;
-    deserializeJson(document, https.getStream());
+  value = entry.value;
+  return true;
+}
 
-    Serial.println("");
-    Serial.println("[fetchLatestData] HTTP_CODE 200");
-    serializeJson(document, Serial);
-    Serial.println("");
-    
-    for (size_t i = 0; i < document.size(); i++)
-    {
-      String auxRef = document[i]["ref"].as<String>();
-      String auxValue = document[i]["data"][0]["value"].as<String>();
+void RemoteIO::ruleWrite(uint8_t slot, int32_t value, void *context)
+{
+  RemoteIO *device = (RemoteIO *)context;
+  IOEntry &entry = device->ioTable[slot];
 
-      if (auxValue == "null")
-      {
-        auxValue = "0";
-      }
-      
-      setIO[auxRef]["value"] = auxValue;
-      
-      if (setIO[auxRef]["type"].as<String>() == "OUTPUT")
-      {
-        updatePinOutput(auxRef);
-      }
-    }
-    document.clear();
-  }
+  if (entry.value == value) return;
 
-  https.end();
+  entry.value = value;
+  device->writeOutput(slot);
+  device->reportOutput(slot);
 }
 
-void RemoteIO::extractIPAddress(String url)
+void RemoteIO::reportOutput(int slot)
 {
-  int startIndex = url.indexOf("//") + 2; // Encontra o início do endereço IP
-  int endIndex = url.indexOf(":", startIndex); // Encontra o fim do endereço IP
+  // mantém a plataforma sincronizada com mudanças feitas no próprio dispositivo
+  String value = String(ioTable[slot].value);
+  time_t timestamp = time(nullptr);
 
-  _appHost = url.substring(startIndex, endIndex); // Extrai o endereço IP
+  if (connection_state == CONNECTED) queueSample(ioTable[slot].ref, value, timestamp);
+  else journal.append(ioTable[slot].ref, value.c_str(), timestamp);
 }
 
-void RemoteIO::updatePinOutput(String ref)
+void RemoteIO::rulesLogic()
 {
-  int PinRef = setIO[ref]["pin"].as<int>();
-  int ValueRef = setIO[ref]["value"].as<int>();
-  
-  digitalWrite(PinRef, ValueRef);
+  if (rules.size() > 0) rules.evaluate(millis(), ruleRead, ruleWrite, this);
 }
 
-void RemoteIO::updatePinInput(String ref)
+void RemoteIO::configureInputMode(int slot, const String &mode, JsonObject config)
 {
-  int pinRef = setIO[ref]["pin"].as<int>();
-  String typeRef = setIO[ref]["type"].as<String>();
-  int delayTime = setIO[ref]["delay"].as<int>() * 1000; // variável de configuração sincronizada com a plataforma
-  int timestamp = setIO[ref]["timestamp"].as<int>();  // variável de configuração local, dessincronizada
-  
-  // garantir pelo menos 5 seg de delay
-  if (delayTime < 5000) 
-  {
-    delayTime = 5000; // ms
-    setIO[ref]["delay"] = 5; // s
-  }
+  IOEntry &entry = ioTable[slot];
+
+  entry.mode = IO_MODE_CYCLIC;
+  entry.debounce = config["debounce"] | INPUT_DEBOUNCE;
+  entry.deadband = config["deadband"] | ANALOG_DEADBAND;
+  entry.reported = -1;    // força o envio do primeiro valor lido
+  entry.pending = -1;
+  entry.changedAt = 0;
 
-  if (millis() - timestamp >= delayTime)
+  if (entry.type == IO_INPUT_ANALOG)
   {
-    setIO[ref]["timestamp"] = millis();
+    if (mode == "deadband") 
+    {
+      entry.mode = IO_MODE_DEADBAND;
+    }
+    else if (mode == "aggregate")
+    {
+      if (aggregateCount >= AGGREGATE_CAPACITY)
+      {
+        REMOTEIO_LOGW("[configureInputMode] Sem canal de agregação para %s: leitura cíclica", entry.ref);
+        return;
+      }
+
+      AggregateChannel &channel = aggregates[aggregateCount];
+      channel.window.reset();
+      channel.interval = config["sampleInterval"] | AGGREGATE_SAMPLE_INTERVAL;
+      if (channel.interval < ADC_MIN_INTERVAL) channel.interval = ADC_MIN_INTERVAL;
+      channel.sampledAt = millis();
+      channel.percentiles = config["percentiles"] | false;
 
-    // executa ação de leitura conforme tipo de variável ou processo utilizado
-    if (typeRef == "INPUT" || typeRef == "INPUT_PULLDOWN" || typeRef == "INPUT_PULLUP")
+      entry.aggregate = aggregateCount++;
+      entry.mode = IO_MODE_AGGREGATE;
+    }
+  }
+  else if ((entry.type == IO_INPUT) || (entry.type == IO_INPUT_PULLUP) || (entry.type == IO_INPUT_PULLDOWN))
+  {
+    if (mode == "change") 
     {
-      int valueRef = digitalRead(pinRef);
-      if (connection_state == CONNECTED) espPOST(ref, String(valueRef));
+      entry.mode = IO_MODE_CHANGE;
     }
-    else if (typeRef == "INPUT_ANALOG")
+    else if (mode == "interrupt")
     {
-      float valueRef = analogRead(pinRef);
-      if (connection_state == CONNECTED) espPOST(ref, String(valueRef));
+      entry.mode = IO_MODE_INTERRUPT;
+      irqContexts[slot].owner = this;
+      irqContexts[slot].slot = slot;
+      attachInterruptArg(entry.pin, inputISR, &irqContexts[slot], CHANGE);
     }
   }
 }
 
-void RemoteIO::notFound(AsyncWebServerRequest *request)
+void IRAM_ATTR RemoteIO::inputISR(void *arg)
 {
-  request->send(404, "application/json", "{\"message\":\"Not found\"}");
-}
+  InputIrqContext *context = (InputIrqContext *)arg;
+  RemoteIO *device = context->owner;
+  uint8_t head = device->inputEventHead;
+  uint8_t next = (head + 1) % INPUT_EVENT_QUEUE_CAPACITY;
 
-int RemoteIO::espPOST(String variable, String value)
-{
-    return espPOST(appPostData, variable, value);
+  // fila cheia: o evento é perdido, mas contabilizado
+  if (next == device->inputEventTail)
+  {
+    device->inputEventsDropped++;
+    return;
+  }
+
+  InputEvent &event = device->inputEvents[head];
+  event.slot = context->slot;
+  event.level = digitalRead(device->ioTable[context->slot].pin);
+  event.micros = micros();
+  device->inputEventHead = next;
 }
 
-int RemoteIO::espPOST(String Router, String variable, String value)
+void RemoteIO::inputLogic()
 {
-  if ((WiFi.status() == WL_CONNECTED))
+  // eventos capturados por interrupção, na ordem em que ocorreram
+  while (inputEventTail != inputEventHead)
   {
-    String route = Router;
+    InputEvent event = inputEvents[inputEventTail];
+    inputEventTail = (inputEventTail + 1) % INPUT_EVENT_QUEUE_CAPACITY;
 
-    WiFiClientSecure client;
-    HTTPClient https;
-    StaticJsonDocument<1024> document;
-    String request;
+    IOEntry &entry = ioTable[event.slot];
 
-    client.setInsecure();
+    if ((entry.mode != IO_MODE_INTERRUPT) || (event.level == entry.reported)) continue;
 
-    if (Router == appPostData)
+    // borda dentro do debounce: o nível é conferido de novo quando a janela terminar
+    if ((entry.reported >= 0) && (event.micros - entry.changedAt < (uint32_t)entry.debounce * 1000))
     {
-      document["deviceId"] = _deviceId;
-      document["ref"] = variable;
-      document["value"] = value;
-      document["timestamp"] = time(nullptr);
-      setIO[variable]["value"] = value;
-      serializeJson(document, request);
+      entry.pending = event.level;
+      continue;
     }
-    else request = value; 
-    
-    https.begin(client, route); 
-    https.addHeader("Content-Type", "application/json");
-    https.addHeader("authorization", "Bearer " + token);
 
-    //Serial.print("[espPOST] Request: ");
-    //Serial.println(request);
-    
-    int httpCode = https.POST(request);
+    entry.pending = -1;
+    entry.changedAt = event.micros;
+    entry.value = event.level;
+    reportInput(event.slot, event.micros);
+  }
 
-    String response = https.getString(); 
-    document.clear();
-    deserializeJson(document, response);
-    //Serial.println(response);
+  bool analogDue = (millis() - analogPollTimestamp >= ANALOG_POLL_INTERVAL);
+  if (analogDue) analogPollTimestamp = millis();
 
-    if (httpCode == HTTP_CODE_OK)
-    {
-      Serial.println("[espPOST] HTTP_CODE 200");
-    }
-    else if (httpCode != HTTP_CODE_OK) 
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    IOEntry &entry = ioTable[slot];
+
+    switch (entry.mode)
     {
-      Serial.printf("[espPOST] HTTP_CODE %i\n", httpCode);
+      case IO_MODE_INTERRUPT:
+        if (entry.reported < 0)
+        {
+          entry.value = digitalRead(entry.pin);
+          entry.changedAt = micros();
+          reportInput(slot, 0);
+        }
+        else if ((entry.pending >= 0) && (micros() - entry.changedAt >= (uint32_t)entry.debounce * 1000))
+        {
+          // pulso mais curto que o debounce: sem isso, a borda de volta nunca seria enviada
+          int level = digitalRead(entry.pin);
+
+          entry.pending = -1;
+          if (level != entry.reported)
+          {
+            entry.value = level;
+            entry.changedAt = micros();
+            reportInput(slot, 0);
+          }
+        }
+        break;
+
+      case IO_MODE_CHANGE:
+      {
+        int level = digitalRead(entry.pin);
+
+        // o novo nível precisa permanecer estável durante o debounce antes de ser enviado
+        if (level != entry.pending)
+        {
+          entry.pending = level;
+          entry.changedAt = millis();
+        }
+        else if ((level != entry.reported) && (millis() - entry.changedAt >= entry.debounce))
+        {
+          entry.value = level;
+          reportInput(slot, 0);
+        }
+        break;
+      }
+
+      case IO_MODE_DEADBAND:
+        if (analogDue)
+        {
+          entry.value = readAnalog(entry.pin);
+          if ((entry.reported < 0) || (abs(entry.value - entry.reported) >= entry.deadband)) reportInput(slot, 0);
+        }
+        break;
+
+      case IO_MODE_AGGREGATE:
+      {
+        // só acumula: o resumo é enviado pelo agendador das leituras cíclicas, a cada "delay"
+        AggregateChannel &channel = aggregates[entry.aggregate];
+        uint32_t now = millis();
+
+        if (now - channel.sampledAt >= channel.interval)
+        {
+          channel.sampledAt += channel.interval;
+          if (now - channel.sampledAt >= channel.interval) channel.sampledAt = now;
+          channel.window.add(readAnalog(entry.pin));
+        }
+        break;
+      }
     }
-    document.clear();
-    https.end();
-    return httpCode;
   }
-  return 0;
-}
\ No newline at end of file
+}
+
+void RemoteIO::reportInput(int slot, uint32_t eventMicros)
+{
+  IOEntry &entry = ioTable[slot];
+  String value = (entry.type == IO_INPUT_ANALOG) ? String((float)entry.value) : String(entry.value);
+  time_t timestamp = time(nullptr);
+
+  entry.reported = entry.value;
+  mirrorIO(slot);
+  pushLocal(slot);
+
+  // eventos de interrupção carregam o instante da borda, e não o da leitura da fila
+  if (eventMicros != 0) timestamp -= (micros() - eventMicros) / 1000000;
+
+  if (connection_state == CONNECTED) queueSample(entry.ref, value, timestamp, eventMicros);
+  else journal.append(entry.ref, value.c_str(), timestamp);
+}
+
+uint8_t RemoteIO::ioTypeFromString(const String &type)
+{
+  if (type == "OUTPUT") return IO_OUTPUT;
+  if (type == "INPUT") return IO_INPUT;
+  if (type == "INPUT_PULLUP") return IO_INPUT_PULLUP;
+  if (type == "INPUT_PULLDOWN") return IO_INPUT_PULLDOWN;
+  if (type == "INPUT_ANALOG") return IO_INPUT_ANALOG;
+  return IO_NONE;
+}
+
+int RemoteIO::findIO(const char *ref)
+{
+  // busca binária sobre ioIndex, mantido em ordem alfabética de ref
+  int low = 0;
+  int high = ioCount - 1;
+
+  while (low <= high)
+  {
+    int middle = (low + high) / 2;
+    int cmp = strcmp(ref, ioTable[ioIndex[middle]].ref);
+
+    if (cmp == 0) return ioIndex[middle];
+    if (cmp < 0) high = middle - 1;
+    else low = middle + 1;
+  }
+  return -1;
+}
+
+int RemoteIO::registerIO(const char *ref, int pin, uint8_t type)
+{
+  int slot = findIO(ref);
+
+  if (slot < 0)
+  {
+    if ((ioCount >= IO_TABLE_CAPACITY) || (strlen(ref) >= IO_REF_LENGTH))
+    {
+      REMOTEIO_LOGW("[registerIO] Ref ignorada na tabela de IOs: %s", ref);
+      return -1;
+    }
+
+    slot = ioCount;
+    IOEntry &entry = ioTable[slot];
+    strcpy(entry.ref, ref);
+    entry.value = 0;
+    entry.delay = INPUT_MIN_DELAY;
+    entry.timestamp = 0;
+    entry.mode = IO_MODE_CYCLIC;
+
+    // insere o novo slot mantendo o índice ordenado
+    int position = ioCount;
+    while ((position > 0) && (strcmp(ref, ioTable[ioIndex[position - 1]].ref) < 0))
+    {
+      ioIndex[position] = ioIndex[position - 1];
+      position--;
+    }
+    ioIndex[position] = slot;
+    ioCount++;
+  }
+
+  ioTable[slot].pin = pin;
+  ioTable[slot].type = type;
+  return slot;
+}
+
+bool RemoteIO::gpioListed(JsonArray gpio, const char *ref)
+{
+  for (JsonObject item : gpio)
+  {
+    if (strcmp(item["ref"] | "", ref) != 0) continue;
+    return boardAccepts(item["pin"] | -1, ioTypeFromString(item["type"] | ""));
+  }
+  return false;
+}
+
+void RemoteIO::removeUnlistedIOs(JsonArray gpio)
+{
+  // refs que saíram da configuração (ou que a placa recusa) viram IO_NONE e deixam a tabela
+  uint8_t kept = 0;
+
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    if (!gpioListed(gpio, ioTable[slot].ref))
+    {
+      REMOTEIO_LOGI("[removeUnlistedIOs] Ref removida da configuração: %s", ioTable[slot].ref);
+      setIO.remove(ioTable[slot].ref);
+      ioTable[slot].type = IO_NONE;
+      continue;
+    }
+
+    if (kept != slot) ioTable[kept] = ioTable[slot];
+    kept++;
+  }
+
+  if (kept == ioCount) return;
+
+  // os slots mudaram: eventos de interrupção ainda na fila apontariam para outra ref
+  ioCount = kept;
+  inputEventTail = inputEventHead;
+  buildIOIndex();
+}
+
+void RemoteIO::buildIOIndex()
+{
+  // ordenação por inserção: no máximo IO_TABLE_CAPACITY refs, só ao receber a configuração
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    int position = slot;
+    while ((position > 0) && (strcmp(ioTable[slot].ref, ioTable[ioIndex[position - 1]].ref) < 0))
+    {
+      ioIndex[position] = ioIndex[position - 1];
+      position--;
+    }
+    ioIndex[position] = slot;
+  }
+}
+
+void RemoteIO::writeOutput(int slot)
+{
+  digitalWrite(ioTable[slot].pin, ioTable[slot].value);
+  outputsDirty = true;
+  mirrorIO(slot);
+  pushLocal(slot);
+}
+
+void RemoteIO::mirrorIO(int slot)
+{
+  // a tabela é a fonte do valor; o setIO recebe uma cópia a cada escrita ou leitura reportada,
+  // fora das interrupções, para os sketches que leem setIO[ref]["value"]
+  setIO[ioTable[slot].ref]["value"] = ioTable[slot].value;
+}
+
+void RemoteIO::restoreBootCache()
+{
+  File file = SPIFFS.open(BOOT_CACHE_FILE, "r");
+
+  if (!file) return;
+
+  JsonDocument document(&jsonArena);
+  DeserializationError error = deserializeJson(document, file);
+  file.close();
+
+  if (error || !document["token"].is<const char *>()) return;
+
+  setIOsAndEvents(document);
+
+  file = SPIFFS.open(OUTPUT_CACHE_FILE, "r");
+  if (file)
+  {
+    JsonDocument outputs(&jsonArena);
+    if (!deserializeJson(outputs, file))
+    {
+      for (JsonPair output : outputs.as<JsonObject>())
+      {
+        int slot = findIO(output.key().c_str());
+
+        if ((slot < 0) || (ioTable[slot].type != IO_OUTPUT)) continue;
+
+        ioTable[slot].value = output.value().as<int>();
+        writeOutput(slot);
+      }
+    }
+    file.close();
+  }
+
+  outputsDirty = false;
+  state = "accepted";
+  revalidatePending = true;
+  bootMetrics.warmBoot = true;
+  bootMetrics.outputsRestored = millis();
+
+  REMOTEIO_LOGI("[restoreBootCache] Saídas restauradas em %lu ms", (unsigned long)bootMetrics.outputsRestored);
+}
+
+void RemoteIO::saveBootCache(JsonDocument &document)
+{
+  // a resposta do verify já chega filtrada (token, serverAddr, gpio, encoding, rules e state):
+  // gravada direto, sem uma cópia na arena, que dobraria o pico com a tabela de IO cheia
+  File file = SPIFFS.open(BOOT_CACHE_FILE, "w");
+  if (!file) return;
+  serializeJson(document, file);
+  file.close();
+}
+
+void RemoteIO::clearBootCache()
+{
+  SPIFFS.remove(BOOT_CACHE_FILE);
+  SPIFFS.remove(OUTPUT_CACHE_FILE);
+}
+
+void RemoteIO::cacheLogic()
+{
+  // grava os valores das saídas no máximo uma vez por intervalo, para poupar a flash
+  if (outputsDirty && (millis() - outputsSavedTimestamp >= OUTPUT_CACHE_INTERVAL))
+  {
+    outputsSavedTimestamp = millis();
+    outputsDirty = false;
+
+    JsonDocument outputs(&jsonArena);
+
+    for (uint8_t slot = 0; slot < ioCount; slot++)
+    {
+      if (ioTable[slot].type == IO_OUTPUT) outputs[ioTable[slot].ref] = ioTable[slot].value;
+    }
+
+    File file = SPIFFS.open(OUTPUT_CACHE_FILE, "w");
+    if (file)
+    {
+      serializeJson(outputs, file);
+      file.close();
+    }
+  }
+
+  // boot rápido: revalida o token em segundo plano depois que o websocket já está conectado,
+  // pelas mesmas etapas limitadas do linkLogic
+  if (revalidatePending && (connection_state == CONNECTED) && (link_state == LINK_IDLE) && authBackoff.ready())
+  {
+    link_state = LINK_REVALIDATE;
+  }
+
+  // o token em cache não abriu o websocket: volta para o fluxo completo
+  if (revalidatePending && (revalidateTimestamp != 0) && (connection_state == INICIALIZATION) && (link_state == LINK_IDLE) && (millis() - revalidateTimestamp >= WARM_BOOT_TIMEOUT))
+  {
+    REMOTEIO_LOGI("[cacheLogic] Boot rápido expirou, autenticando");
+    revalidatePending = false;
+    state = "";
+    nodeIotConnection();
+  }
+}
+
+bool RemoteIO::checkAuthorization(int statusCode)
+{
+  if ((statusCode != HTTP_CODE_UNAUTHORIZED) && (statusCode != HTTP_CODE_FORBIDDEN)) return true;
+
+  // token expirado ou revogado: o "accepted" guardado não vale mais
+  REMOTEIO_LOGW("[checkAuthorization] HTTP_CODE %i, autenticando de novo", statusCode);
+  state = "";
+
+  // conectado, o websocket segue aberto: a nova autenticação é feita pela revalidação
+  if (connection_state == CONNECTED) revalidatePending = true;
+  return false;
+}
+
+bool RemoteIO::startAuthenticate()
+{
+  JsonDocument document(&jsonArena);
+
+  if (_deviceId != "" && _deviceId != "null") document["deviceId"] = _deviceId;
+  document["companyName"] = _companyName;
+  document["mac"] = WiFi.macAddress();
+  document["ipAddress"] = WiFi.localIP().toString();
+  document["deviceModel"] = _model;
+  document["version"] = VERSION;
+
+  // o verify é sempre JSON: é nele que a codificação dos demais corpos é negociada
+  JsonArray encodings = document["encodings"].to<JsonArray>();
+  encodings.add(WIRE_MSGPACK);
+  encodings.add("json");
+
+  return httpsPostDocument(HTTPS_OWNER_VERIFY, appVerifyUrl, document, false, false);
+}
+
+int RemoteIO::finishAuthenticate(int statusCode)
+{
+  // plataforma sobrecarregada: respeita o tempo pedido (em segundos) antes da próxima tentativa
+  if (((statusCode == HTTP_CODE_TOO_MANY_REQUESTS) || (statusCode == HTTP_CODE_SERVICE_UNAVAILABLE)) && (httpsSession.retryAfter() > 0))
+  {
+    uint32_t retryAfter = httpsSession.retryAfter();
+    REMOTEIO_LOGW("[finishAuthenticate] HTTP_CODE %i, Retry-After %lu s", statusCode, (unsigned long)retryAfter);
+    authBackoff.defer(retryAfter * 1000);
+  }
+
+  if (statusCode == HTTP_CODE_OK)
+  {
+    // lê a resposta direto do socket, guardando só os campos usados
+    JsonDocument filter(&jsonArena);
+    filter["state"] = true;
+    filter["token"] = true;
+    filter["serverAddr"] = true;
+    filter["encoding"] = true;
+    filter["gpio"] = true;
+    filter["rules"] = true;
+
+    JsonDocument response(&jsonArena);
+    DeserializationError error = decodeBody(response, httpsSession.body(), filter);
+
+    // um corpo ilegível não diz nada sobre as credenciais: o state só vem de uma resposta decodificada
+    state = error ? String("") : response["state"].as<String>();
+    REMOTEIO_LOGI("[finishAuthenticate] state: %s, gpio: %u", state.c_str(), (unsigned)response["gpio"].size());
+
+    if (error || (state != "accepted")) 
+    {
+      if (error) REMOTEIO_LOGW("[finishAuthenticate] Resposta inválida: %s", error.c_str());
+      httpsFinish();
+      return statusCode;
+    }
+
+    authBackoff.reset();
+    setIOsAndEvents(response);
+    saveBootCache(response);
+  }
+  
+  httpsFinish();
+  return statusCode;
+}
+
+// Lê até LATEST_ELEMENTS_PER_PASS elementos do getdata por passagem; true quando terminou.
+bool RemoteIO::readLatestData(int statusCode)
+{ 
+  if (statusCode != HTTP_CODE_OK) return true;
+
+  HttpsBody &stream = httpsSession.body();
+  bool msgpack = httpsSession.contentType().startsWith(WIRE_MSGPACK_TYPE);
+
+  JsonDocument filter(&jsonArena);
+  filter["ref"] = true;
+  filter["data"][0]["value"] = true;
+
+  // um elemento do array por vez: o consumo de memória não depende do número de refs
+  JsonDocument element(&jsonArena);
+  uint8_t step = WIRE_ELEMENT;
+
+  for (uint8_t i = 0; (i < LATEST_ELEMENTS_PER_PASS) && (step == WIRE_ELEMENT); i++)
+  {
+    step = latestArray.next(stream, msgpack, element, filter);
+    if (step == WIRE_ELEMENT) applyLatestValue(element.as<JsonObject>());
+  }
+
+  if (step == WIRE_ELEMENT) return false;
+
+  // o próximo elemento ainda não chegou: segue na próxima passagem, até HTTPS_TIMEOUT
+  if ((step == WIRE_WAIT) && !stream.finished() && (micros() - httpsStart < HTTPS_TIMEOUT * 1000UL)) return false;
+
+  if (step == WIRE_ERROR) REMOTEIO_LOGW("[readLatestData] Resposta inválida após %u refs", latestArray.count);
+  REMOTEIO_LOGI("[readLatestData] HTTP_CODE 200, %u refs", latestArray.count);
+
+  if (bootMetrics.outputsRestored == 0) bootMetrics.outputsRestored = millis();
+  return true;
+}
+
+void RemoteIO::applyLatestValue(JsonObject item)
+{
+  String auxRef = item["ref"].as<String>();
+  String auxValue = item["data"][0]["value"].as<String>();
+
+  if (auxValue == "null")
+  {
+    auxValue = "0";
+  }
+
+  int slot = findIO(auxRef.c_str());
+  
+  if ((slot >= 0) && (ioTable[slot].type == IO_OUTPUT))
+  {
+    ioTable[slot].value = auxValue.toInt();
+    writeOutput(slot);
+  }
+}
+
+void RemoteIO::extractIPAddress(String url)
+{
+  int startIndex = url.indexOf("//") + 2; // Encontra o início do endereço IP
+  int endIndex = url.indexOf(":", startIndex); // Encontra o fim do endereço IP
+
+  _appHost = url.substring(startIndex, endIndex); // Extrai o endereço IP
+}
+
+void RemoteIO::updatePinOutput(String ref)
+{
+  int slot = findIO(ref.c_str());
+
+  if ((slot < 0) || (ioTable[slot].type != IO_OUTPUT)) return;
+
+  // compatibilidade com sketches que escrevem setIO[ref]["value"]: o valor escrito passa para a tabela
+  JsonVariant value = setIO[ref]["value"];
+  if (!value.isNull()) ioTable[slot].value = value.as<int>();
+  
+  writeOutput(slot);
+}
+
+void RemoteIO::updatePinOutput(String ref, int32_t value)
+{
+  int slot = findIO(ref.c_str());
+
+  if ((slot < 0) || (ioTable[slot].type != IO_OUTPUT)) return;
+
+  ioTable[slot].value = value;
+  writeOutput(slot);
+}
+
+int32_t RemoteIO::getIOValue(String ref)
+{
+  int slot = findIO(ref.c_str());
+
+  return (slot >= 0) ? ioTable[slot].value : 0;
+}
+
+void RemoteIO::updatePinInput(String ref)
+{
+  int slot = findIO(ref.c_str());
+
+  if (slot < 0) return;
+
+  // entradas por interrupção, mudança ou banda morta são tratadas no loop()
+  if ((ioTable[slot].mode != IO_MODE_CYCLIC) && (ioTable[slot].mode != IO_MODE_AGGREGATE)) return;
+
+  if (inputSchedule.due(slot, millis())) sampleInput(slot);
+}
+
+void RemoteIO::sampleInput(int slot)
+{
+  IOEntry &entry = ioTable[slot];
+  uint32_t now = millis();
+
+  entry.timestamp = now;
+
+  // mantém a cadência sem acumular atraso; se ficou para trás, recomeça a partir de agora
+  inputSchedule.advance(slot, entry.delay, now);
+
+  String value;
+
+  // executa ação de leitura conforme tipo de variável ou processo utilizado
+  if (entry.type == IO_INPUT || entry.type == IO_INPUT_PULLDOWN || entry.type == IO_INPUT_PULLUP)
+  {
+    entry.value = digitalRead(entry.pin);
+    value = String(entry.value);
+  }
+  else if (entry.type == IO_INPUT_ANALOG)
+  {
+    if (entry.mode == IO_MODE_AGGREGATE) 
+    {
+      reportAggregate(slot);
+      return;
+    }
+
+    entry.value = readAnalog(entry.pin);
+    value = String((float)entry.value);
+  }
+  else return;
+
+  entry.reported = entry.value;
+  mirrorIO(slot);
+  pushLocal(slot);
+
+  // sem conexão, a amostra vai para o diário em flash e é reenviada depois
+  if (connection_state == CONNECTED) espPOST(entry.ref, value);
+  else journal.append(entry.ref, value.c_str(), time(nullptr));
+}
+
+void RemoteIO::reportAggregate(int slot)
+{
+  IOEntry &entry = ioTable[slot];
+  AggregateChannel &channel = aggregates[entry.aggregate];
+  AggregateSummary summary;
+
+  // janela sem leituras (loop() bloqueado por mais que "delay"): nada a enviar
+  if (!channel.window.summarize(summary)) return;
+
+  uint16_t p50 = channel.window.percentile(50);
+  uint16_t p90 = channel.window.percentile(90);
+  uint16_t p99 = channel.window.percentile(99);
+  channel.window.reset();
+
+  String value = String(summary.mean);
+  time_t timestamp = time(nullptr);
+
+  entry.value = lroundf(summary.mean);
+  entry.reported = entry.value;
+  mirrorIO(slot);
+  pushLocal(slot);
+
+  // o resumo vai em texto JSON na amostra: segue pela fila de envio e, sem conexão, pelo diário
+  JsonDocument document(&jsonArena);
+  document["count"] = summary.count;
+  document["min"] = summary.min;
+  document["max"] = summary.max;
+  document["mean"] = summary.mean;
+  document["stddev"] = summary.stddev;
+
+  if (channel.percentiles)
+  {
+    document["p50"] = p50;
+    document["p90"] = p90;
+    document["p99"] = p99;
+  }
+
+  String stats;
+  serializeJson(document, stats);
+
+  if (connection_state == CONNECTED) queueSample(entry.ref, value, timestamp, 0, stats);
+  else
+  {
+    UplinkSample sample = { entry.ref, value, timestamp, 0, stats };
+    journalSample(sample);
+  }
+}
+
+void RemoteIO::buildInputSchedule()
+{
+  uint32_t now = millis();
+
+  inputSchedule.clear();
+
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    IOEntry &entry = ioTable[slot];
+    bool isInput = (entry.type == IO_INPUT) || (entry.type == IO_INPUT_PULLUP) || (entry.type == IO_INPUT_PULLDOWN) || (entry.type == IO_INPUT_ANALOG);
+
+    if (!isInput || ((entry.mode != IO_MODE_CYCLIC) && (entry.mode != IO_MODE_AGGREGATE))) continue;
+
+    // garantir pelo menos 5 seg de delay
+    if (entry.delay < INPUT_MIN_DELAY) entry.delay = INPUT_MIN_DELAY;
+    inputSchedule.add(slot, now);
+  }
+}
+
+void RemoteIO::schedulerLogic()
+{
+  uint32_t now = millis();
+
+  // a raiz do heap é a próxima entrada a vencer: sem nada vencido, o custo é uma comparação
+  for (uint8_t budget = 0; budget < INPUT_SCHEDULER_BUDGET; budget++)
+  {
+    int slot = inputSchedule.next(now);
+
+    if (slot < 0) return;
+    sampleInput(slot);
+  }
+}
+
+void RemoteIO::notFound(AsyncWebServerRequest *request)
+{
+  request->send(404, "application/json", "{\"message\":\"Not found\"}");
+}
+
+int RemoteIO::espPOST(String variable, String value)
+{
+  // mesmo sem lote (batchSize <= 1) a amostra passa pela fila: o POST não bloqueia quem chamou;
+  // 1 com a amostra na fila em memória, 0 quando ela foi para o diário ou descartada
+  return queueSample(variable, value, time(nullptr));
+}
+
+void RemoteIO::setUplinkBatch(uint8_t batchSize, unsigned long maxLatency)
+{
+  if (batchSize > UPLINK_QUEUE_CAPACITY) batchSize = UPLINK_QUEUE_CAPACITY;
+
+  uplinkBatchSize = batchSize;
+  uplinkMaxLatency = maxLatency;
+}
+
+int RemoteIO::flushUplink()
+{
+  // o lote sai nas próximas passagens do loop(), sem esperar o tamanho ou a latência máxima;
+  // devolve o número de amostras na fila que o pedido vai enviar
+  if (uplinkCount > 0) uplinkFlushRequested = true;
+  return uplinkCount;
+}
+
+const UplinkStats &RemoteIO::getUplinkStats()
+{
+  return uplinkStats;
+}
+
+const BootMetrics &RemoteIO::getBootMetrics()
+{
+  return bootMetrics;
+}
+
+const WiFiJoinStats &RemoteIO::getWiFiJoinStats()
+{
+  return wifiStats;
+}
+
+void RemoteIO::setReconnectPolicy(uint8_t layer, unsigned long baseDelay, unsigned long maxDelay)
+{
+  if (layer == RECONNECT_WIFI) wifiBackoff.configure(baseDelay, maxDelay);
+  else if (layer == RECONNECT_AUTH) authBackoff.configure(baseDelay, maxDelay);
+  else if (layer == RECONNECT_SOCKET) socketBackoff.configure(baseDelay, maxDelay);
+}
+
+void RemoteIO::setAnalogFilter(unsigned long sampleInterval, uint8_t decimation, uint8_t window, uint8_t lowPassShift)
+{
+  adcTicker.detach();
+  adcFilter.configure(decimation, window, lowPassShift);
+  adcHead = 0;
+  adcTail = 0;
+  adcFiltered = -1;
+
+  if (sampleInterval == 0) return;
+  if (sampleInterval < ADC_MIN_INTERVAL) sampleInterval = ADC_MIN_INTERVAL;
+
+  adcTicker.attach_ms(sampleInterval, adcTick, this);
+  checkAnalogPins();
+}
+
+void RemoteIO::adcTick(RemoteIO *device)
+{
+  // timer do SDK: roda fora do loop(), inclusive enquanto ele espera uma requisição HTTPS
+  uint8_t head = device->adcHead;
+  uint8_t next = (head + 1) % ADC_RING_SIZE;
+
+  if (next == device->adcTail)
+  {
+    device->adcDropped++;
+    return;
+  }
+
+  device->adcRing[head] = analogRead(A0);
+  device->adcHead = next;
+}
+
+void RemoteIO::adcLogic()
+{
+  while (adcTail != adcHead)
+  {
+    int32_t output;
+
+    if (adcFilter.push(adcRing[adcTail], output))
+    {
+      adcFiltered = (output + (1 << (FILTER_FRACTION_BITS - 1))) >> FILTER_FRACTION_BITS;
+    }
+    adcTail = (adcTail + 1) % ADC_RING_SIZE;
+  }
+}
+
+int32_t RemoteIO::readAnalog(uint8_t pin)
+{
+  // com o filtro ativo, o ADC é lido só pelo timer: as entradas usam a última saída da cadeia
+  if ((pin == A0) && (adcFiltered >= 0)) return adcFiltered;
+  return analogRead(pin);
+}
+
+void RemoteIO::checkAnalogPins()
+{
+  if (!adcTicker.active()) return;
+
+  // o timer amostra só o A0: outra entrada analógica não recebe a saída do filtro
+  for (uint8_t slot = 0; slot < ioCount; slot++)
+  {
+    if ((ioTable[slot].type == IO_INPUT_ANALOG) && (ioTable[slot].pin != A0))
+    {
+      REMOTEIO_LOGW("[checkAnalogPins] %s usa o pino %u, fora do filtro do A0", ioTable[slot].ref, ioTable[slot].pin);
+    }
+  }
+}
+
+void RemoteIO::setMetricsPush(unsigned long interval)
+{
+  metricsPushInterval = interval;
+  metricsPushTimestamp = millis();
+}
+
+int RemoteIO::queueSample(const String &ref, const String &value, time_t timestamp, uint32_t eventMicros, const String &stats)
+{
+  // fila cheia: a amostra mais antiga sai da memória e vai para o diário em flash
+  if (uplinkCount == UPLINK_QUEUE_CAPACITY)
+  {
+    if (uplinkInFlight > 0)
+    {
+      // as mais antigas estão no POST em andamento: a nova amostra vai direto para o diário
+      UplinkSample sample = { ref, value, timestamp, eventMicros, stats };
+      if (journalSample(sample)) uplinkStats.journaled++;
+      else uplinkStats.dropped++;
+      return 0;
+    }
+
+    UplinkSample &oldest = uplinkQueue[uplinkHead];
+
+    if (journalSample(oldest)) uplinkStats.journaled++;
+    else uplinkStats.dropped++;
+
+    uplinkHead = (uplinkHead + 1) % UPLINK_QUEUE_CAPACITY;
+    uplinkCount--;
+  }
+
+  if (uplinkCount == 0) uplinkOldestTime = millis();
+
+  UplinkSample &sample = uplinkQueue[(uplinkHead + uplinkCount) % UPLINK_QUEUE_CAPACITY];
+  sample.ref = ref;
+  sample.value = value;
+  sample.timestamp = timestamp;
+  sample.micros = eventMicros;
+  sample.stats = stats;
+  uplinkCount++;
+
+  // o envio sai de uplinkLogic, sem bloquear quem chamou: pelo websocket, na próxima passagem
+  // do loop(); por HTTPS, com o lote cheio ou na latência máxima
+  return 1;
+}
+
+bool RemoteIO::journalSample(const UplinkSample &sample)
+{
+  if (journal.append(sample.ref.c_str(), sample.value.c_str(), sample.timestamp, sample.stats.c_str())) return true;
+
+  // resumo maior que JOURNAL_EXTRA_LENGTH: o diário guarda ao menos a média
+  return (sample.stats.length() > 0) && journal.append(sample.ref.c_str(), sample.value.c_str(), sample.timestamp);
+}
+
+void RemoteIO::addStats(JsonObject item, const char *stats)
+{
+  if (stats[0] == '\0') return;
+
+  JsonDocument document(&jsonArena);
+  if (!deserializeJson(document, stats)) item["stats"] = document;
+}
+
+void RemoteIO::journalLogic()
+{
+  if (httpsOwner == HTTPS_OWNER_JOURNAL)
+  {
+    int httpCode = httpsResult(HTTPS_OWNER_JOURNAL);
+    if (httpCode == HTTPS_PENDING) return;
+
+    httpsFinish();
+    finishJournalReplay(httpCode);
+    journalInFlight = 0;
+    return;
+  }
+
+  // o reenvio só ocupa a conexão quando não há amostras ao vivo esperando, e no máximo um lote por intervalo
+  if ((connection_state != CONNECTED) || (uplinkCount > 0)) return;
+
+  if (journal.empty()) return;
+  if ((millis() - journalReplayTimestamp < JOURNAL_REPLAY_INTERVAL) || !uplinkBackoff.ready() || httpsBusy()) return;
+
+  // o reenvio não espera o SNTP: sem relógio, os horários que não dá para converter vão em "uptime"
+  time_t now = time(nullptr);
+  bool clockValid = (now >= CLOCK_VALID_AFTER);
+
+  journalReplayTimestamp = millis();
+
+  JournalRecord records[JOURNAL_REPLAY_BATCH];
+  uint8_t count = journal.read(records, JOURNAL_REPLAY_BATCH);
+
+  if (count == 0) return;
+
+  JsonDocument document(&jsonArena);
+  JsonArray batch = document.to<JsonArray>();
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    JsonObject item = batch.add<JsonObject>();
+    item["deviceId"] = _deviceId;
+    item["ref"] = records[i].ref;
+    item["value"] = records[i].value;
+    addStats(item, records[i].extra);
+
+    uint32_t timestamp = records[i].timestamp;
+    if (timestamp >= CLOCK_VALID_AFTER) item["timestamp"] = timestamp;
+    else
+    {
+      // antes do SNTP, time() conta segundos desde o boot: só dá para converter se for deste boot
+      uint32_t uptime = millis() / 1000;
+      if (clockValid && records[i].currentBoot && (timestamp <= uptime)) item["timestamp"] = (uint32_t)now - (uptime - timestamp);
+      else item["uptime"] = timestamp;
+    }
+  }
+
+  // sem commit() o próximo read() devolve os mesmos registros: uma falha aqui não perde nada
+  if (httpsPostDocument(HTTPS_OWNER_JOURNAL, appPostData, document, true, wireMsgPack)) journalInFlight = count;
+}
+
+void RemoteIO::finishJournalReplay(int httpCode)
+{
+  if (httpCode == HTTP_CODE_OK)
+  {
+    journal.commit();
+    journalAttempts = 0;
+    uplinkBackoff.reset();
+    REMOTEIO_LOGI("[journalLogic] %u amostras reenviadas", journalInFlight);
+    return;
+  }
+
+  // 401/403 pedem nova autenticação, e o lote volta depois dela
+  if ((httpCode == HTTP_CODE_UNAUTHORIZED) || (httpCode == HTTP_CODE_FORBIDDEN)) return;
+
+  // um 4xx definitivo não muda com novas tentativas: o lote é pulado para não travar o diário;
+  // nas demais falhas ele é repetido, com espera, até JOURNAL_REPLAY_MAX_ATTEMPTS vezes
+  bool rejected = (httpCode >= 400) && (httpCode < 500) && (httpCode != HTTP_CODE_REQUEST_TIMEOUT) && (httpCode != HTTP_CODE_TOO_MANY_REQUESTS);
+
+  if (rejected || (++journalAttempts >= JOURNAL_REPLAY_MAX_ATTEMPTS))
+  {
+    REMOTEIO_LOGE("[journalLogic] HTTP_CODE %i, %u amostras descartadas", httpCode, journalInFlight);
+    journal.commit();
+    journalAttempts = 0;
+    uplinkStats.replayDropped += journalInFlight;
+    return;
+  }
+
+  REMOTEIO_LOGW("[journalLogic] HTTP_CODE %i, tentativa %u", httpCode, journalAttempts);
+  uplinkBackoff.attempt();
+}
+
+void RemoteIO::uplinkLogic()
+{
+  if (httpsOwner == HTTPS_OWNER_UPLINK)
+  {
+    int httpCode = httpsResult(HTTPS_OWNER_UPLINK);
+    if (httpCode == HTTPS_PENDING) return;
+
+    httpsFinish();
+
+    uint8_t count = uplinkInFlight;
+    uplinkInFlight = 0;
+    finishUplinkBatch(count, httpCode, uplinkFlushReason, false);
+    return;
+  }
+
+  uint32_t *reasonCounter = nullptr;
+
+  if (uplinkCount == 0) uplinkFlushRequested = false;
+  else if (uplinkFlushRequested) reasonCounter = &uplinkStats.flushForced;
+  else if ((uplinkCount >= uplinkBatchSize) || socketUplinkActive()) reasonCounter = &uplinkStats.flushBySize;
+  else if (millis() - uplinkOldestTime >= uplinkMaxLatency) reasonCounter = &uplinkStats.flushByDeadline;
+
+  // depois de uma falha, o lote espera a vez da nova tentativa na fila em memória
+  if ((reasonCounter == nullptr) || !uplinkBackoff.ready()) return;
+
+  postUplinkBatch(reasonCounter);
+
+  // o pedido de flushUplink() vale até um lote sair (ou a fila ir para o diário)
+  if ((uplinkInFlight > 0) || (uplinkCount == 0)) uplinkFlushRequested = false;
+}
+
+int RemoteIO::postUplinkBatch(uint32_t *reasonCounter)
+{
+  // um lote por vez: as amostras do POST em andamento continuam no início da fila
+  if (uplinkInFlight > 0) return 0;
+
+  bool overSocket = socketUplinkActive();
+
+  // sem a plataforma a fila vai para o diário: o reenvio fica com journalLogic, um lote por
+  // JOURNAL_REPLAY_INTERVAL
+  if ((connection_state != CONNECTED) || (!overSocket && (WiFi.status() != WL_CONNECTED)))
+  {
+    journalUplinkQueue();
+    return 0;
+  }
+
+  uint8_t count = uplinkCount;
+  if (count > uplinkBatchSize) count = uplinkBatchSize;
+  if (count == 0) count = 1;
+
+  if (overSocket) return finishUplinkBatch(count, emitUplinkBatch(count), reasonCounter, true);
+
+  // o POST segue pelas próximas passagens do loop(); o resultado volta em uplinkLogic
+  if (!httpsBusy() && sendUplinkBatch(count))
+  {
+    uplinkInFlight = count;
+    uplinkFlushReason = reasonCounter;
+  }
+  return 0;
+}
+
+int RemoteIO::finishUplinkBatch(uint8_t count, int httpCode, uint32_t *reasonCounter, bool overSocket)
+{
+  if (httpCode != HTTP_CODE_OK)
+  {
+    uplinkStats.failures++;
+    uint32_t delay = uplinkBackoff.attempt();
+
+    // falha isolada: o lote fica na fila e sai de novo depois da espera; só depois de
+    // UPLINK_MAX_FAILURES seguidas a fila vai para a flash, enquanto as tentativas continuam
+    if (uplinkBackoff.failures < UPLINK_MAX_FAILURES)
+    {
+      REMOTEIO_LOGW("[postUplinkBatch] HTTP_CODE %i, nova tentativa em %lu ms", httpCode, (unsigned long)delay);
+      return httpCode;
+    }
+
+    REMOTEIO_LOGW("[postUplinkBatch] HTTP_CODE %i, %lu falhas seguidas, amostras movidas para o diário", httpCode, (unsigned long)uplinkBackoff.failures);
+    journalUplinkQueue();
+    return httpCode;
+  }
+
+  uplinkBackoff.reset();
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    UplinkSample &sample = uplinkQueue[uplinkHead];
+    sample.ref = String();
+    sample.value = String();
+    sample.stats = String();
+    uplinkHead = (uplinkHead + 1) % UPLINK_QUEUE_CAPACITY;
+  }
+  uplinkCount -= count;
+  uplinkOldestTime = millis();
+
+  (*reasonCounter)++;
+  uplinkStats.requests++;
+  uplinkStats.samples += count;
+  if (overSocket) uplinkStats.socketEvents += count;
+  else REMOTEIO_LOGD("[postUplinkBatch] HTTP_CODE 200, %u amostras", count);
+  return httpCode;
+}
+
+void RemoteIO::journalUplinkQueue()
+{
+  while (uplinkCount > 0)
+  {
+    UplinkSample &sample = uplinkQueue[uplinkHead];
+
+    if (journalSample(sample)) uplinkStats.journaled++;
+    else uplinkStats.dropped++;
+
+    sample.ref = String();
+    sample.value = String();
+    sample.stats = String();
+    uplinkHead = (uplinkHead + 1) % UPLINK_QUEUE_CAPACITY;
+    uplinkCount--;
+  }
+}
+
+void RemoteIO::uplinkItem(uint8_t index, JsonObject item)
+{
+  UplinkSample &sample = uplinkQueue[(uplinkHead + index) % UPLINK_QUEUE_CAPACITY];
+
+  item["deviceId"] = _deviceId;
+  item["ref"] = sample.ref;
+  item["value"] = sample.value;
+  item["timestamp"] = sample.timestamp;
+  if (sample.micros != 0) item["micros"] = sample.micros;
+  addStats(item, sample.stats.c_str());
+}
+
+bool RemoteIO::sendUplinkBatch(uint8_t count)
+{
+  // um documento por amostra, medido e depois gravado: a arena guarda o corpo e uma amostra,
+  // e não o array inteiro, que com a fila cheia passaria do tamanho dela
+  size_t capacity = RemoteIOWireBatch::overhead(count, wireMsgPack);
+  for (uint8_t i = 0; i < count; i++)
+  {
+    JsonDocument item(&jsonArena);
+    uplinkItem(i, item.to<JsonObject>());
+    capacity += RemoteIOWire::measure(item, wireMsgPack);
+  }
+
+  uint8_t *body = (uint8_t *)jsonArena.allocate(capacity);
+  if (body == nullptr) return false;
+
+  RemoteIOWireBatch batch;
+  batch.begin(body, capacity, count, wireMsgPack);
+  for (uint8_t i = 0; i < count; i++)
+  {
+    JsonDocument item(&jsonArena);
+    uplinkItem(i, item.to<JsonObject>());
+    batch.add(item);
+  }
+
+  size_t length = batch.end();
+  bool started = (length > 0) && httpsStartRequest(HTTPS_OWNER_UPLINK, "POST", appPostData, body, length, true, wireMsgPack);
+
+  jsonArena.deallocate(body);
+  return started;
+}
+
+int RemoteIO::emitUplinkBatch(uint8_t count)
+{
+  // um evento por lote, ["deviceData",[...]], com os mesmos itens do POST em /broker/data/;
+  // cada item passa pela arena sozinho, e só o texto do evento cresce com o lote
+  String output = "[\"" SOCKET_UPLINK_EVENT "\",[";
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    JsonDocument item(&jsonArena);
+    uplinkItem(i, item.to<JsonObject>());
+
+    String text;
+    serializeJson(item, text);
+    if (i > 0) output += ',';
+    output += text;
+  }
+  output += "]]";
+
+  return socketIO.sendEVENT(output) ? HTTP_CODE_OK : HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+}
+
+bool RemoteIO::socketUplinkActive()
+{
+  return socketUplink && (connection_state == CONNECTED);
+}
+
+void RemoteIO::setSocketUplink(bool enabled)
+{
+  socketUplink = enabled;
+}
+
+bool RemoteIO::httpsStartRequest(uint8_t owner, const char *method, const String &url, const uint8_t *body, size_t length, bool authorized, bool msgpack)
+{
+  String headers = "Content-Type: ";
+  headers += RemoteIOWire::contentType(msgpack);
+  headers += "\r\n";
+
+  if (authorized)
+  {
+    headers += "Authorization: Bearer " + token + "\r\n";
+    if (wireMsgPack) headers += "Accept: " WIRE_MSGPACK_TYPE ", application/json\r\n";
+  }
+
+  if (!httpsSession.start(method, url, headers, body, length)) return false;
+
+  httpsOwner = owner;
+  httpsAuthorized = authorized;
+  httpsRecorded = false;
+  httpsStart = micros();
+  return true;
+}
+
+// Codifica o documento num bloco da arena, do tamanho exato, e inicia o POST; start() copia o
+// corpo para a requisição, então o bloco é liberado logo em seguida.
+bool RemoteIO::httpsPostDocument(uint8_t owner, const String &url, JsonDocument &document, bool authorized, bool msgpack)
+{
+  size_t capacity = RemoteIOWire::measure(document, msgpack) + 1;
+  uint8_t *body = (uint8_t *)jsonArena.allocate(capacity);
+
+  if (body == nullptr) return false;
+
+  size_t length = RemoteIOWire::encode(document, msgpack, body, capacity);
+  bool started = (length > 0) && httpsStartRequest(owner, "POST", url, body, length, authorized, msgpack);
+
+  jsonArena.deallocate(body);
+  return started;
+}
+
+bool RemoteIO::httpsBusy()
+{
+  return (httpsOwner != HTTPS_OWNER_NONE) || !httpsSession.idle();
+}
+
+// Resultado da requisição de owner, HTTPS_PENDING enquanto ela anda.
+int RemoteIO::httpsResult(uint8_t owner)
+{
+  if (httpsOwner != owner) return HTTPS_PENDING;
+
+  int statusCode = httpsSession.result();
+  if ((statusCode == HTTPS_PENDING) || httpsRecorded) return statusCode;
+
+  // contado uma vez, com a duração somada de todas as passagens da requisição
+  httpsRecorded = true;
+  if (httpsAuthorized) checkAuthorization(statusCode);
+  metrics.recordHttps(micros() - httpsStart, statusCode);
+  return statusCode;
+}
+
+void RemoteIO::httpsFinish()
+{
+  httpsSession.end();
+  httpsOwner = HTTPS_OWNER_NONE;
+}
+
+void RemoteIO::httpsLogic()
+{
+  // etapa da conexão abandonada no meio da requisição (linkLogic mudou de estado): descarta a resposta
+  if (((httpsOwner == HTTPS_OWNER_VERIFY) && (link_state != LINK_AUTHENTICATE) && (link_state != LINK_REVALIDATE)) ||
+      ((httpsOwner == HTTPS_OWNER_LATEST) && (link_state != LINK_FETCH_LATEST)))
+  {
+    httpsFinish();
+  }
+
+  httpsSession.loop();
+}
+
+DeserializationError RemoteIO::decodeBody(JsonDocument &document, Stream &stream, JsonDocument &filter)
+{
+  // decide pela resposta, não pela negociação: a plataforma pode responder JSON mesmo assim
+  return RemoteIOWire::decode(document, stream, httpsSession.contentType().startsWith(WIRE_MSGPACK_TYPE), filter);
+}
+
+void RemoteIO::sizeTlsBuffers()
+{
+  tlsSized = true;
+
+  // todas as requisições HTTPS vão ao host de appBaseUrl
+  bool mfln = httpsSession.sizeBuffers(appBaseUrl);
+  REMOTEIO_LOGI("[sizeTlsBuffers] %s: MFLN %s", appBaseUrl.c_str(), mfln ? "aceito" : "recusado");
+}
@@ -14,13 +14,108 @@
 
 #define VERSION "1.4.0"
 
-#define JSON_DOCUMENT_CAPACITY 4096
+#define REMOTEIO_STATIC_RAM_BUDGET 16384  // bytes, limite verificado em compilação para sizeof(RemoteIO)
+
+#define HTTPS_OWNER_NONE 0          // dona da requisição em andamento na sessão HTTPS
+#define HTTPS_OWNER_VERIFY 1        // autenticação e revalidação (linkLogic)
+#define HTTPS_OWNER_LATEST 2        // últimos valores (linkLogic)
+#define HTTPS_OWNER_UPLINK 3        // lote da fila de envio (uplinkLogic)
+#define HTTPS_OWNER_JOURNAL 5       // reenvio do diário (journalLogic)
+#define LATEST_ELEMENTS_PER_PASS 8  // elementos do getdata lidos por passagem do loop()
+
+#define UPLINK_QUEUE_CAPACITY 32    // amostras aguardando envio em lote
+#define UPLINK_BATCH_SIZE 8         // amostras por requisição (padrão)
+#define UPLINK_BATCH_LATENCY 2000   // ms, espera máxima de uma amostra na fila (padrão)
+#define JOURNAL_REPLAY_BATCH 8      // amostras do diário por requisição de reenvio
+#define JOURNAL_REPLAY_INTERVAL 1000  // ms entre requisições de reenvio
+#define JOURNAL_REPLAY_MAX_ATTEMPTS 20  // tentativas de um mesmo lote do diário antes de descartá-lo
+#define CLOCK_VALID_AFTER 1600000000  // abaixo disso o relógio ainda não foi acertado pelo SNTP
+
+#define SOCKET_UPLINK_EVENT "deviceData"  // evento Socket.IO usado no envio de dados pelo websocket
+#define SOCKET_METRICS_EVENT "deviceMetrics"  // evento Socket.IO usado no envio periódico das métricas
 
 #define INICIALIZATION 0    // First state after start, never connected to nodeiot. 
 #define CONNECTED 1         // Connected to nodeiot, available to esp_now as well.
 #define NO_WIFI 2           // No Wi-Fi network, disconnected from nodeiot.
 #define DISCONNECTED 3      // No websocket connection, disconnected from nodeiot.
 
+#define LINK_IDLE 0           // No connection step in progress.
+#define LINK_WIFI_JOIN 1      // Waiting for the Wi-Fi association.
+#define LINK_AUTHENTICATE 2   // Authenticating on /devices/verify.
+#define LINK_FETCH_LATEST 3   // Fetching the latest values from /devices/getdata.
+#define LINK_SOCKET_JOIN 4    // Opening the websocket and joining the device room.
+#define LINK_REVALIDATE 5     // Re-verifying the cached token while already connected.
+#define LINK_LEASE_PROBE 6    // Resolving the platform host to tell a stale cached Wi-Fi lease from a platform outage.
+
+#define LEASE_PROBE_IDLE 0        // consulta DNS da concessão WiFi: nenhuma em andamento
+#define LEASE_PROBE_PENDING 1
+#define LEASE_PROBE_RESOLVED 2    // o DNS respondeu pela rede em cache
+#define LEASE_PROBE_FAILED 3
+
+#define RECONNECT_WIFI 0      // camadas da política de reconexão (setReconnectPolicy)
+#define RECONNECT_AUTH 1
+#define RECONNECT_SOCKET 2
+
+#define WIFI_BACKOFF_BASE 2000        // ms, espera inicial entre tentativas de conexão WiFi
+#define WIFI_BACKOFF_MAX 60000
+#define AUTH_BACKOFF_BASE 2000        // ms, espera inicial entre autenticações
+#define AUTH_BACKOFF_MAX 300000
+#define AUTH_REVERIFY_AFTER 3         // reconexões seguidas com o token em cache antes de autenticar de novo
+#define SOCKET_BACKOFF_BASE 1000      // ms, espera inicial entre reconexões do websocket
+#define SOCKET_BACKOFF_MAX 60000
+#define SOCKET_REJOIN_DELAY 60000     // ms sem websocket antes de refazer o fluxo de conexão
+#define UPLINK_BACKOFF_BASE 1000      // ms, espera inicial antes de repetir um lote que falhou
+#define UPLINK_BACKOFF_MAX 30000
+#define UPLINK_MAX_FAILURES 3         // falhas seguidas do envio ao vivo que mandam a fila para o diário
+
+#define LOCAL_API_USER "remoteio"      // usuário da API local; a senha é o localKey de CONFIG_FILE
+#define LOCAL_KEY_LENGTH 16
+#define LOCAL_COMMAND_QUEUE_CAPACITY 8  // comandos locais aguardando o loop()
+#define LOCAL_VALUE_LENGTH 24
+#define LOCAL_WS_CLEANUP_INTERVAL 1000  // ms entre limpezas de clientes websocket desconectados
+
+#define WIFI_DIRECT_TIMEOUT 1000        // ms de espera na conexão direta antes da busca completa
+#define WIFI_DIRECT_MAX_FAILURES 3      // falhas seguidas da conexão direta que descartam a rede em cache
+#define WIFI_LEASE_DNS_TIMEOUT 1000     // ms de espera da consulta DNS que separa falha da rede em cache de falha da plataforma
+
+#define CONFIG_FILE "/config.json"          // credenciais, localKey e rede WiFi em cache
+#define CONFIG_TEMP_FILE "/config.tmp"      // nova versão de CONFIG_FILE, completa antes de substituí-lo
+
+#define BOOT_CACHE_FILE "/cache.json"       // token, serverAddr e gpio da última autenticação aceita
+#define OUTPUT_CACHE_FILE "/outputs.json"   // últimos valores das saídas
+#define OUTPUT_CACHE_INTERVAL 10000         // ms, intervalo mínimo entre gravações das saídas
+#define WARM_BOOT_TIMEOUT 15000             // ms para o token em cache abrir o websocket
+
+#define IO_TABLE_CAPACITY 32    // refs configuráveis no dispositivo
+#define IO_REF_LENGTH 32        // tamanho máximo de uma ref, incluindo o terminador
+#define INPUT_MIN_DELAY 5000    // ms, intervalo mínimo entre leituras cíclicas
+
+#define IO_NONE 0               // virtual ou tipo não suportado ("N/L")
+#define IO_OUTPUT 1
+#define IO_INPUT 2
+#define IO_INPUT_PULLUP 3
+#define IO_INPUT_PULLDOWN 4
+#define IO_INPUT_ANALOG 5
+
+#define IO_MODE_CYCLIC 0        // leitura periódica via updatePinInput (padrão)
+#define IO_MODE_INTERRUPT 1     // "interrupt": bordas capturadas por interrupção
+#define IO_MODE_CHANGE 2        // "change": envia quando o nível muda, com debounce
+#define IO_MODE_DEADBAND 3      // "deadband": analógica, envia quando varia além da banda morta
+#define IO_MODE_AGGREGATE 4     // "aggregate": analógica, envia o resumo das leituras de cada janela
+
+#define INPUT_SCHEDULER_BUDGET 4        // leituras cíclicas por passagem do loop()
+
+#define INPUT_EVENT_QUEUE_CAPACITY 32   // eventos de interrupção pendentes
+#define INPUT_DEBOUNCE 50               // ms, padrão dos modos interrupt e change
+#define ANALOG_DEADBAND 8               // contagens do ADC, padrão do modo deadband
+#define ANALOG_POLL_INTERVAL 100        // ms entre leituras do modo deadband
+
+#define ADC_MIN_INTERVAL 10             // ms; leituras mais frequentes do ADC atrapalham o WiFi
+#define ADC_RING_SIZE 64                // leituras do timer do ADC aguardando o loop()
+
+#define AGGREGATE_CAPACITY 4            // entradas analógicas em modo aggregate
+#define AGGREGATE_SAMPLE_INTERVAL 20    // ms, padrão entre leituras do modo aggregate
+
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <WebSocketsClient.h>
@@ -30,49 +125,336 @@
 #include <FS.h>
 #include <WiFiClientSecure.h>
 #include <ESP8266WiFi.h>
+#include <lwip/dns.h>
 #include <ESP8266HTTPClient.h>
 #include <ESPAsyncTCP.h>
 #include <ESP8266mDNS.h>
+#include <Ticker.h>
+
+#include "RemoteIOJournal.h"
+#include "RemoteIOMetrics.h"
+#include "RemoteIOArena.h"
+#include "RemoteIOBackoff.h"
+#include "RemoteIORules.h"
+#include "RemoteIOLog.h"
+#include "RemoteIOBoards.h"
+#include "RemoteIOAggregate.h"
+#include "RemoteIOFilter.h"
+#include "RemoteIOHttps.h"
+#include "RemoteIOWire.h"
+#include "RemoteIOScheduler.h"
+
+struct UplinkSample
+{
+  String ref;
+  String value;
+  time_t timestamp;
+  uint32_t micros;      // instante da borda, em micros(), para entradas por interrupção
+  String stats;         // resumo da janela do modo aggregate, em JSON; vazio nas demais amostras
+};
+
+struct IOEntry
+{
+  char ref[IO_REF_LENGTH];
+  uint8_t pin;
+  uint8_t type;           // IO_NONE, IO_OUTPUT, IO_INPUT...
+  int32_t value;          // último valor lido ou comandado
+  uint32_t delay;         // ms entre leituras cíclicas
+  uint32_t timestamp;     // millis() da última leitura
+  uint8_t mode;           // IO_MODE_CYCLIC, IO_MODE_INTERRUPT...
+  uint8_t aggregate;      // canal em aggregates (modo aggregate)
+  uint16_t debounce;      // ms
+  int32_t deadband;
+  int32_t reported;       // último valor enviado, -1 se nenhum
+  int32_t pending;        // nível candidato durante o debounce (change) ou borda descartada nele (interrupt)
+  uint32_t changedAt;     // millis() (change) ou micros() (interrupt) da última mudança
+};
+
+struct InputEvent
+{
+  uint8_t slot;
+  uint8_t level;
+  uint32_t micros;
+};
+
+struct AggregateChannel
+{
+  RemoteIOAggregate window;   // leituras desde o último envio
+  uint16_t interval;          // ms entre leituras
+  uint32_t sampledAt;         // millis() da última leitura
+  bool percentiles;           // inclui p50, p90 e p99 no resumo
+};
+
+class RemoteIO;
+
+struct InputIrqContext
+{
+  RemoteIO *owner;
+  uint8_t slot;
+};
+
+// Comando recebido da plataforma. Os ponteiros só são válidos durante a chamada do callback.
+struct RemoteIOCommand
+{
+  const char *ref;
+  size_t refLength;
+  const char *value;
+  size_t valueLength;
+  bool isNumeric;         // value é um número; o valor convertido está em number
+  double number;
+};
+
+typedef void (*RemoteIOCallback)(const RemoteIOCommand &command, void *context);
+
+struct UplinkStats
+{
+  uint32_t requests;          // requisições de dados enviadas com sucesso
+  uint32_t samples;           // amostras entregues nessas requisições
+  uint32_t flushBySize;       // envios disparados por atingir o tamanho do lote
+  uint32_t flushByDeadline;   // envios disparados pela latência máxima
+  uint32_t flushForced;       // envios pedidos via flushUplink()
+  uint32_t failures;          // envios que não retornaram HTTP 200
+  uint32_t dropped;           // amostras descartadas com a fila cheia
+  uint32_t journaled;         // amostras movidas para o diário com a fila cheia
+  uint32_t socketEvents;      // amostras entregues como evento Socket.IO
+  uint32_t replayDropped;     // registros do diário descartados: lote recusado pela plataforma ou sem sucesso
+};
+
+struct BootMetrics
+{
+  bool warmBoot;              // boot feito a partir do cache
+  uint32_t boardDefaults;     // micros() em que as saídas da placa foram para o estado seguro
+  uint32_t outputsRestored;   // millis() em que as saídas voltaram ao último estado
+  uint32_t connected;         // millis() da primeira conexão com a plataforma
+};
+
+struct LocalCommand
+{
+  char ref[IO_REF_LENGTH];
+  char value[LOCAL_VALUE_LENGTH];
+};
+
+struct WiFiLease
+{
+  bool valid;
+  uint8_t bssid[6];
+  int32_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+struct WiFiJoinStats
+{
+  uint32_t directJoins;         // conexões feitas direto no BSSID/canal em cache, com IP fixo
+  uint32_t scanJoins;           // conexões feitas com busca completa e DHCP
+  uint32_t directFailures;      // conexões diretas que não responderam a tempo
+  uint32_t leaseInvalidations;  // vezes em que a rede em cache foi descartada
+  uint32_t lastJoinTime;        // ms da última conexão, desde o início da tentativa
+  uint32_t maxJoinTime;         // ms da conexão mais lenta
+  bool lastJoinDirected;
+};
 
 class RemoteIO 
 {
   public:
     RemoteIO();
     void begin(void (*userCallbackFunction)(String ref, String value));
+    void begin(RemoteIOCallback callback, void *context = nullptr);
     void loop();
     void updatePinOutput(String ref);
+    void updatePinOutput(String ref, int32_t value);
     void updatePinInput(String ref);
+    int32_t getIOValue(String ref);
     int espPOST(String variable, String value);
+    void setUplinkBatch(uint8_t batchSize, unsigned long maxLatency);
+    int flushUplink();
+    void setSocketUplink(bool enabled);
+    const UplinkStats &getUplinkStats();
+    const BootMetrics &getBootMetrics();
+    const WiFiJoinStats &getWiFiJoinStats();
+    void setMetricsPush(unsigned long interval);
+    void setReconnectPolicy(uint8_t layer, unsigned long baseDelay, unsigned long maxDelay);
+    void setAnalogFilter(unsigned long sampleInterval, uint8_t decimation, uint8_t window, uint8_t lowPassShift);
 
     JsonObject setIO;
     
   private:
     void notFound(AsyncWebServerRequest *request);
-    void setIOsAndEvents(JsonDocument document);
-    void tryWiFiConnection();
-    void tryAuthenticate();    
-    void fetchLatestData();
+    void setIOsAndEvents(JsonDocument &document);
+    uint8_t ioTypeFromString(const String &type);
+    bool boardAccepts(int pin, uint8_t type);
+    int findIO(const char *ref);
+    int registerIO(const char *ref, int pin, uint8_t type);
+    bool gpioListed(JsonArray gpio, const char *ref);
+    void removeUnlistedIOs(JsonArray gpio);
+    void buildIOIndex();
+    void writeOutput(int slot);
+    void mirrorIO(int slot);
+    void restoreBootCache();
+    void saveBootCache(JsonDocument &document);
+    void clearBootCache();
+    void cacheLogic();
+    void configureInputMode(int slot, const String &mode, JsonObject config);
+    static void inputISR(void *arg);
+    void inputLogic();
+    void reportInput(int slot, uint32_t eventMicros);
+    void reportAggregate(int slot);
+    void sampleInput(int slot);
+    void buildInputSchedule();
+    void schedulerLogic();
+    static void adcTick(RemoteIO *device);
+    void adcLogic();
+    int32_t readAnalog(uint8_t pin);
+    void checkAnalogPins();
+    void compileRules(JsonArray config);
+    static bool ruleRead(uint8_t slot, int32_t &value, void *context);
+    static void ruleWrite(uint8_t slot, int32_t value, void *context);
+    void reportOutput(int slot);
+    void rulesLogic();
+    bool tryWiFiConnection();
+    void startWiFiJoin(bool directed);
+    void wifiJoined();
+    void loadWiFiLease(JsonObject cache);
+    void saveWiFiLease();
+    bool writeConfig(JsonDocument &document);
+    void recoverConfig();
+    bool checkWiFiLease(int statusCode);
+    void invalidateWiFiLease();
+    static void leaseProbeFound(const char *name, const ip_addr_t *address, void *context);
+    bool checkAuthorization(int statusCode);
+    bool startAuthenticate();
+    int finishAuthenticate(int statusCode);
+    bool readLatestData(int statusCode);
+    void applyLatestValue(JsonObject item);
     void openLocalServer();
     void switchState();
     void stateLogic();
     void socketIOConnect();
-    void nodeIotConnection(void (*userCallbackFunction)(String ref, String value));
+    void socketIOLoop();
+    void openMetricsEndpoints();
+    void openLocalApi();
+    bool authorizeLocal(AsyncWebServerRequest *request);
+    void printIO(Print &out, int slot);
+    bool queueLocalCommand(const char *ref, const char *value);
+    void localSocketEvent(AsyncWebSocketClient *client, AwsEventType type, uint8_t *data, size_t length);
+    void pushLocal(int slot);
+    void localLogic();
+    void metricsLogic();
+    void describeMemory();
+    void nodeIotConnection();
     void socketIOEvent(socketIOmessageType_t type, uint8_t *payload, size_t length);
+    void linkLogic();
+    static void legacyCallbackAdapter(const RemoteIOCommand &command, void *context);
     void rebootDevice();
+    void scheduleRestart(unsigned long delayTime);
     void eraseDeviceSettings();
-    void infoUpdatedEventHandler(JsonDocument payload_doc);
+    void infoUpdatedEventHandler(const char *function);
     void extractIPAddress(String url);
     void getPCBModel();
+    void applyBoardProfile();
     void startAccessPoint();
-    int espPOST(String Router, String variable, String value);
+    bool httpsStartRequest(uint8_t owner, const char *method, const String &url, const uint8_t *body, size_t length, bool authorized, bool msgpack);
+    bool httpsPostDocument(uint8_t owner, const String &url, JsonDocument &document, bool authorized, bool msgpack);
+    bool httpsBusy();
+    int httpsResult(uint8_t owner);
+    void httpsFinish();
+    void httpsLogic();
+    DeserializationError decodeBody(JsonDocument &document, Stream &stream, JsonDocument &filter);
+    void sizeTlsBuffers();
+    int queueSample(const String &ref, const String &value, time_t timestamp, uint32_t eventMicros = 0, const String &stats = String());
+    bool journalSample(const UplinkSample &sample);
+    void addStats(JsonObject item, const char *stats);
+    int postUplinkBatch(uint32_t *reasonCounter);
+    int finishUplinkBatch(uint8_t count, int httpCode, uint32_t *reasonCounter, bool overSocket);
+    void journalUplinkQueue();
+    void uplinkItem(uint8_t index, JsonObject item);
+    bool sendUplinkBatch(uint8_t count);
+    int emitUplinkBatch(uint8_t count);
+    bool socketUplinkActive();
+    void uplinkLogic();
+    void journalLogic();
+    void finishJournalReplay(int httpCode);
 
+    RemoteIOCallback userCallback;
+    void *userContext;
     void (*storedCallbackFunction)(String ref, String value);
 
-    StaticJsonDocument<JSON_DOCUMENT_CAPACITY> configurationDocument;
+    JsonDocument configurationDocument;
+    RemoteIOArena jsonArena;    // documentos temporários criados a partir do loop()
     JsonArray configurations;
 
+    IOEntry ioTable[IO_TABLE_CAPACITY];
+    uint8_t ioIndex[IO_TABLE_CAPACITY];   // slots de ioTable ordenados por ref
+    uint8_t ioCount;
+
+    RemoteIOScheduler inputSchedule;    // leituras cíclicas, pela próxima a vencer
+
+    InputIrqContext irqContexts[IO_TABLE_CAPACITY];
+    InputEvent inputEvents[INPUT_EVENT_QUEUE_CAPACITY];
+    volatile uint8_t inputEventHead;    // escrito apenas pela interrupção
+    volatile uint8_t inputEventTail;    // escrito apenas pelo loop()
+    volatile uint32_t inputEventsDropped;
+    unsigned long analogPollTimestamp;
+
+    Ticker adcTicker;
+    RemoteIOFilter adcFilter;
+    uint16_t adcRing[ADC_RING_SIZE];
+    volatile uint8_t adcHead;           // escrito apenas pelo timer
+    volatile uint8_t adcTail;           // escrito apenas pelo loop()
+    volatile uint32_t adcDropped;       // leituras perdidas com o anel cheio
+    int32_t adcFiltered;                // última saída da cadeia de filtros, -1 se nenhuma
+
+    AggregateChannel aggregates[AGGREGATE_CAPACITY];
+    uint8_t aggregateCount;
+
     SocketIOclient socketIO;
     AsyncWebServer* server;
+    AsyncWebSocket* localSocket;
+    bool localServerOpen;
+    String localKey;
+    bool provisioned;           // credenciais gravadas: /get passa a exigir a chave local
+
+    RemoteIORules rules;
+
+    LocalCommand localCommands[LOCAL_COMMAND_QUEUE_CAPACITY];
+    volatile uint8_t localCommandHead;    // escrito pelo servidor assíncrono
+    volatile uint8_t localCommandTail;    // escrito pelo loop()
+    uint32_t localCommandsDropped;
+    unsigned long localCleanupTimestamp;
+
+    RemoteIOHttps httpsSession;
+    uint8_t httpsOwner;           // HTTPS_OWNER_*
+    bool httpsAuthorized;         // requisição com o token: 401/403 pedem nova autenticação
+    bool httpsRecorded;           // resultado já contado nas métricas
+    uint32_t httpsStart;          // micros() do início da requisição
+    bool tlsSized;                // sondagem MFLN feita: uma por boot, na primeira conexão WiFi
+    RemoteIOWireArray latestArray;  // leitura do getdata, retomada a cada passagem
+
+    UplinkSample uplinkQueue[UPLINK_QUEUE_CAPACITY];
+    uint8_t uplinkHead;
+    uint8_t uplinkCount;
+    uint8_t uplinkBatchSize;
+    uint8_t uplinkInFlight;       // amostras do início da fila no POST em andamento
+    uint32_t *uplinkFlushReason;  // contador do motivo do lote em andamento
+    bool uplinkFlushRequested;
+    unsigned long uplinkMaxLatency;
+    unsigned long uplinkOldestTime;
+    UplinkStats uplinkStats;
+    bool socketUplink;
+    RemoteIOBackoff uplinkBackoff;  // repetição do lote que falhou; failures conta as falhas seguidas
+
+    RemoteIOJournal journal;
+    unsigned long journalReplayTimestamp;
+    uint8_t journalInFlight;      // registros do diário no POST em andamento
+    uint8_t journalAttempts;      // falhas seguidas do lote no início do diário
+
+    bool outputsDirty;
+    unsigned long outputsSavedTimestamp;
+    bool revalidatePending;
+    unsigned long revalidateTimestamp;
+    BootMetrics bootMetrics;
 
     bool Connected;
     int Socketed;
@@ -83,6 +465,7 @@ class RemoteIO
     String _companyName;
     String _deviceId;
     String _model;
+    const BoardProfile *board;
     String _appHost;
     uint16_t _appPort;
     
@@ -92,7 +475,10 @@ class RemoteIO
     String appPostData;
     
     long start_debounce_time;
-    long start_reconnect_time;
+
+    RemoteIOBackoff wifiBackoff;
+    RemoteIOBackoff authBackoff;
+    RemoteIOBackoff socketBackoff;
 
     String state;
     String token;
@@ -100,7 +486,28 @@ class RemoteIO
     int connection_state;
     int next_state;
 
-    int reconnect_counter;
+    int link_state;
+
+    bool wireMsgPack;     // MessagePack aceito pela plataforma nos corpos HTTP
+
+    RemoteIOMetrics metrics;
+    unsigned long metricsPushInterval;
+    unsigned long metricsPushTimestamp;
+
+    WiFiLease wifiLease;
+    WiFiJoinStats wifiStats;
+    bool wifiJoinDirected;
+    bool wifiLeaseUnverified;   // conexão direta ainda sem resposta HTTPS
+    volatile uint8_t leaseProbe;        // LEASE_PROBE_*, escrito pelo callback do lwIP
+    unsigned long leaseProbeTimestamp;
+    int leaseProbeResume;               // etapa do linkLogic repetida quando a rede em cache está boa
+    uint8_t wifiDirectStreak;
+    unsigned long wifiJoinStart;
+    unsigned long wifiJoinTimestamp;
+
+    bool restart_requested;
+    unsigned long restart_timestamp;
+    unsigned long restart_delay;
 };
 
 #endif 
@@ -0,0 +1,99 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Agregação de entradas analógicas: leituras em alta taxa são    ##
+##   resumidas em mín/máx/média/desvio a cada janela de envio.      ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOAggregate.h"
+#include <math.h>
+#include <string.h>
+
+#define AGGREGATE_BUCKET_WIDTH (AGGREGATE_RANGE / AGGREGATE_BUCKETS)
+
+RemoteIOAggregate::RemoteIOAggregate()
+{
+  reset();
+}
+
+void RemoteIOAggregate::reset()
+{
+  samples = 0;
+  minimum = AGGREGATE_RANGE - 1;
+  maximum = 0;
+  sum = 0;
+  sumSquares = 0;
+  memset(buckets, 0, sizeof(buckets));
+}
+
+void RemoteIOAggregate::add(uint16_t sample)
+{
+  if (sample >= AGGREGATE_RANGE) sample = AGGREGATE_RANGE - 1;
+
+  samples++;
+  sum += sample;
+  sumSquares += (uint32_t)sample * sample;
+
+  if (sample < minimum) minimum = sample;
+  if (sample > maximum) maximum = sample;
+
+  uint16_t &bucket = buckets[sample / AGGREGATE_BUCKET_WIDTH];
+  if (bucket < 0xFFFF) bucket++;
+}
+
+bool RemoteIOAggregate::summarize(AggregateSummary &summary)
+{
+  if (samples == 0) return false;
+
+  summary.count = samples;
+  summary.min = minimum;
+  summary.max = maximum;
+
+  // em double: Σx² de uma janela longa não cabe na precisão de um float
+  double mean = (double)sum / samples;
+  double variance = (double)sumSquares / samples - mean * mean;
+
+  summary.mean = mean;
+  summary.stddev = (variance > 0) ? sqrt(variance) : 0;
+  return true;
+}
+
+uint16_t RemoteIOAggregate::percentile(uint8_t percent)
+{
+  if (samples == 0) return 0;
+  if (percent >= 100) return maximum;
+
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < AGGREGATE_BUCKETS; i++) total += buckets[i];
+
+  // posição (1..total) da leitura procurada, arredondada para cima
+  uint32_t rank = ((uint32_t)percent * total + 99) / 100;
+  if (rank == 0) return minimum;
+
+  uint32_t seen = 0;
+
+  for (uint8_t i = 0; i < AGGREGATE_BUCKETS; i++)
+  {
+    if (seen + buckets[i] < rank)
+    {
+      seen += buckets[i];
+      continue;
+    }
+
+    // interpolação linear dentro da faixa, limitada ao mínimo e máximo observados
+    uint32_t value = (uint32_t)i * AGGREGATE_BUCKET_WIDTH + ((rank - seen) * AGGREGATE_BUCKET_WIDTH) / buckets[i];
+    if (value > 0) value--;
+    if (value < minimum) value = minimum;
+    if (value > maximum) value = maximum;
+    return value;
+  }
+  return maximum;
+}
+
+uint32_t RemoteIOAggregate::count()
+{
+  return samples;
+}
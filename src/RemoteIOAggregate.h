@@ -0,0 +1,49 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Agregação de entradas analógicas: leituras em alta taxa são    ##
+##   resumidas em mín/máx/média/desvio a cada janela de envio.      ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOAggregate_h
+#define RemoteIOAggregate_h
+
+#include <stdint.h>
+
+#define AGGREGATE_RANGE 1024          // leituras de 0 a AGGREGATE_RANGE - 1 (ADC de 10 bits)
+#define AGGREGATE_BUCKETS 32          // faixas do histograma dos percentis, de 32 contagens cada
+
+struct AggregateSummary
+{
+  uint32_t count;
+  uint16_t min;
+  uint16_t max;
+  float mean;
+  float stddev;
+};
+
+// Acumuladores inteiros: add() custa poucas somas, sem ponto flutuante; média e
+// desvio só são calculados em summarize(), uma vez por janela.
+class RemoteIOAggregate
+{
+  public:
+    RemoteIOAggregate();
+    void reset();
+    void add(uint16_t sample);
+    bool summarize(AggregateSummary &summary);
+    uint16_t percentile(uint8_t percent);
+    uint32_t count();
+
+  private:
+    uint32_t samples;
+    uint16_t minimum;
+    uint16_t maximum;
+    uint64_t sum;
+    uint64_t sumSquares;
+    uint16_t buckets[AGGREGATE_BUCKETS];   // saturam em 65535
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Arena de memória dos documentos JSON temporários: um bloco     ##
+##   fixo, reservado uma vez, em vez de alocações no heap.          ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOArena.h"
+
+namespace
+{
+  // cada bloco é precedido pelo seu tamanho e pela posição do bloco anterior; 8 bytes mantêm
+  // o alinhamento de double e int64
+  const size_t HEADER_SIZE = 8;
+  const uint32_t FREED = 0xFFFFFFFF;    // tamanho de um bloco liberado abaixo do topo
+
+  size_t blockSize(size_t size)
+  {
+    return HEADER_SIZE + ((size + 7) & ~(size_t)7);
+  }
+}
+
+RemoteIOArena::RemoteIOArena()
+{
+  top = 0;
+  lastBlock = JSON_ARENA_SIZE;
+  liveBlocks = 0;
+  peak = 0;
+  fallbacks = 0;
+}
+
+bool RemoteIOArena::owns(void *pointer)
+{
+  return ((uint8_t *)pointer >= buffer) && ((uint8_t *)pointer < buffer + JSON_ARENA_SIZE);
+}
+
+void *RemoteIOArena::allocate(size_t size)
+{
+  if (top + blockSize(size) > JSON_ARENA_SIZE)
+  {
+    fallbacks++;
+    return malloc(size);
+  }
+
+  *(uint32_t *)&buffer[top] = size;
+  *(uint32_t *)&buffer[top + 4] = lastBlock;
+  lastBlock = top;
+  top += blockSize(size);
+  liveBlocks++;
+  if (top > peak) peak = top;
+
+  return &buffer[lastBlock + HEADER_SIZE];
+}
+
+void RemoteIOArena::deallocate(void *pointer)
+{
+  if (pointer == nullptr) return;
+
+  if (!owns(pointer))
+  {
+    free(pointer);
+    return;
+  }
+
+  size_t offset = (uint8_t *)pointer - buffer - HEADER_SIZE;
+
+  if (--liveBlocks == 0)
+  {
+    top = 0;
+    lastBlock = JSON_ARENA_SIZE;
+  }
+  else if (offset != lastBlock)
+  {
+    // liberado fora de ordem: o espaço volta quando os blocos acima dele também forem liberados
+    *(uint32_t *)&buffer[offset] = FREED;
+  }
+  else
+  {
+    do
+    {
+      top = lastBlock;
+      lastBlock = *(uint32_t *)&buffer[lastBlock + 4];
+    } while ((lastBlock != JSON_ARENA_SIZE) && (*(uint32_t *)&buffer[lastBlock] == FREED));
+  }
+}
+
+void *RemoteIOArena::reallocate(void *pointer, size_t newSize)
+{
+  if (pointer == nullptr) return allocate(newSize);
+  if (!owns(pointer)) return realloc(pointer, newSize);
+
+  size_t offset = (uint8_t *)pointer - buffer - HEADER_SIZE;
+  uint32_t oldSize = *(uint32_t *)&buffer[offset];
+
+  // o bloco do topo cresce ou encolhe no lugar
+  if ((offset == lastBlock) && (offset + blockSize(newSize) <= JSON_ARENA_SIZE))
+  {
+    *(uint32_t *)&buffer[offset] = newSize;
+    top = offset + blockSize(newSize);
+    if (top > peak) peak = top;
+    return pointer;
+  }
+
+  if (newSize <= oldSize)
+  {
+    *(uint32_t *)&buffer[offset] = newSize;
+    return pointer;
+  }
+
+  void *moved = allocate(newSize);
+  if (moved == nullptr) return nullptr;
+
+  memcpy(moved, pointer, oldSize);
+  deallocate(pointer);
+  return moved;
+}
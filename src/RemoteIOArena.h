@@ -0,0 +1,43 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Arena de memória dos documentos JSON temporários: um bloco     ##
+##   fixo, reservado uma vez, em vez de alocações no heap.          ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOArena_h
+#define RemoteIOArena_h
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define JSON_ARENA_SIZE 6144    // bytes; pedidos acima disso vão para o heap
+
+// Alocador por pilha: cada bloco é colocado após o anterior, e liberar o bloco do
+// topo devolve também os blocos logo abaixo dele que já foram liberados; a arena
+// inteira volta ao início quando o último documento é liberado. Só o bloco do topo
+// pode crescer no lugar. Usar apenas a partir do loop(), nunca em callbacks assíncronos.
+class RemoteIOArena : public ArduinoJson::Allocator
+{
+  public:
+    RemoteIOArena();
+    void *allocate(size_t size) override;
+    void deallocate(void *pointer) override;
+    void *reallocate(void *pointer, size_t newSize) override;
+
+    size_t peak;          // maior ocupação da arena desde o boot
+    uint32_t fallbacks;   // alocações atendidas pelo heap por falta de espaço
+
+  private:
+    bool owns(void *pointer);
+
+    alignas(8) uint8_t buffer[JSON_ARENA_SIZE];
+    size_t top;
+    size_t lastBlock;     // início do bloco do topo, JSON_ARENA_SIZE quando não há
+    uint16_t liveBlocks;
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Espera entre tentativas de reconexão: crescimento exponencial  ##
+##   com jitter descorrelacionado e pedidos Retry-After.            ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOBackoff.h"
+
+RemoteIOBackoff::RemoteIOBackoff(uint32_t baseDelay, uint32_t maxDelay)
+{
+  configure(baseDelay, maxDelay);
+  reset();
+}
+
+void RemoteIOBackoff::configure(uint32_t baseDelay, uint32_t maxDelay)
+{
+  base = baseDelay;
+  cap = (maxDelay > baseDelay) ? maxDelay : baseDelay;
+}
+
+bool RemoteIOBackoff::ready()
+{
+  return millis() - timestamp >= wait;
+}
+
+uint32_t RemoteIOBackoff::attempt()
+{
+  // jitter descorrelacionado: sleep = min(cap, aleatório entre base e 3 * sleep)
+  uint32_t upper = (sleep > cap / 3) ? cap : sleep * 3;
+  if (upper <= base) upper = base + 1;
+
+  // gerador por hardware: cada dispositivo segue uma sequência diferente desde o boot
+  sleep = secureRandom(base, upper);
+
+  failures++;
+  timestamp = millis();
+  wait = sleep;
+  return wait;
+}
+
+void RemoteIOBackoff::defer(uint32_t delay)
+{
+  if (delay > BACKOFF_MAX_DEFER) delay = BACKOFF_MAX_DEFER;
+
+  uint32_t remaining = ready() ? 0 : wait - (millis() - timestamp);
+  if (delay <= remaining) return;
+
+  timestamp = millis();
+  wait = delay;
+}
+
+void RemoteIOBackoff::reset()
+{
+  failures = 0;
+  sleep = base;
+  wait = 0;
+  timestamp = millis();
+}
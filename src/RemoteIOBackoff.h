@@ -0,0 +1,41 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Espera entre tentativas de reconexão: crescimento exponencial  ##
+##   com jitter descorrelacionado e pedidos Retry-After.            ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOBackoff_h
+#define RemoteIOBackoff_h
+
+#include <Arduino.h>
+
+#define BACKOFF_MAX_DEFER 600000    // ms, limite para esperas pedidas pelo servidor
+
+// Cada tentativa sorteia a próxima espera entre base e 3x a espera anterior,
+// limitada a maxDelay. Dispositivos que caíram juntos se espalham no tempo em
+// vez de voltarem todos no mesmo instante.
+class RemoteIOBackoff
+{
+  public:
+    RemoteIOBackoff(uint32_t baseDelay, uint32_t maxDelay);
+    void configure(uint32_t baseDelay, uint32_t maxDelay);
+    bool ready();
+    uint32_t attempt();
+    void defer(uint32_t delay);
+    void reset();
+
+    uint32_t failures;    // tentativas desde o último reset()
+
+  private:
+    uint32_t base;
+    uint32_t cap;
+    uint32_t sleep;       // última espera sorteada
+    uint32_t wait;        // espera atual, contada a partir de timestamp
+    uint32_t timestamp;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Perfis das placas: tabela de IOs de cada modelo, gerada por    ##
+##   scripts/board_profiles.py a partir de data_files. Não editar.  ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOBoards_h
+#define RemoteIOBoards_h
+
+#include <stdint.h>
+
+#define BOARD_PIN_VIRTUAL 0xFF   // ref sem pino físico ("pin": "")
+
+struct BoardPin
+{
+  const char *ref;
+  uint8_t pin;
+  uint8_t type;           // IO_NONE, IO_OUTPUT, IO_INPUT...
+  uint8_t safeLevel;      // LOW ou HIGH, nível das saídas no boot ("safe" em model.json)
+};
+
+struct BoardProfile
+{
+  const char *model;
+  const BoardPin *pins;
+  uint8_t count;
+};
+
+#define BOARD_ESP_8266 0
+#define BOARD_ESP_8266R1 1
+#define BOARD_ESP_8266R2 2
+#define BOARD_ESP_8266R4 3
+#define BOARD_ESP_8266R8 4
+#define BOARD_PROFILE_COUNT 5
+
+static constexpr BoardPin BOARD_PINS_ESP_8266[] = {
+  { "disconnect", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "restart", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "reset", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+};
+
+static constexpr BoardPin BOARD_PINS_ESP_8266R1[] = {
+  { "rel", 4, IO_OUTPUT, LOW },
+  { "disconnect", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "restart", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "reset", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+};
+
+static constexpr BoardPin BOARD_PINS_ESP_8266R2[] = {
+  { "rel1", 4, IO_OUTPUT, LOW },
+  { "rel2", 5, IO_OUTPUT, LOW },
+  { "disconnect", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "restart", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "reset", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+};
+
+static constexpr BoardPin BOARD_PINS_ESP_8266R4[] = {
+  { "rel1", 16, IO_OUTPUT, LOW },
+  { "rel2", 14, IO_OUTPUT, LOW },
+  { "rel3", 12, IO_OUTPUT, LOW },
+  { "rel4", 13, IO_OUTPUT, LOW },
+  { "disconnect", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "restart", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "reset", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+};
+
+static constexpr BoardPin BOARD_PINS_ESP_8266R8[] = {
+  { "rel1", 4, IO_OUTPUT, LOW },
+  { "rel2", 5, IO_OUTPUT, LOW },
+  { "rel3", 12, IO_OUTPUT, LOW },
+  { "rel4", 13, IO_OUTPUT, LOW },
+  { "rel5", 2, IO_OUTPUT, HIGH },
+  { "rel6", 14, IO_OUTPUT, LOW },
+  { "rel7", 15, IO_OUTPUT, LOW },
+  { "rel8", 16, IO_OUTPUT, LOW },
+  { "disconnect", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "restart", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+  { "reset", BOARD_PIN_VIRTUAL, IO_NONE, LOW },
+};
+
+static constexpr BoardProfile BOARD_PROFILES[BOARD_PROFILE_COUNT] = {
+  { "ESP_8266", BOARD_PINS_ESP_8266, 3 },
+  { "ESP_8266R1", BOARD_PINS_ESP_8266R1, 4 },
+  { "ESP_8266R2", BOARD_PINS_ESP_8266R2, 5 },
+  { "ESP_8266R4", BOARD_PINS_ESP_8266R4, 7 },
+  { "ESP_8266R8", BOARD_PINS_ESP_8266R8, 11 },
+};
+
+#endif
@@ -0,0 +1,280 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Leitura de eventos Socket.IO diretamente sobre o buffer        ##
+##   recebido, sem cópias e sem alocação de memória.                ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOEvent.h"
+#include <string.h>
+
+namespace
+{
+  const char NULL_TEXT[] = "null";
+
+  struct Cursor
+  {
+    char *position;
+    char *end;
+  };
+
+  struct Field
+  {
+    char *start;
+    size_t length;
+    bool isString;
+  };
+
+  void skipSpaces(Cursor &cursor)
+  {
+    while ((cursor.position < cursor.end) && ((*cursor.position == ' ') || (*cursor.position == '\t') || (*cursor.position == '\n') || (*cursor.position == '\r')))
+    {
+      cursor.position++;
+    }
+  }
+
+  bool readHex4(const char *in, const char *end, unsigned long &codepoint)
+  {
+    if (end - in < 4) return false;
+
+    codepoint = 0;
+    for (int i = 0; i < 4; i++)
+    {
+      char c = in[i];
+      codepoint <<= 4;
+      if ((c >= '0') && (c <= '9')) codepoint |= c - '0';
+      else if ((c >= 'a') && (c <= 'f')) codepoint |= c - 'a' + 10;
+      else if ((c >= 'A') && (c <= 'F')) codepoint |= c - 'A' + 10;
+      else return false;
+    }
+    return true;
+  }
+
+  char *writeUtf8(char *out, unsigned long codepoint)
+  {
+    if (codepoint < 0x80)
+    {
+      *out++ = (char)codepoint;
+    }
+    else if (codepoint < 0x800)
+    {
+      *out++ = (char)(0xC0 | (codepoint >> 6));
+      *out++ = (char)(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+      *out++ = (char)(0xE0 | (codepoint >> 12));
+      *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+      *out++ = (char)(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+      *out++ = (char)(0xF0 | (codepoint >> 18));
+      *out++ = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+      *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+      *out++ = (char)(0x80 | (codepoint & 0x3F));
+    }
+    return out;
+  }
+
+  // Decodifica a string no próprio buffer. O texto decodificado nunca é maior
+  // que o escapado, então a escrita nunca ultrapassa a leitura.
+  bool readString(Cursor &cursor, Field &field)
+  {
+    if ((cursor.position >= cursor.end) || (*cursor.position != '"')) return false;
+
+    char *in = cursor.position + 1;
+    char *out = in;
+
+    field.start = in;
+    field.isString = true;
+
+    while (in < cursor.end)
+    {
+      char c = *in++;
+
+      if (c == '"')
+      {
+        field.length = out - field.start;
+        cursor.position = in;
+        return true;
+      }
+
+      if (c != '\\')
+      {
+        *out++ = c;
+        continue;
+      }
+
+      if (in >= cursor.end) return false;
+
+      c = *in++;
+      switch (c)
+      {
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u':
+        {
+          unsigned long codepoint;
+          if (!readHex4(in, cursor.end, codepoint)) return false;
+          in += 4;
+
+          // par substituto UTF-16
+          unsigned long low;
+          if ((codepoint >= 0xD800) && (codepoint <= 0xDBFF) && (cursor.end - in >= 6) && (in[0] == '\\') && (in[1] == 'u') && readHex4(in + 2, cursor.end, low) && (low >= 0xDC00) && (low <= 0xDFFF))
+          {
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+            in += 6;
+          }
+
+          out = writeUtf8(out, codepoint);
+          break;
+        }
+        default:
+          *out++ = c;   // \" \\ \/
+          break;
+      }
+    }
+    return false;
+  }
+
+  // Lê qualquer valor JSON. Strings são decodificadas; os demais tipos são
+  // devolvidos como o trecho de texto original.
+  bool readValue(Cursor &cursor, Field &field)
+  {
+    skipSpaces(cursor);
+    if (cursor.position >= cursor.end) return false;
+
+    char c = *cursor.position;
+
+    if (c == '"') return readString(cursor, field);
+
+    field.start = cursor.position;
+    field.isString = false;
+
+    if ((c == '{') || (c == '['))
+    {
+      int depth = 0;
+      bool inString = false;
+
+      while (cursor.position < cursor.end)
+      {
+        c = *cursor.position++;
+
+        if (inString)
+        {
+          if (c == '\\') cursor.position++;
+          else if (c == '"') inString = false;
+        }
+        else if (c == '"') inString = true;
+        else if ((c == '{') || (c == '[')) depth++;
+        else if (((c == '}') || (c == ']')) && (--depth == 0))
+        {
+          field.length = cursor.position - field.start;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    while ((cursor.position < cursor.end) && (strchr(",}] \t\r\n", *cursor.position) == NULL))
+    {
+      cursor.position++;
+    }
+
+    field.length = cursor.position - field.start;
+    return field.length > 0;
+  }
+
+  bool isKey(const Field &key, const char *name)
+  {
+    size_t length = strlen(name);
+    return (key.length == length) && (memcmp(key.start, name, length) == 0);
+  }
+}
+
+bool parseRemoteIOEvent(char *payload, size_t length, RemoteIOEvent &event)
+{
+  Cursor cursor = { payload, payload + length };
+  Field name = { NULL, 0, true };
+  Field ref = { NULL, 0, true };
+  Field value = { NULL, 0, true };
+  Field function = { NULL, 0, true };
+
+  event.id = 0;
+  while ((cursor.position < cursor.end) && (*cursor.position >= '0') && (*cursor.position <= '9'))
+  {
+    event.id = (event.id * 10) + (*cursor.position++ - '0');
+  }
+
+  skipSpaces(cursor);
+  if ((cursor.position >= cursor.end) || (*cursor.position != '[')) return false;
+  cursor.position++;
+
+  skipSpaces(cursor);
+  if (!readString(cursor, name)) return false;
+
+  skipSpaces(cursor);
+  if ((cursor.position < cursor.end) && (*cursor.position == ','))
+  {
+    cursor.position++;
+    skipSpaces(cursor);
+
+    if ((cursor.position < cursor.end) && (*cursor.position == '{'))
+    {
+      cursor.position++;
+
+      while (true)
+      {
+        skipSpaces(cursor);
+        if (cursor.position >= cursor.end) return false;
+        if (*cursor.position == '}') break;
+
+        Field key;
+        Field field;
+
+        if (!readString(cursor, key)) return false;
+        skipSpaces(cursor);
+        if ((cursor.position >= cursor.end) || (*cursor.position != ':')) return false;
+        cursor.position++;
+        if (!readValue(cursor, field)) return false;
+
+        if (isKey(key, "ref")) ref = field;
+        else if (isKey(key, "value")) value = field;
+        else if (isKey(key, "function")) function = field;
+
+        skipSpaces(cursor);
+        if (cursor.position >= cursor.end) return false;
+        if (*cursor.position == ',') cursor.position++;
+        else if (*cursor.position != '}') return false;
+      }
+    }
+  }
+
+  // só termina os campos depois da leitura completa: o '\0' pode cair sobre
+  // um delimitador (',' ou '}') que a leitura ainda precisaria ver
+  Field *fields[] = { &name, &ref, &value, &function };
+  for (Field *field : fields)
+  {
+    if (field->start == NULL) continue;
+    if (field->start + field->length >= cursor.end) return false;
+    field->start[field->length] = '\0';
+  }
+
+  event.name = name.start;
+  event.nameLength = name.length;
+  event.ref = ref.start ? ref.start : NULL_TEXT;
+  event.refLength = ref.start ? ref.length : 4;
+  event.value = value.start ? value.start : NULL_TEXT;
+  event.valueLength = value.start ? value.length : 4;
+  event.valueIsString = value.start ? value.isString : false;
+  event.function = function.start ? function.start : NULL_TEXT;
+  event.functionLength = function.start ? function.length : 4;
+  return true;
+}
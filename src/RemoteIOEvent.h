@@ -0,0 +1,36 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Leitura de eventos Socket.IO diretamente sobre o buffer        ##
+##   recebido, sem cópias e sem alocação de memória.                ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOEvent_h
+#define RemoteIOEvent_h
+
+#include <stddef.h>
+
+// Campos de um evento ["nome", {"ref": ..., "value": ..., "function": ...}].
+// Os ponteiros apontam para dentro do payload recebido, que é alterado no lugar:
+// strings são decodificadas e todos os campos terminam em '\0'. Campos ausentes
+// apontam para "null", como o valor textual de um campo nulo no ArduinoJson.
+struct RemoteIOEvent
+{
+  long id;                  // id de confirmação (ack), 0 quando ausente
+  const char *name;
+  size_t nameLength;
+  const char *ref;
+  size_t refLength;
+  const char *value;
+  size_t valueLength;
+  bool valueIsString;       // false para números, booleanos, objetos e arrays
+  const char *function;
+  size_t functionLength;
+};
+
+bool parseRemoteIOEvent(char *payload, size_t length, RemoteIOEvent &event);
+
+#endif
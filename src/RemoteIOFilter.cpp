@@ -0,0 +1,135 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Filtros do ADC em ponto fixo: decimação, média móvel e         ##
+##   passa-baixas IIR, aplicados às leituras no loop().             ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOFilter.h"
+
+FilterDecimator::FilterDecimator()
+{
+  configure(1);
+}
+
+void FilterDecimator::configure(uint8_t factor)
+{
+  if (factor < 1) factor = 1;
+  if (factor > FILTER_DECIMATION_MAX) factor = FILTER_DECIMATION_MAX;
+
+  this->factor = factor;
+  reset();
+}
+
+void FilterDecimator::reset()
+{
+  count = 0;
+  sum = 0;
+}
+
+bool FilterDecimator::push(int32_t sample, int32_t &output)
+{
+  sum += sample;
+  if (++count < factor) return false;
+
+  output = (sum << FILTER_FRACTION_BITS) / factor;
+  reset();
+  return true;
+}
+
+FilterMovingAverage::FilterMovingAverage()
+{
+  configure(1);
+}
+
+void FilterMovingAverage::configure(uint8_t window)
+{
+  if (window < 1) window = 1;
+  if (window > FILTER_WINDOW_MAX) window = FILTER_WINDOW_MAX;
+
+  this->window = window;
+  reset();
+}
+
+void FilterMovingAverage::reset()
+{
+  filled = 0;
+  position = 0;
+  sum = 0;
+}
+
+int32_t FilterMovingAverage::push(int32_t input)
+{
+  // enquanto a janela enche, a média é feita só sobre as entradas já recebidas
+  if (filled == window) sum -= values[position];
+  else filled++;
+
+  values[position] = input;
+  sum += input;
+  position = (position + 1) % window;
+
+  return sum / filled;
+}
+
+FilterLowPass::FilterLowPass()
+{
+  configure(0);
+}
+
+void FilterLowPass::configure(uint8_t shift)
+{
+  if (shift > FILTER_SHIFT_MAX) shift = FILTER_SHIFT_MAX;
+
+  this->shift = shift;
+  reset();
+}
+
+void FilterLowPass::reset()
+{
+  primed = false;
+  state = 0;
+}
+
+int32_t FilterLowPass::push(int32_t input)
+{
+  // a primeira entrada inicializa o estado, sem a subida lenta a partir de zero
+  if (!primed)
+  {
+    state = input * 256;
+    primed = true;
+  }
+  else state += ((input * 256) - state) >> shift;
+
+  return (state + 128) >> 8;
+}
+
+RemoteIOFilter::RemoteIOFilter()
+{
+}
+
+void RemoteIOFilter::configure(uint8_t decimation, uint8_t window, uint8_t lowPassShift)
+{
+  decimator.configure(decimation);
+  average.configure(window);
+  lowPass.configure(lowPassShift);
+}
+
+void RemoteIOFilter::reset()
+{
+  decimator.reset();
+  average.reset();
+  lowPass.reset();
+}
+
+bool RemoteIOFilter::push(uint16_t sample, int32_t &output)
+{
+  int32_t decimated;
+
+  if (!decimator.push(sample, decimated)) return false;
+
+  output = lowPass.push(average.push(decimated));
+  return true;
+}
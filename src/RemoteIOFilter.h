@@ -0,0 +1,82 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Filtros do ADC em ponto fixo: decimação, média móvel e         ##
+##   passa-baixas IIR, aplicados às leituras no loop().             ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOFilter_h
+#define RemoteIOFilter_h
+
+#include <stdint.h>
+
+#define FILTER_FRACTION_BITS 4      // saídas em ponto fixo, em 1/16 de contagem do ADC
+#define FILTER_DECIMATION_MAX 64    // leituras somadas por saída da decimação
+#define FILTER_WINDOW_MAX 16        // saídas da decimação na média móvel
+#define FILTER_SHIFT_MAX 8          // passa-baixas: alfa = 1 / 2^shift
+
+// Soma "factor" leituras e entrega a média, com FILTER_FRACTION_BITS bits de fração.
+class FilterDecimator
+{
+  public:
+    FilterDecimator();
+    void configure(uint8_t factor);
+    void reset();
+    bool push(int32_t sample, int32_t &output);
+
+  private:
+    uint8_t factor;
+    uint8_t count;
+    int32_t sum;
+};
+
+// Média das últimas "window" entradas; soma corrente, sem percorrer a janela.
+class FilterMovingAverage
+{
+  public:
+    FilterMovingAverage();
+    void configure(uint8_t window);
+    void reset();
+    int32_t push(int32_t input);
+
+  private:
+    int32_t values[FILTER_WINDOW_MAX];
+    uint8_t window;
+    uint8_t filled;
+    uint8_t position;
+    int32_t sum;
+};
+
+// y += (x - y) / 2^shift, com 8 bits extras no estado para não perder a fração.
+class FilterLowPass
+{
+  public:
+    FilterLowPass();
+    void configure(uint8_t shift);
+    void reset();
+    int32_t push(int32_t input);
+
+  private:
+    uint8_t shift;
+    bool primed;
+    int32_t state;
+};
+
+class RemoteIOFilter
+{
+  public:
+    RemoteIOFilter();
+    void configure(uint8_t decimation, uint8_t window, uint8_t lowPassShift);
+    void reset();
+    bool push(uint16_t sample, int32_t &output);
+
+  private:
+    FilterDecimator decimator;
+    FilterMovingAverage average;
+    FilterLowPass lowPass;
+};
+
+#endif
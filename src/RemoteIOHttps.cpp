@@ -0,0 +1,459 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Sessão HTTPS sem bloqueio: conexão, envio e leitura da         ##
+##   resposta avançam um pouco a cada loop(), sobre um único        ##
+##   socket TLS mantido entre as requisições (keep-alive).          ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOHttps.h"
+
+RemoteIOHttps::RemoteIOHttps()
+{
+  handshakes = 0;
+  state = HTTPS_IDLE;
+  status = HTTPS_PENDING;
+  port = 443;
+  sent = 0;
+  reused = false;
+  retried = false;
+  startedAt = 0;
+  contentLength = -1;
+  chunked = false;
+  close = false;
+  retry = 0;
+
+  // quando o socket cai, a nova conexão retoma a sessão TLS guardada em session
+  client.setInsecure();
+  client.setSession(&session);
+  client.setBufferSizes(TLS_RX_BUFFER_FULL, TLS_FRAGMENT_LENGTH);
+  client.setTimeout(HTTPS_READ_TIMEOUT);
+  response.setTimeout(HTTPS_READ_TIMEOUT);
+  line.reserve(HTTPS_LINE_LENGTH);
+}
+
+bool RemoteIOHttps::parseUrl(const String &url, String &host, uint16_t &port, String &path)
+{
+  int start = url.indexOf("//");
+  if (start < 0) return false;
+  start += 2;
+
+  int end = url.indexOf('/', start);
+  host = url.substring(start, (end < 0) ? url.length() : end);
+  path = (end < 0) ? String("/") : url.substring(end);
+  port = 443;
+
+  int colon = host.indexOf(':');
+  if (colon >= 0)
+  {
+    port = host.substring(colon + 1).toInt();
+    host = host.substring(0, colon);
+  }
+  return host.length() > 0;
+}
+
+bool RemoteIOHttps::sizeBuffers(const String &url)
+{
+  String probeHost, path;
+  uint16_t probePort;
+
+  if (!parseUrl(url, probeHost, probePort, path)) return false;
+
+  // com fragmentos de 1 KB negociados, o BearSSL usa ~2 KB de buffers em vez de ~17 KB;
+  // a sondagem abre uma conexão extra e bloqueia como um handshake
+  bool mfln = WiFiClientSecure::probeMaxFragmentLength(probeHost, probePort, TLS_FRAGMENT_LENGTH);
+  client.setBufferSizes(mfln ? TLS_FRAGMENT_LENGTH : TLS_RX_BUFFER_FULL, TLS_FRAGMENT_LENGTH);
+  return mfln;
+}
+
+bool RemoteIOHttps::start(const char *method, const String &url, const String &headers, const uint8_t *payload, size_t length)
+{
+  String requestHost, path;
+  uint16_t requestPort;
+
+  if ((state != HTTPS_IDLE) || !parseUrl(url, requestHost, requestPort, path)) return false;
+
+  // o socket keep-alive só serve ao mesmo servidor
+  if ((requestHost != host) || (requestPort != port)) client.stop();
+  host = requestHost;
+  port = requestPort;
+
+  request = String();
+  request.reserve(160 + path.length() + headers.length() + length);
+  request += method;
+  request += ' ';
+  request += path;
+  request += " HTTP/1.1\r\nHost: ";
+  request += host;
+  if (port != 443)
+  {
+    request += ':';
+    request += (unsigned int)port;
+  }
+  // HTTP/1.1: conexão persistente por padrão, e respostas em chunks lidas por HttpsBody
+  request += "\r\nUser-Agent: ESP8266RemoteIO\r\nConnection: keep-alive\r\n";
+  request += headers;
+  request += "Content-Length: ";
+  request += (unsigned int)length;
+  request += "\r\n\r\n";
+  if (length > 0) request.concat((const char *)payload, length);
+
+  status = HTTPS_PENDING;
+  retried = false;
+  startedAt = millis();
+  state = HTTPS_CONNECT;
+  return true;
+}
+
+void RemoteIOHttps::loop()
+{
+  switch (state)
+  {
+    case HTTPS_CONNECT:
+      connect();
+      break;
+
+    case HTTPS_SEND:
+      send();
+      break;
+
+    case HTTPS_STATUS:
+    case HTTPS_HEADERS:
+    case HTTPS_BODY:
+      receive();
+      break;
+
+    case HTTPS_DRAIN:
+      drain();
+      return;
+
+    default:
+      return;
+  }
+
+  // o limite vale para a requisição inteira, não para cada passagem
+  if ((state >= HTTPS_SEND) && (state <= HTTPS_BODY) && (millis() - startedAt >= HTTPS_TIMEOUT)) fail(HTTPC_ERROR_READ_TIMEOUT);
+}
+
+void RemoteIOHttps::connect()
+{
+  reused = client.connected();
+
+  if (!reused)
+  {
+    // o handshake do BearSSL não se divide entre passagens: fica limitado a HTTPS_CONNECT_TIMEOUT
+    handshakes++;
+    client.setTimeout(HTTPS_CONNECT_TIMEOUT);
+    bool connected = client.connect(host.c_str(), port);
+    client.setTimeout(HTTPS_READ_TIMEOUT);
+
+    if (!connected)
+    {
+      fail(HTTPC_ERROR_CONNECTION_FAILED);
+      return;
+    }
+  }
+
+  sent = 0;
+  state = HTTPS_SEND;
+}
+
+void RemoteIOHttps::send()
+{
+  // só o que cabe no buffer TCP: write() não espera o ACK do servidor
+  int space = client.availableForWrite();
+  size_t length = request.length() - sent;
+
+  if (space <= 0)
+  {
+    if (!client.connected()) fail(HTTPC_ERROR_SEND_HEADER_FAILED);
+    return;
+  }
+  if ((size_t)space < length) length = space;
+
+  size_t written = client.write((const uint8_t *)request.c_str() + sent, length);
+  if (written == 0)
+  {
+    fail((sent == 0) ? HTTPC_ERROR_SEND_HEADER_FAILED : HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+    return;
+  }
+
+  sent += written;
+  if (sent < request.length()) return;
+
+  line = "";
+  contentLength = -1;
+  chunked = false;
+  close = false;
+  type = String();
+  retry = 0;
+  state = HTTPS_STATUS;
+}
+
+void RemoteIOHttps::receive()
+{
+  // status e cabeçalhos, byte a byte; o corpo fica no socket para o parser do chamador
+  while (((state == HTTPS_STATUS) || (state == HTTPS_HEADERS)) && (client.available() > 0))
+  {
+    int c = client.read();
+
+    if (c == '\n') headerLine();
+    else if ((c != '\r') && (line.length() < HTTPS_LINE_LENGTH)) line += (char)c;
+  }
+
+  if (state == HTTPS_BODY)
+  {
+    // o parser lê o corpo com HTTPS_READ_TIMEOUT por byte: entrega a resposta quando ele começa a chegar
+    if ((status != HTTP_CODE_OK) || response.finished() || (response.available() > 0) || (!response.bounded() && !client.connected()))
+    {
+      state = HTTPS_RESPONSE;
+    }
+    return;
+  }
+
+  if ((state != HTTPS_FAILED) && (client.available() <= 0) && !client.connected()) fail(HTTPC_ERROR_CONNECTION_LOST);
+}
+
+void RemoteIOHttps::headerLine()
+{
+  if (state == HTTPS_STATUS)
+  {
+    if (line.length() == 0) return;
+
+    status = (line.startsWith("HTTP/1.") && (line.length() >= 12)) ? atoi(line.c_str() + 9) : 0;
+    if (status <= 0)
+    {
+      fail(HTTPC_ERROR_NO_HTTP_SERVER);
+      return;
+    }
+
+    // HTTP/1.0 não mantém a conexão sem pedir
+    close = (line[7] == '0');
+    line = "";
+    state = HTTPS_HEADERS;
+    return;
+  }
+
+  if (line.length() == 0)
+  {
+    // com chunks o Content-Length não vem: o fim do corpo é o chunk de tamanho 0
+    response.begin(&client, chunked ? -1 : contentLength, chunked);
+    state = HTTPS_BODY;
+    return;
+  }
+
+  // comparados direto na linha, sem cópias: cada resposta passa por aqui várias vezes
+  const char *value;
+
+  if ((value = headerValue("Content-Length")) != nullptr) contentLength = atoi(value);
+  else if ((value = headerValue("Transfer-Encoding")) != nullptr) chunked = (strncasecmp(value, "chunked", 7) == 0);
+  else if ((value = headerValue("Connection")) != nullptr) close = close || (strstr(value, "close") != nullptr);
+  else if ((value = headerValue("Content-Type")) != nullptr) type = value;
+  else if ((value = headerValue("Retry-After")) != nullptr) retry = strtoul(value, nullptr, 10);
+  line = "";
+}
+
+// Valor do cabeçalho name na linha lida, sem os espaços iniciais; nullptr se a linha é de outro cabeçalho.
+const char *RemoteIOHttps::headerValue(const char *name)
+{
+  size_t length = strlen(name);
+
+  if ((line.length() <= length) || (line[length] != ':') || (strncasecmp(line.c_str(), name, length) != 0)) return nullptr;
+
+  const char *value = line.c_str() + length + 1;
+  while (*value == ' ') value++;
+  return value;
+}
+
+void RemoteIOHttps::fail(int error)
+{
+  client.stop();
+
+  // o servidor fechou o socket keep-alive antes de responder: repete uma vez numa conexão nova.
+  // Depois de um timeout a requisição já foi entregue, e repetir um POST duplicaria os dados
+  bool unanswered = (state == HTTPS_SEND) || ((state == HTTPS_STATUS) && (line.length() == 0));
+  if (reused && !retried && unanswered && (error != HTTPC_ERROR_READ_TIMEOUT))
+  {
+    retried = true;
+    state = HTTPS_CONNECT;
+    return;
+  }
+
+  status = error;
+  state = HTTPS_FAILED;
+}
+
+int RemoteIOHttps::result()
+{
+  if ((state == HTTPS_RESPONSE) || (state == HTTPS_FAILED)) return status;
+  return HTTPS_PENDING;
+}
+
+void RemoteIOHttps::end()
+{
+  request = String();
+
+  if ((state == HTTPS_RESPONSE) && !close)
+  {
+    state = HTTPS_DRAIN;
+    startedAt = millis();
+    drain();
+    return;
+  }
+
+  // falha, "Connection: close" ou requisição abandonada: a próxima requisição reconecta
+  client.stop();
+  response.begin(nullptr, 0);
+  state = HTTPS_IDLE;
+}
+
+void RemoteIOHttps::drain()
+{
+  // corpo não lido (ou de tamanho desconhecido) não pode ficar no socket reutilizado
+  if (response.bounded() && response.skip())
+  {
+    response.begin(nullptr, 0);
+    state = HTTPS_IDLE;
+    return;
+  }
+
+  if (!response.bounded() || !client.connected() || (millis() - startedAt >= HTTPS_DRAIN_TIMEOUT))
+  {
+    client.stop();
+    response.begin(nullptr, 0);
+    state = HTTPS_IDLE;
+  }
+}
+
+bool RemoteIOHttps::idle()
+{
+  return state == HTTPS_IDLE;
+}
+
+HttpsBody &RemoteIOHttps::body()
+{
+  return response;
+}
+
+const String &RemoteIOHttps::contentType()
+{
+  return type;
+}
+
+uint32_t RemoteIOHttps::retryAfter()
+{
+  return retry;
+}
+
+HttpsBody::HttpsBody()
+{
+  begin(nullptr, 0);
+}
+
+void HttpsBody::begin(Stream *source, int length, bool chunked)
+{
+  this->source = source;
+  this->chunked = chunked && (source != nullptr);
+  remaining = this->chunked ? 0 : length;
+  chunkState = BODY_CHUNK_SIZE;
+  emptyLine = true;
+}
+
+// Consome os cabeçalhos de chunk que já chegaram; true quando há dados do corpo a ler.
+bool HttpsBody::advance()
+{
+  if (source == nullptr) return false;
+  if (!chunked) return remaining != 0;
+
+  while ((chunkState != BODY_CHUNK_DATA) || (remaining == 0))
+  {
+    if (chunkState == BODY_CHUNK_DONE) return false;
+
+    if (chunkState == BODY_CHUNK_DATA)
+    {
+      chunkState = BODY_CHUNK_DATA_END;
+      continue;
+    }
+
+    if (source->available() <= 0) return false;
+    int c = source->read();
+
+    switch (chunkState)
+    {
+      case BODY_CHUNK_SIZE:
+      case BODY_CHUNK_EXTENSION:
+        if (c == '\n') chunkState = (remaining > 0) ? BODY_CHUNK_DATA : BODY_CHUNK_TRAILER;
+        else if (c == ';') chunkState = BODY_CHUNK_EXTENSION;
+        else if ((chunkState == BODY_CHUNK_SIZE) && isxdigit(c)) remaining = (remaining << 4) | (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+        break;
+
+      case BODY_CHUNK_DATA_END:
+        if (c == '\n') chunkState = BODY_CHUNK_SIZE;
+        break;
+
+      case BODY_CHUNK_TRAILER:
+        if (c == '\n')
+        {
+          if (emptyLine) chunkState = BODY_CHUNK_DONE;
+          emptyLine = true;
+        }
+        else if (c != '\r') emptyLine = false;
+        break;
+    }
+  }
+  return true;
+}
+
+// Descarta o que já chegou do corpo, sem esperar pelo resto; true quando o corpo terminou.
+bool HttpsBody::skip()
+{
+  while (available() > 0) read();
+  return finished();
+}
+
+bool HttpsBody::finished()
+{
+  if (source == nullptr) return true;
+  if (!chunked) return remaining == 0;
+
+  // o chunk final pode estar no socket, ainda não consumido
+  advance();
+  return chunkState == BODY_CHUNK_DONE;
+}
+
+// false quando o corpo só termina com o fechamento do socket (sem Content-Length nem chunks)
+bool HttpsBody::bounded()
+{
+  return (source == nullptr) || chunked || (remaining >= 0);
+}
+
+int HttpsBody::available()
+{
+  if (!advance()) return 0;
+
+  int length = source->available();
+  return ((remaining > 0) && (length > remaining)) ? remaining : length;
+}
+
+int HttpsBody::read()
+{
+  if (!advance()) return -1;
+
+  int c = source->read();
+  if ((c >= 0) && (remaining > 0)) remaining--;
+  return c;
+}
+
+int HttpsBody::peek()
+{
+  if (!advance()) return -1;
+  return source->peek();
+}
+
+size_t HttpsBody::write(uint8_t)
+{
+  return 0;
+}
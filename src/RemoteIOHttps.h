@@ -0,0 +1,122 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Sessão HTTPS sem bloqueio: conexão, envio e leitura da         ##
+##   resposta avançam um pouco a cada loop(), sobre um único        ##
+##   socket TLS mantido entre as requisições (keep-alive).          ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOHttps_h
+#define RemoteIOHttps_h
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include <ESP8266HTTPClient.h>    // só os códigos HTTP_CODE_* e HTTPC_ERROR_*
+
+#define HTTPS_TIMEOUT 5000          // ms, limite de cada requisição, somado entre as passagens do loop()
+#define HTTPS_CONNECT_TIMEOUT 2000  // ms, limite do connect com handshake TLS, a única etapa bloqueante
+#define HTTPS_READ_TIMEOUT 20       // ms que o parser espera por um byte do corpo que ainda não chegou
+#define HTTPS_DRAIN_TIMEOUT 500     // ms para descartar o restante do corpo antes de reutilizar a conexão
+#define HTTPS_LINE_LENGTH 128       // caracteres guardados por linha de cabeçalho; o resto é ignorado
+#define TLS_FRAGMENT_LENGTH 1024    // fragmento TLS pedido ao servidor (MFLN); define os buffers do BearSSL
+#define TLS_RX_BUFFER_FULL 16709    // buffer de recepção exigido quando o servidor não aceita MFLN
+
+#define HTTPS_PENDING 0             // result(): requisição em andamento
+
+#define HTTPS_IDLE 0
+#define HTTPS_CONNECT 1             // abre o socket (ou reaproveita o keep-alive)
+#define HTTPS_SEND 2                // envia a requisição no ritmo do buffer TCP
+#define HTTPS_STATUS 3              // aguarda a linha de status
+#define HTTPS_HEADERS 4
+#define HTTPS_BODY 5                // aguarda os primeiros bytes do corpo
+#define HTTPS_RESPONSE 6            // resposta pronta para o chamador
+#define HTTPS_FAILED 7
+#define HTTPS_DRAIN 8               // descarta o corpo não lido
+
+// leitura de corpos em Transfer-Encoding: chunked
+#define BODY_CHUNK_SIZE 0            // tamanho em hexadecimal
+#define BODY_CHUNK_EXTENSION 1       // extensões após ';', ignoradas
+#define BODY_CHUNK_DATA 2
+#define BODY_CHUNK_DATA_END 3        // CRLF após os dados
+#define BODY_CHUNK_TRAILER 4         // cabeçalhos após o chunk final, até a linha vazia
+#define BODY_CHUNK_DONE 5
+
+// Corpo da resposta HTTP/1.1, lido direto do socket: limitado pelo Content-Length, ou
+// com os cabeçalhos de Transfer-Encoding: chunked removidos.
+class HttpsBody : public Stream
+{
+  public:
+    HttpsBody();
+    void begin(Stream *source, int length, bool chunked = false);
+    bool skip();
+    bool finished();
+    bool bounded();
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t data) override;
+
+  private:
+    bool advance();
+
+    Stream *source;
+    int remaining;        // bytes do corpo (ou do chunk atual) ainda no socket, -1 se o tamanho é desconhecido
+    bool chunked;
+    uint8_t chunkState;   // BODY_CHUNK_*
+    bool emptyLine;       // nos trailers: a linha atual ainda não tem caracteres
+};
+
+// Uma requisição por vez. start() só monta a requisição; loop() avança uma etapa por
+// chamada e result() fica em HTTPS_PENDING até a resposta (ou a falha) chegar. Depois de
+// ler o corpo, o chamador libera a sessão com end().
+class RemoteIOHttps
+{
+  public:
+    RemoteIOHttps();
+    bool sizeBuffers(const String &url);
+    bool start(const char *method, const String &url, const String &headers, const uint8_t *payload, size_t length);
+    void loop();
+    int result();
+    void end();
+    bool idle();
+    HttpsBody &body();
+    const String &contentType();
+    uint32_t retryAfter();
+
+    uint32_t handshakes;      // conexões abertas, inclusive as que retomaram a sessão TLS
+
+  private:
+    bool parseUrl(const String &url, String &host, uint16_t &port, String &path);
+    void connect();
+    void send();
+    void receive();
+    void headerLine();
+    const char *headerValue(const char *name);
+    void fail(int error);
+    void drain();
+
+    WiFiClientSecure client;
+    BearSSL::Session session;
+    HttpsBody response;
+
+    uint8_t state;              // HTTPS_*
+    int status;                 // código HTTP ou HTTPC_ERROR_*
+    String host;                // servidor do socket aberto
+    uint16_t port;
+    String request;             // linha, cabeçalhos e corpo da requisição em andamento
+    size_t sent;
+    bool reused;                // enviada num socket keep-alive, que o servidor pode ter fechado
+    bool retried;
+    unsigned long startedAt;
+    String line;                // linha de cabeçalho em leitura
+    int contentLength;
+    bool chunked;
+    bool close;                 // o servidor fecha o socket depois desta resposta
+    String type;                // Content-Type da resposta
+    uint32_t retry;             // s, Retry-After da resposta
+};
+
+#endif
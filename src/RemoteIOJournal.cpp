@@ -0,0 +1,308 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Diário de amostras em flash: guarda as leituras feitas sem     ##
+##   conexão e as devolve, em ordem, para reenvio à plataforma.     ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOJournal.h"
+
+RemoteIOJournal::RemoteIOJournal()
+{
+  fs = nullptr;
+  hasSegments = false;
+  firstSequence = 0;
+  lastSequence = 0;
+  lastSize = 0;
+  readOffset = 0;
+  pendingSequence = 0;
+  pendingOffset = 0;
+  pendingSegmentSize = 0;
+  pendingCount = 0;
+  bootSequence = 0;
+  bootOffset = 0;
+
+  appended = 0;
+  replayed = 0;
+  droppedSegments = 0;
+  recoveredBytes = 0;
+}
+
+void RemoteIOJournal::begin(FS &fileSystem)
+{
+  fs = &fileSystem;
+  hasSegments = false;
+
+  // segmentos são nomeados por uma sequência crescente, então arquivos novos
+  // não reaproveitam o nome (nem os blocos) de segmentos recém-apagados
+  Dir dir = fs->openDir(JOURNAL_DIR);
+  while (dir.next())
+  {
+    String name = dir.fileName();
+    name = name.substring(name.lastIndexOf('/') + 1);
+
+    if (name == "cursor") continue;
+
+    uint32_t sequence = strtoul(name.c_str(), NULL, 16);
+
+    if (!hasSegments || (sequence < firstSequence)) firstSequence = sequence;
+    if (!hasSegments || (sequence > lastSequence)) lastSequence = sequence;
+    hasSegments = true;
+  }
+
+  if (!hasSegments)
+  {
+    bootSequence = lastSequence + 1;
+    bootOffset = 0;
+    return;
+  }
+
+  // uma queda de energia durante a gravação pode deixar um registro incompleto no fim do segmento atual
+  File file = fs->open(segmentPath(lastSequence), "r+");
+  if (file)
+  {
+    lastSize = validLength(file);
+    if (lastSize < file.size())
+    {
+      recoveredBytes += file.size() - lastSize;
+      file.truncate(lastSize);
+    }
+    file.close();
+  }
+
+  // o que vier depois desta posição foi gravado neste boot
+  bootSequence = lastSequence;
+  bootOffset = lastSize;
+
+  readOffset = 0;
+  File cursor = fs->open(JOURNAL_CURSOR_FILE, "r");
+  if (cursor)
+  {
+    uint32_t position[2];
+    if ((cursor.read((uint8_t *)position, sizeof(position)) == sizeof(position)) && (position[0] == firstSequence))
+    {
+      readOffset = position[1];
+    }
+    cursor.close();
+  }
+}
+
+bool RemoteIOJournal::append(const char *ref, const char *value, uint32_t timestamp, const char *extra)
+{
+  if (fs == nullptr) return false;
+
+  size_t refLength = strlen(ref);
+  size_t valueLength = strlen(value);
+  size_t extraLength = strlen(extra);
+
+  if ((refLength >= JOURNAL_REF_LENGTH) || (valueLength >= JOURNAL_VALUE_LENGTH) || (extraLength >= JOURNAL_EXTRA_LENGTH)) return false;
+
+  // sem texto extra, o registro mantém o formato original
+  uint8_t record[9 + JOURNAL_REF_LENGTH + JOURNAL_VALUE_LENGTH + JOURNAL_EXTRA_LENGTH];
+  size_t headerLength = (extraLength > 0) ? 9 : 8;
+  size_t recordLength = headerLength + refLength + valueLength + extraLength;
+
+  record[0] = (extraLength > 0) ? JOURNAL_EXTRA_MAGIC : JOURNAL_RECORD_MAGIC;
+  record[1] = refLength;
+  record[2] = valueLength;
+  memcpy(&record[4], &timestamp, 4);
+  record[8] = extraLength;
+  memcpy(&record[headerLength], ref, refLength);
+  memcpy(&record[headerLength + refLength], value, valueLength);
+  memcpy(&record[headerLength + refLength + valueLength], extra, extraLength);
+  record[3] = crc8(&record[4], recordLength - 4, 0);
+
+  if (!hasSegments)
+  {
+    lastSequence++;
+    firstSequence = lastSequence;
+    lastSize = 0;
+    readOffset = 0;
+    hasSegments = true;
+  }
+  else if (lastSize + recordLength > JOURNAL_SEGMENT_SIZE)
+  {
+    lastSequence++;
+    lastSize = 0;
+
+    if (lastSequence - firstSequence >= JOURNAL_MAX_SEGMENTS) dropOldestSegment();
+  }
+
+  File file = fs->open(segmentPath(lastSequence), "a");
+  if (!file) return false;
+
+  size_t written = file.write(record, recordLength);
+  file.close();
+
+  if (written != recordLength) return false;
+
+  lastSize += recordLength;
+  appended++;
+
+  // gravado no segmento em leitura, com um reenvio em andamento: o commit() não pode apagá-lo
+  if (lastSequence == firstSequence) pendingSegmentSize = lastSize;
+  return true;
+}
+
+uint8_t RemoteIOJournal::read(JournalRecord *records, uint8_t maxRecords)
+{
+  uint8_t count = 0;
+
+  while (!empty() && (count == 0))
+  {
+    pendingSequence = firstSequence;
+    File file = fs->open(segmentPath(firstSequence), "r");
+
+    if (!file)
+    {
+      // segmento ausente: considera consumido
+      pendingOffset = 0;
+      pendingSegmentSize = 0;
+      pendingCount = 0;
+      commit();
+      continue;
+    }
+
+    pendingSegmentSize = file.size();
+    file.seek(readOffset);
+
+    while (count < maxRecords)
+    {
+      if (file.position() >= pendingSegmentSize) break;
+
+      records[count].currentBoot = (firstSequence > bootSequence) ||
+                                   ((firstSequence == bootSequence) && (file.position() >= bootOffset));
+
+      if (!readRecord(file, records[count]))
+      {
+        // registro corrompido fora do segmento atual: o restante do segmento é descartado
+        file.seek(pendingSegmentSize);
+        break;
+      }
+      count++;
+    }
+
+    pendingOffset = file.position();
+    pendingCount = count;
+    file.close();
+
+    if (count == 0) commit();
+  }
+  return count;
+}
+
+void RemoteIOJournal::commit()
+{
+  // o segmento lido foi descartado por falta de espaço durante o reenvio: não há o que confirmar
+  if (pendingSequence != firstSequence)
+  {
+    pendingCount = 0;
+    return;
+  }
+
+  replayed += pendingCount;
+  pendingCount = 0;
+  readOffset = pendingOffset;
+
+  if (readOffset >= pendingSegmentSize)
+  {
+    fs->remove(segmentPath(firstSequence));
+
+    if (firstSequence == lastSequence)
+    {
+      hasSegments = false;
+      lastSize = 0;
+      fs->remove(JOURNAL_CURSOR_FILE);
+      return;
+    }
+
+    firstSequence++;
+    readOffset = 0;
+  }
+
+  saveCursor();
+}
+
+bool RemoteIOJournal::empty()
+{
+  if (!hasSegments) return true;
+  return (firstSequence == lastSequence) && (readOffset >= lastSize);
+}
+
+String RemoteIOJournal::segmentPath(uint32_t sequence)
+{
+  char path[24];
+  snprintf(path, sizeof(path), JOURNAL_DIR "/%08lx", (unsigned long)sequence);
+  return String(path);
+}
+
+bool RemoteIOJournal::readRecord(File &file, JournalRecord &record)
+{
+  uint8_t header[9];
+
+  if (file.read(header, 8) != 8) return false;
+  if (((header[0] != JOURNAL_RECORD_MAGIC) && (header[0] != JOURNAL_EXTRA_MAGIC)) || (header[1] >= JOURNAL_REF_LENGTH) || (header[2] >= JOURNAL_VALUE_LENGTH)) return false;
+
+  header[8] = 0;
+  size_t headerLength = (header[0] == JOURNAL_EXTRA_MAGIC) ? 9 : 8;
+  if ((headerLength == 9) && ((file.read(&header[8], 1) != 1) || (header[8] >= JOURNAL_EXTRA_LENGTH))) return false;
+
+  if (file.read((uint8_t *)record.ref, header[1]) != header[1]) return false;
+  if (file.read((uint8_t *)record.value, header[2]) != header[2]) return false;
+  if (file.read((uint8_t *)record.extra, header[8]) != header[8]) return false;
+
+  uint8_t crc = crc8(&header[4], headerLength - 4, 0);
+  crc = crc8((uint8_t *)record.ref, header[1], crc);
+  crc = crc8((uint8_t *)record.value, header[2], crc);
+  crc = crc8((uint8_t *)record.extra, header[8], crc);
+  if (crc != header[3]) return false;
+
+  memcpy(&record.timestamp, &header[4], 4);
+  record.ref[header[1]] = '\0';
+  record.value[header[2]] = '\0';
+  record.extra[header[8]] = '\0';
+  return true;
+}
+
+uint32_t RemoteIOJournal::validLength(File &file)
+{
+  JournalRecord record;
+  uint32_t length = 0;
+
+  file.seek(0);
+  while (readRecord(file, record)) length = file.position();
+  return length;
+}
+
+void RemoteIOJournal::dropOldestSegment()
+{
+  fs->remove(segmentPath(firstSequence));
+  firstSequence++;
+  readOffset = 0;
+  droppedSegments++;
+  saveCursor();
+}
+
+void RemoteIOJournal::saveCursor()
+{
+  uint32_t position[2] = { firstSequence, readOffset };
+
+  File cursor = fs->open(JOURNAL_CURSOR_FILE, "w");
+  if (!cursor) return;
+  cursor.write((uint8_t *)position, sizeof(position));
+  cursor.close();
+}
+
+uint8_t RemoteIOJournal::crc8(const uint8_t *data, size_t length, uint8_t crc)
+{
+  // CRC-8, polinômio 0x07
+  while (length--)
+  {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+  }
+  return crc;
+}
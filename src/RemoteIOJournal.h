@@ -0,0 +1,77 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Diário de amostras em flash: guarda as leituras feitas sem     ##
+##   conexão e as devolve, em ordem, para reenvio à plataforma.     ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOJournal_h
+#define RemoteIOJournal_h
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define JOURNAL_DIR "/journal"
+#define JOURNAL_CURSOR_FILE "/journal/cursor"
+#define JOURNAL_SEGMENT_SIZE 4096     // bytes por segmento
+#define JOURNAL_MAX_SEGMENTS 16       // limite do diário: 64 KB
+#define JOURNAL_REF_LENGTH 32
+#define JOURNAL_VALUE_LENGTH 24
+#define JOURNAL_EXTRA_LENGTH 112      // texto extra de um registro, como o resumo do modo aggregate
+#define JOURNAL_RECORD_MAGIC 0xA5
+#define JOURNAL_EXTRA_MAGIC 0xA6      // registro com texto extra
+
+// Registro binário: magic, tamanho da ref, tamanho do valor, crc8,
+// timestamp (uint32, little-endian), ref e valor sem terminador. Com
+// JOURNAL_EXTRA_MAGIC, o timestamp é seguido pelo tamanho do texto extra,
+// que vem depois do valor.
+struct JournalRecord
+{
+  uint32_t timestamp;
+  char ref[JOURNAL_REF_LENGTH];
+  char value[JOURNAL_VALUE_LENGTH];
+  char extra[JOURNAL_EXTRA_LENGTH];   // vazio nos registros sem texto extra
+  bool currentBoot;             // gravado depois do último begin()
+};
+
+class RemoteIOJournal
+{
+  public:
+    RemoteIOJournal();
+    void begin(FS &fileSystem);
+    bool append(const char *ref, const char *value, uint32_t timestamp, const char *extra = "");
+    uint8_t read(JournalRecord *records, uint8_t maxRecords);
+    void commit();
+    bool empty();
+
+    uint32_t appended;          // registros gravados desde o boot
+    uint32_t replayed;          // registros confirmados (reenviados)
+    uint32_t droppedSegments;   // segmentos descartados por falta de espaço
+    uint32_t recoveredBytes;    // bytes truncados na recuperação após queda de energia
+
+  private:
+    String segmentPath(uint32_t sequence);
+    bool readRecord(File &file, JournalRecord &record);
+    uint32_t validLength(File &file);
+    void dropOldestSegment();
+    void saveCursor();
+    uint8_t crc8(const uint8_t *data, size_t length, uint8_t crc);
+
+    FS *fs;
+    bool hasSegments;
+    uint32_t firstSequence;     // segmento mais antigo, de onde se lê
+    uint32_t lastSequence;      // segmento atual, onde se grava
+    uint32_t lastSize;
+    uint32_t readOffset;        // posição confirmada no segmento mais antigo
+    uint32_t pendingSequence;   // segmento da última leitura ainda não confirmada
+    uint32_t pendingOffset;     // posição após a última leitura ainda não confirmada
+    uint32_t pendingSegmentSize;
+    uint8_t pendingCount;
+    uint32_t bootSequence;      // posição do primeiro registro gravado neste boot
+    uint32_t bootOffset;
+};
+
+#endif
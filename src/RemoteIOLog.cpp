@@ -0,0 +1,87 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Log em níveis: mensagens vão para um buffer circular em RAM    ##
+##   e são enviadas à serial sem bloquear o loop().                 ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOLog.h"
+
+RemoteIOLog remoteIOLog;
+
+RemoteIOLog::RemoteIOLog()
+{
+  head = 0;
+  serialTail = 0;
+  dropped = 0;
+}
+
+void RemoteIOLog::write(char level, PGM_P format, ...)
+{
+  char line[LOG_LINE_LENGTH];
+  int length = snprintf(line, sizeof(line), "%lu %c ", (unsigned long)millis(), level);
+
+  va_list args;
+  va_start(args, format);
+  int message = vsnprintf_P(line + length, sizeof(line) - length - 1, format, args);
+  va_end(args);
+
+  if (message < 0) return;
+
+  length += message;
+  if (length > (int)sizeof(line) - 2) length = sizeof(line) - 2;
+  line[length++] = '\n';
+
+  put(line, length);
+}
+
+void RemoteIOLog::put(const char *text, size_t length)
+{
+  for (size_t i = 0; i < length; i++) buffer[(head + i) % LOG_BUFFER_SIZE] = text[i];
+  head += length;
+
+  // a serial ficou para trás: o trecho sobrescrito é perdido para ela, mas não para /log
+  if (head - serialTail > LOG_BUFFER_SIZE)
+  {
+    dropped += (head - LOG_BUFFER_SIZE) - serialTail;
+    serialTail = head - LOG_BUFFER_SIZE;
+  }
+}
+
+void RemoteIOLog::drain(HardwareSerial &serial)
+{
+  // envia só o que cabe no FIFO da UART: nunca espera a transmissão
+  size_t room = serial.availableForWrite();
+
+  while ((room > 0) && (serialTail != head))
+  {
+    size_t offset = serialTail % LOG_BUFFER_SIZE;
+    size_t chunk = head - serialTail;
+
+    if (chunk > LOG_BUFFER_SIZE - offset) chunk = LOG_BUFFER_SIZE - offset;
+    if (chunk > room) chunk = room;
+
+    serial.write((const uint8_t *)&buffer[offset], chunk);
+    serialTail += chunk;
+    room -= chunk;
+  }
+}
+
+void RemoteIOLog::print(Print &out)
+{
+  uint32_t position = (head > LOG_BUFFER_SIZE) ? head - LOG_BUFFER_SIZE : 0;
+
+  while (position != head)
+  {
+    size_t offset = position % LOG_BUFFER_SIZE;
+    size_t chunk = head - position;
+
+    if (chunk > LOG_BUFFER_SIZE - offset) chunk = LOG_BUFFER_SIZE - offset;
+
+    out.write((const uint8_t *)&buffer[offset], chunk);
+    position += chunk;
+  }
+}
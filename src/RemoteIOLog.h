@@ -0,0 +1,75 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Log em níveis: mensagens vão para um buffer circular em RAM    ##
+##   e são enviadas à serial sem bloquear o loop().                 ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOLog_h
+#define RemoteIOLog_h
+
+#include <Arduino.h>
+
+#define REMOTEIO_LOG_NONE 0
+#define REMOTEIO_LOG_ERROR 1
+#define REMOTEIO_LOG_WARN 2
+#define REMOTEIO_LOG_INFO 3
+#define REMOTEIO_LOG_DEBUG 4
+
+// nível definido em compilação (build_flags = -DREMOTEIO_LOG_LEVEL=n); mensagens
+// acima dele não geram código, nem avaliam seus argumentos
+#ifndef REMOTEIO_LOG_LEVEL
+#define REMOTEIO_LOG_LEVEL REMOTEIO_LOG_INFO
+#endif
+
+#define LOG_BUFFER_SIZE 2048    // bytes do buffer circular
+#define LOG_LINE_LENGTH 160     // mensagens maiores são truncadas
+
+#if REMOTEIO_LOG_LEVEL >= REMOTEIO_LOG_ERROR
+#define REMOTEIO_LOGE(format, ...) remoteIOLog.write('E', PSTR(format), ##__VA_ARGS__)
+#else
+#define REMOTEIO_LOGE(format, ...) do {} while (0)
+#endif
+
+#if REMOTEIO_LOG_LEVEL >= REMOTEIO_LOG_WARN
+#define REMOTEIO_LOGW(format, ...) remoteIOLog.write('W', PSTR(format), ##__VA_ARGS__)
+#else
+#define REMOTEIO_LOGW(format, ...) do {} while (0)
+#endif
+
+#if REMOTEIO_LOG_LEVEL >= REMOTEIO_LOG_INFO
+#define REMOTEIO_LOGI(format, ...) remoteIOLog.write('I', PSTR(format), ##__VA_ARGS__)
+#else
+#define REMOTEIO_LOGI(format, ...) do {} while (0)
+#endif
+
+#if REMOTEIO_LOG_LEVEL >= REMOTEIO_LOG_DEBUG
+#define REMOTEIO_LOGD(format, ...) remoteIOLog.write('D', PSTR(format), ##__VA_ARGS__)
+#else
+#define REMOTEIO_LOGD(format, ...) do {} while (0)
+#endif
+
+class RemoteIOLog
+{
+  public:
+    RemoteIOLog();
+    void write(char level, PGM_P format, ...) __attribute__((format(printf, 3, 4)));
+    void drain(HardwareSerial &serial);
+    void print(Print &out);
+
+    uint32_t dropped;     // bytes sobrescritos antes de chegarem à serial
+
+  private:
+    void put(const char *text, size_t length);
+
+    char buffer[LOG_BUFFER_SIZE];
+    uint32_t head;        // total de bytes escritos desde o boot
+    uint32_t serialTail;  // total de bytes já enviados à serial
+};
+
+extern RemoteIOLog remoteIOLog;
+
+#endif
@@ -0,0 +1,253 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Métricas de execução: tempos do loop, do websocket e das       ##
+##   requisições HTTPS, estados da conexão e uso de memória.        ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOMetrics.h"
+
+namespace
+{
+  // limites superiores das faixas, em microssegundos
+  const uint32_t BUCKET_LIMITS[METRICS_BUCKETS] = { 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000 };
+
+  // na mesma ordem dos valores de connection_state
+  const char *const STATE_NAMES[METRICS_STATES] = { "INICIALIZATION", "CONNECTED", "NO_WIFI", "DISCONNECTED" };
+
+  const char *const STATUS_CLASSES[5] = { "2xx", "3xx", "4xx", "5xx", "error" };
+
+  const int CONNECTED_STATE = 1;
+}
+
+RemoteIOMetrics::RemoteIOMetrics()
+{
+  memset(&loopTime, 0, sizeof(loopTime));
+  memset(&socketLoopTime, 0, sizeof(socketLoopTime));
+  memset(&httpsTime, 0, sizeof(httpsTime));
+  memset(httpsStatus, 0, sizeof(httpsStatus));
+  memset(stateEntries, 0, sizeof(stateEntries));
+  memset(stateDwell, 0, sizeof(stateDwell));
+
+  lastStatus = 0;
+  currentState = 0;
+  stateEntries[0] = 1;
+  stateTimestamp = 0;
+  connectedOnce = false;
+  reconnects = 0;
+  minFreeHeap = UINT32_MAX;
+  heapFloorBreaches = 0;
+  belowHeapFloor = false;
+  arena = nullptr;
+  memoryCount = 0;
+}
+
+void RemoteIOMetrics::recordLoop(uint32_t duration)
+{
+  record(loopTime, duration);
+}
+
+void RemoteIOMetrics::recordSocketLoop(uint32_t duration)
+{
+  record(socketLoopTime, duration);
+}
+
+void RemoteIOMetrics::recordHttps(uint32_t duration, int statusCode)
+{
+  record(httpsTime, duration);
+
+  lastStatus = statusCode;
+  if ((statusCode >= 200) && (statusCode < 600)) httpsStatus[(statusCode / 100) - 2]++;
+  else httpsStatus[4]++;
+}
+
+void RemoteIOMetrics::recordState(int state)
+{
+  if ((state == currentState) || (state < 0) || (state >= METRICS_STATES)) return;
+
+  uint32_t now = millis();
+
+  stateDwell[currentState] += now - stateTimestamp;
+  stateEntries[state]++;
+  currentState = state;
+  stateTimestamp = now;
+
+  if (state == CONNECTED_STATE)
+  {
+    if (connectedOnce) reconnects++;
+    connectedOnce = true;
+  }
+}
+
+// true quando o heap livre acaba de cair abaixo de METRICS_HEAP_FLOOR
+bool RemoteIOMetrics::sampleHeap()
+{
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < minFreeHeap) minFreeHeap = freeHeap;
+
+  bool breach = (freeHeap < METRICS_HEAP_FLOOR) && !belowHeapFloor;
+  belowHeapFloor = (freeHeap < METRICS_HEAP_FLOOR);
+  if (breach) heapFloorBreaches++;
+  return breach;
+}
+
+void RemoteIOMetrics::setArena(RemoteIOArena *jsonArena)
+{
+  arena = jsonArena;
+}
+
+void RemoteIOMetrics::addMemory(const char *name, uint32_t bytes)
+{
+  if (memoryCount >= METRICS_MEMORY_ENTRIES) return;
+
+  memory[memoryCount].name = name;
+  memory[memoryCount].bytes = bytes;
+  memoryCount++;
+}
+
+uint8_t RemoteIOMetrics::memoryEntries()
+{
+  return memoryCount;
+}
+
+const MetricsMemoryEntry &RemoteIOMetrics::memoryEntry(uint8_t index)
+{
+  return memory[index];
+}
+
+void RemoteIOMetrics::record(MetricsHistogram &histogram, uint32_t duration)
+{
+  uint8_t bucket = 0;
+  while ((bucket < METRICS_BUCKETS) && (duration > BUCKET_LIMITS[bucket])) bucket++;
+
+  histogram.buckets[bucket]++;
+  histogram.count++;
+  histogram.sum += duration;
+  if (duration > histogram.max) histogram.max = duration;
+}
+
+uint32_t RemoteIOMetrics::dwellTime(int state)
+{
+  uint64_t dwell = stateDwell[state];
+  if (state == currentState) dwell += millis() - stateTimestamp;
+  return (uint32_t)dwell;
+}
+
+void RemoteIOMetrics::printHistogram(Print &out, const char *name, const MetricsHistogram &histogram)
+{
+  uint32_t cumulative = 0;
+
+  out.printf("# TYPE remoteio_%s_microseconds histogram\n", name);
+  for (uint8_t i = 0; i < METRICS_BUCKETS; i++)
+  {
+    cumulative += histogram.buckets[i];
+    out.printf("remoteio_%s_microseconds_bucket{le=\"%lu\"} %lu\n", name, (unsigned long)BUCKET_LIMITS[i], (unsigned long)cumulative);
+  }
+  out.printf("remoteio_%s_microseconds_bucket{le=\"+Inf\"} %lu\n", name, (unsigned long)histogram.count);
+  out.printf("remoteio_%s_microseconds_sum %llu\n", name, (unsigned long long)histogram.sum);
+  out.printf("remoteio_%s_microseconds_count %lu\n", name, (unsigned long)histogram.count);
+  out.printf("remoteio_%s_microseconds_max %lu\n", name, (unsigned long)histogram.max);
+}
+
+void RemoteIOMetrics::printPrometheus(Print &out)
+{
+  out.printf("# TYPE remoteio_uptime_milliseconds counter\nremoteio_uptime_milliseconds %lu\n", (unsigned long)millis());
+
+  printHistogram(out, "loop", loopTime);
+  printHistogram(out, "socketio_loop", socketLoopTime);
+  printHistogram(out, "https_request", httpsTime);
+
+  out.print("# TYPE remoteio_https_responses_total counter\n");
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    out.printf("remoteio_https_responses_total{class=\"%s\"} %lu\n", STATUS_CLASSES[i], (unsigned long)httpsStatus[i]);
+  }
+  out.printf("# TYPE remoteio_https_last_status gauge\nremoteio_https_last_status %d\n", lastStatus);
+
+  out.print("# TYPE remoteio_state_entries_total counter\n");
+  for (uint8_t i = 0; i < METRICS_STATES; i++)
+  {
+    out.printf("remoteio_state_entries_total{state=\"%s\"} %lu\n", STATE_NAMES[i], (unsigned long)stateEntries[i]);
+  }
+  out.print("# TYPE remoteio_state_dwell_milliseconds counter\n");
+  for (uint8_t i = 0; i < METRICS_STATES; i++)
+  {
+    out.printf("remoteio_state_dwell_milliseconds{state=\"%s\"} %lu\n", STATE_NAMES[i], (unsigned long)dwellTime(i));
+  }
+  out.print("# TYPE remoteio_state gauge\n");
+  for (uint8_t i = 0; i < METRICS_STATES; i++)
+  {
+    out.printf("remoteio_state{state=\"%s\"} %d\n", STATE_NAMES[i], (i == currentState) ? 1 : 0);
+  }
+  out.printf("# TYPE remoteio_reconnects_total counter\nremoteio_reconnects_total %lu\n", (unsigned long)reconnects);
+
+  out.printf("# TYPE remoteio_heap_free_bytes gauge\nremoteio_heap_free_bytes %lu\n", (unsigned long)ESP.getFreeHeap());
+  out.printf("# TYPE remoteio_heap_min_free_bytes gauge\nremoteio_heap_min_free_bytes %lu\n", (unsigned long)minFreeHeap);
+  out.printf("# TYPE remoteio_heap_max_block_bytes gauge\nremoteio_heap_max_block_bytes %lu\n", (unsigned long)ESP.getMaxFreeBlockSize());
+  out.printf("# TYPE remoteio_heap_fragmentation_percent gauge\nremoteio_heap_fragmentation_percent %u\n", (unsigned)ESP.getHeapFragmentation());
+  out.printf("# TYPE remoteio_heap_floor_breaches_total counter\nremoteio_heap_floor_breaches_total %lu\n", (unsigned long)heapFloorBreaches);
+
+  // o core preenche a pilha do loop com um padrão no boot: o espaço nunca tocado é a marca d'água
+  out.printf("# TYPE remoteio_stack_min_free_bytes gauge\nremoteio_stack_min_free_bytes %lu\n", (unsigned long)ESP.getFreeContStack());
+
+  if (memoryCount > 0) out.print("# TYPE remoteio_static_bytes gauge\n");
+  for (uint8_t i = 0; i < memoryCount; i++)
+  {
+    out.printf("remoteio_static_bytes{buffer=\"%s\"} %lu\n", memory[i].name, (unsigned long)memory[i].bytes);
+  }
+
+  if (arena == nullptr) return;
+  out.printf("# TYPE remoteio_json_arena_bytes gauge\nremoteio_json_arena_bytes %u\n", (unsigned)JSON_ARENA_SIZE);
+  out.printf("# TYPE remoteio_json_arena_peak_bytes gauge\nremoteio_json_arena_peak_bytes %u\n", (unsigned)arena->peak);
+  out.printf("# TYPE remoteio_json_arena_fallbacks_total counter\nremoteio_json_arena_fallbacks_total %lu\n", (unsigned long)arena->fallbacks);
+}
+
+void RemoteIOMetrics::printHistogramJson(Print &out, const MetricsHistogram &histogram)
+{
+  out.printf("{\"count\":%lu,\"sum\":%llu,\"max\":%lu,\"buckets\":[", (unsigned long)histogram.count, (unsigned long long)histogram.sum, (unsigned long)histogram.max);
+  for (uint8_t i = 0; i <= METRICS_BUCKETS; i++)
+  {
+    out.printf(i ? ",%lu" : "%lu", (unsigned long)histogram.buckets[i]);
+  }
+  out.print("]}");
+}
+
+void RemoteIOMetrics::printJson(Print &out)
+{
+  out.printf("{\"uptime\":%lu,\"loop\":", (unsigned long)millis());
+  printHistogramJson(out, loopTime);
+  out.print(",\"socketLoop\":");
+  printHistogramJson(out, socketLoopTime);
+  out.print(",\"https\":{\"latency\":");
+  printHistogramJson(out, httpsTime);
+  out.print(",\"status\":{");
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    out.printf("%s\"%s\":%lu", i ? "," : "", STATUS_CLASSES[i], (unsigned long)httpsStatus[i]);
+  }
+  out.printf("},\"last\":%d},\"state\":\"%s\",\"states\":{", lastStatus, STATE_NAMES[currentState]);
+  for (uint8_t i = 0; i < METRICS_STATES; i++)
+  {
+    out.printf("%s\"%s\":{\"entries\":%lu,\"dwell\":%lu}", i ? "," : "", STATE_NAMES[i], (unsigned long)stateEntries[i], (unsigned long)dwellTime(i));
+  }
+  out.printf("},\"reconnects\":%lu,\"heap\":{\"free\":%lu,\"minFree\":%lu,\"maxBlock\":%lu,\"fragmentation\":%u,\"floorBreaches\":%lu},\"stack\":{\"minFree\":%lu}",
+             (unsigned long)reconnects, (unsigned long)ESP.getFreeHeap(), (unsigned long)minFreeHeap,
+             (unsigned long)ESP.getMaxFreeBlockSize(), (unsigned)ESP.getHeapFragmentation(), (unsigned long)heapFloorBreaches,
+             (unsigned long)ESP.getFreeContStack());
+
+  out.print(",\"memory\":{");
+  for (uint8_t i = 0; i < memoryCount; i++)
+  {
+    out.printf("%s\"%s\":%lu", i ? "," : "", memory[i].name, (unsigned long)memory[i].bytes);
+  }
+  out.print("}");
+
+  if (arena != nullptr)
+  {
+    out.printf(",\"arena\":{\"size\":%u,\"peak\":%u,\"fallbacks\":%lu}", (unsigned)JSON_ARENA_SIZE, (unsigned)arena->peak, (unsigned long)arena->fallbacks);
+  }
+  out.print("}");
+}
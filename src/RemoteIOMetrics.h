@@ -0,0 +1,83 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Métricas de execução: tempos do loop, do websocket e das       ##
+##   requisições HTTPS, estados da conexão e uso de memória.        ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOMetrics_h
+#define RemoteIOMetrics_h
+
+#include <Arduino.h>
+#include "RemoteIOArena.h"
+
+#define METRICS_BUCKETS 10    // faixas dos histogramas, além da faixa +Inf
+#define METRICS_STATES 4      // estados de connection_state (INICIALIZATION a DISCONNECTED)
+#define METRICS_HEAP_FLOOR 8192   // bytes; heap livre abaixo disso estoura o orçamento de memória
+#define METRICS_MEMORY_ENTRIES 16 // membros e buffers do relatório de RAM estática
+
+// Histograma de durações em microssegundos, com faixas fixas.
+struct MetricsHistogram
+{
+  uint32_t buckets[METRICS_BUCKETS + 1];
+  uint32_t count;
+  uint64_t sum;
+  uint32_t max;
+};
+
+// Parte da RAM estática do RemoteIO, medida com sizeof no construtor.
+struct MetricsMemoryEntry
+{
+  const char *name;
+  uint32_t bytes;
+};
+
+class RemoteIOMetrics
+{
+  public:
+    RemoteIOMetrics();
+    void recordLoop(uint32_t duration);
+    void recordSocketLoop(uint32_t duration);
+    void recordHttps(uint32_t duration, int statusCode);
+    void recordState(int state);
+    bool sampleHeap();
+    void setArena(RemoteIOArena *jsonArena);
+    void addMemory(const char *name, uint32_t bytes);
+    uint8_t memoryEntries();
+    const MetricsMemoryEntry &memoryEntry(uint8_t index);
+    void printPrometheus(Print &out);
+    void printJson(Print &out);
+
+    uint32_t reconnects;        // conexões com a plataforma após a primeira
+
+  private:
+    void record(MetricsHistogram &histogram, uint32_t duration);
+    void printHistogram(Print &out, const char *name, const MetricsHistogram &histogram);
+    void printHistogramJson(Print &out, const MetricsHistogram &histogram);
+    uint32_t dwellTime(int state);
+
+    MetricsHistogram loopTime;
+    MetricsHistogram socketLoopTime;
+    MetricsHistogram httpsTime;
+
+    uint32_t httpsStatus[5];    // 2xx, 3xx, 4xx, 5xx e erros de transporte
+    int lastStatus;
+
+    uint32_t stateEntries[METRICS_STATES];
+    uint64_t stateDwell[METRICS_STATES];  // ms acumulados em cada estado, sem a passagem atual
+    int currentState;
+    uint32_t stateTimestamp;
+    bool connectedOnce;
+
+    uint32_t minFreeHeap;
+    uint32_t heapFloorBreaches;   // vezes em que o heap livre caiu abaixo de METRICS_HEAP_FLOOR
+    bool belowHeapFloor;
+    RemoteIOArena *arena;
+    MetricsMemoryEntry memory[METRICS_MEMORY_ENTRIES];
+    uint8_t memoryCount;
+};
+
+#endif
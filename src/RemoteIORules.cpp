@@ -0,0 +1,120 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Regras locais: condições sobre entradas que acionam saídas     ##
+##   sem depender da plataforma, avaliadas a partir do loop().      ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIORules.h"
+#include <string.h>
+
+RemoteIORules::RemoteIORules()
+{
+  clear();
+  activations = 0;
+}
+
+void RemoteIORules::clear()
+{
+  count = 0;
+  cursor = 0;
+}
+
+bool RemoteIORules::add(const Rule &rule)
+{
+  if ((count >= RULES_CAPACITY) || (rule.op == RULE_INVALID)) return false;
+
+  rules[count] = rule;
+  rules[count].flags &= RULE_HAS_ELSE;
+  rules[count].since = 0;
+  count++;
+  return true;
+}
+
+uint16_t RemoteIORules::size()
+{
+  return count;
+}
+
+uint8_t RemoteIORules::opFromString(const char *op)
+{
+  if (strcmp(op, ">") == 0) return RULE_GREATER;
+  if (strcmp(op, ">=") == 0) return RULE_GREATER_EQUAL;
+  if (strcmp(op, "<") == 0) return RULE_LESS;
+  if (strcmp(op, "<=") == 0) return RULE_LESS_EQUAL;
+  if (strcmp(op, "==") == 0) return RULE_EQUAL;
+  if (strcmp(op, "!=") == 0) return RULE_NOT_EQUAL;
+  return RULE_INVALID;
+}
+
+bool RemoteIORules::condition(const Rule &rule, int32_t value)
+{
+  // com a regra ativa, o limite de desligamento é deslocado pela histerese
+  bool active = rule.flags & RULE_ACTIVE;
+
+  switch (rule.op)
+  {
+    case RULE_GREATER:        return active ? (value > rule.threshold - rule.hysteresis) : (value > rule.threshold);
+    case RULE_GREATER_EQUAL:  return active ? (value >= rule.threshold - rule.hysteresis) : (value >= rule.threshold);
+    case RULE_LESS:           return active ? (value < rule.threshold + rule.hysteresis) : (value < rule.threshold);
+    case RULE_LESS_EQUAL:     return active ? (value <= rule.threshold + rule.hysteresis) : (value <= rule.threshold);
+    case RULE_EQUAL:          return value == rule.threshold;
+    case RULE_NOT_EQUAL:      return value != rule.threshold;
+  }
+  return false;
+}
+
+uint8_t RemoteIORules::evaluate(uint32_t now, RuleReadFunction read, RuleWriteFunction write, void *context)
+{
+  uint8_t evaluated = 0;
+
+  // custo limitado por chamada: no máximo RULES_BUDGET regras, retomando de onde parou
+  while ((evaluated < RULES_BUDGET) && (evaluated < count))
+  {
+    Rule &rule = rules[cursor];
+    cursor = (cursor + 1) % count;
+    evaluated++;
+
+    // sem leitura da entrada, nem o "else" da primeira avaliação é aplicado
+    int32_t value;
+    if (!read(rule.input, value, context)) continue;
+
+    bool holds = condition(rule, value);
+    bool started = rule.flags & RULE_STARTED;
+    rule.flags |= RULE_STARTED;
+
+    if (rule.flags & RULE_ACTIVE)
+    {
+      if (holds) continue;
+
+      rule.flags &= ~(RULE_ACTIVE | RULE_PENDING);
+      if (rule.flags & RULE_HAS_ELSE) write(rule.output, rule.offValue, context);
+      continue;
+    }
+
+    if (!holds)
+    {
+      rule.flags &= ~RULE_PENDING;
+
+      // primeira avaliação: a saída assume o estado "else" desde o início
+      if (!started && (rule.flags & RULE_HAS_ELSE)) write(rule.output, rule.offValue, context);
+      continue;
+    }
+
+    if (!(rule.flags & RULE_PENDING))
+    {
+      rule.flags |= RULE_PENDING;
+      rule.since = now;
+    }
+
+    if ((uint32_t)(now - rule.since) < rule.holdTime) continue;
+
+    rule.flags = (rule.flags & ~RULE_PENDING) | RULE_ACTIVE;
+    activations++;
+    write(rule.output, rule.onValue, context);
+  }
+  return evaluated;
+}
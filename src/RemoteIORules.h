@@ -0,0 +1,76 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Regras locais: condições sobre entradas que acionam saídas     ##
+##   sem depender da plataforma, avaliadas a partir do loop().      ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIORules_h
+#define RemoteIORules_h
+
+#include <stdint.h>
+
+// 28 bytes por regra: 32 regras ocupam 896 bytes dentro do orçamento de RAM do RemoteIO;
+// o build nativo dos testes compila com -DRULES_CAPACITY=512
+#ifndef RULES_CAPACITY
+#define RULES_CAPACITY 32       // regras compiladas na tabela
+#endif
+#define RULES_BUDGET 16         // regras avaliadas por chamada de evaluate()
+
+#define RULE_GREATER 0          // ">"
+#define RULE_GREATER_EQUAL 1    // ">="
+#define RULE_LESS 2             // "<"
+#define RULE_LESS_EQUAL 3       // "<="
+#define RULE_EQUAL 4            // "=="
+#define RULE_NOT_EQUAL 5        // "!="
+#define RULE_INVALID 0xFF
+
+#define RULE_HAS_ELSE 0x01      // a regra também age quando a condição deixa de valer
+#define RULE_ACTIVE 0x02
+#define RULE_PENDING 0x04       // condição verdadeira, aguardando holdTime
+#define RULE_STARTED 0x08       // já avaliada ao menos uma vez
+
+// Regra compilada: slots da tabela de IO em vez de refs, para avaliação sem buscas.
+struct Rule
+{
+  uint8_t input;
+  uint8_t output;
+  uint8_t op;
+  uint8_t flags;
+  int32_t threshold;
+  int32_t hysteresis;     // margem para desativar; evita oscilação perto do limite
+  int32_t onValue;
+  int32_t offValue;
+  uint32_t holdTime;      // ms que a condição precisa se manter antes de ativar
+  uint32_t since;         // millis() em que a condição passou a valer
+};
+
+// false enquanto a entrada não tem leitura: a regra não é avaliada
+typedef bool (*RuleReadFunction)(uint8_t slot, int32_t &value, void *context);
+typedef void (*RuleWriteFunction)(uint8_t slot, int32_t value, void *context);
+
+class RemoteIORules
+{
+  public:
+    RemoteIORules();
+    void clear();
+    bool add(const Rule &rule);
+    uint8_t evaluate(uint32_t now, RuleReadFunction read, RuleWriteFunction write, void *context);
+    uint16_t size();
+
+    static uint8_t opFromString(const char *op);
+
+    uint32_t activations;   // transições para ativa desde o boot
+
+  private:
+    bool condition(const Rule &rule, int32_t value);
+
+    Rule rules[RULES_CAPACITY];
+    uint16_t count;
+    uint16_t cursor;        // próxima regra da varredura circular
+};
+
+#endif
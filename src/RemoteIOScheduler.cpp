@@ -0,0 +1,117 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Agenda das leituras cíclicas: min-heap de slots pelo instante  ##
+##   da próxima leitura, com a posição de cada slot no heap.        ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOScheduler.h"
+
+RemoteIOScheduler::RemoteIOScheduler()
+{
+  for (uint8_t slot = 0; slot < SCHEDULER_CAPACITY; slot++) dueTimes[slot] = 0;
+  clear();
+}
+
+void RemoteIOScheduler::clear()
+{
+  count = 0;
+  for (uint8_t slot = 0; slot < SCHEDULER_CAPACITY; slot++) position[slot] = SCHEDULER_NOT_SCHEDULED;
+}
+
+bool RemoteIOScheduler::add(uint8_t slot, uint32_t dueAt)
+{
+  if ((slot >= SCHEDULER_CAPACITY) || (position[slot] != SCHEDULER_NOT_SCHEDULED)) return false;
+
+  dueTimes[slot] = dueAt;
+  heap[count] = slot;
+  position[slot] = count;
+  siftUp(count++);
+  return true;
+}
+
+// Slot da raiz se já venceu, -1 se nenhum: sem nada vencido, o custo é uma comparação.
+int RemoteIOScheduler::next(uint32_t now)
+{
+  if ((count == 0) || !due(heap[0], now)) return -1;
+  return heap[0];
+}
+
+bool RemoteIOScheduler::due(uint8_t slot, uint32_t now)
+{
+  return (int32_t)(now - dueTimes[slot]) >= 0;
+}
+
+// Próxima leitura um intervalo depois da anterior, sem acumular atraso; se ficou para trás,
+// recomeça a partir de now. Vale também para slots fora do heap (leituras pedidas pelo sketch).
+void RemoteIOScheduler::advance(uint8_t slot, uint32_t interval, uint32_t now)
+{
+  dueTimes[slot] += interval;
+  if (due(slot, now)) dueTimes[slot] = now + interval;
+
+  // o instante só aumenta: basta descer no heap
+  if (position[slot] != SCHEDULER_NOT_SCHEDULED) siftDown(position[slot]);
+}
+
+uint32_t RemoteIOScheduler::dueAt(uint8_t slot)
+{
+  return dueTimes[slot];
+}
+
+bool RemoteIOScheduler::scheduled(uint8_t slot)
+{
+  return position[slot] != SCHEDULER_NOT_SCHEDULED;
+}
+
+uint8_t RemoteIOScheduler::size()
+{
+  return count;
+}
+
+bool RemoteIOScheduler::before(uint8_t a, uint8_t b)
+{
+  // empate pelo slot: a ordem entre leituras do mesmo instante não depende da forma do heap
+  int32_t difference = (int32_t)(dueTimes[heap[a]] - dueTimes[heap[b]]);
+  return (difference < 0) || ((difference == 0) && (heap[a] < heap[b]));
+}
+
+void RemoteIOScheduler::swap(uint8_t a, uint8_t b)
+{
+  uint8_t slot = heap[a];
+  heap[a] = heap[b];
+  heap[b] = slot;
+  position[heap[a]] = a;
+  position[heap[b]] = b;
+}
+
+void RemoteIOScheduler::siftUp(uint8_t index)
+{
+  while (index > 0)
+  {
+    uint8_t parent = (index - 1) / 2;
+    if (!before(index, parent)) return;
+
+    swap(index, parent);
+    index = parent;
+  }
+}
+
+void RemoteIOScheduler::siftDown(uint8_t index)
+{
+  while (true)
+  {
+    uint8_t smallest = index;
+    uint8_t left = (2 * index) + 1;
+    uint8_t right = left + 1;
+
+    if ((left < count) && before(left, smallest)) smallest = left;
+    if ((right < count) && before(right, smallest)) smallest = right;
+    if (smallest == index) return;
+
+    swap(index, smallest);
+    index = smallest;
+  }
+}
@@ -0,0 +1,46 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Agenda das leituras cíclicas: min-heap de slots pelo instante  ##
+##   da próxima leitura, com a posição de cada slot no heap.        ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOScheduler_h
+#define RemoteIOScheduler_h
+
+#include <stdint.h>
+
+#define SCHEDULER_CAPACITY 32           // slots agendáveis (IO_TABLE_CAPACITY)
+#define SCHEDULER_NOT_SCHEDULED 0xFF
+
+// Os instantes são millis() de 32 bits, comparados pela diferença com sinal: a ordem continua
+// correta quando o relógio dá a volta (~49 dias), desde que os intervalos fiquem abaixo de ~24 dias.
+class RemoteIOScheduler
+{
+  public:
+    RemoteIOScheduler();
+    void clear();
+    bool add(uint8_t slot, uint32_t dueAt);
+    int next(uint32_t now);
+    bool due(uint8_t slot, uint32_t now);
+    void advance(uint8_t slot, uint32_t interval, uint32_t now);
+    uint32_t dueAt(uint8_t slot);
+    bool scheduled(uint8_t slot);
+    uint8_t size();
+
+  private:
+    bool before(uint8_t a, uint8_t b);
+    void swap(uint8_t a, uint8_t b);
+    void siftUp(uint8_t index);
+    void siftDown(uint8_t index);
+
+    uint8_t heap[SCHEDULER_CAPACITY];       // slots, a raiz é a próxima leitura
+    uint8_t position[SCHEDULER_CAPACITY];   // posição de cada slot no heap, SCHEDULER_NOT_SCHEDULED se fora
+    uint32_t dueTimes[SCHEDULER_CAPACITY];  // millis() da próxima leitura de cada slot
+    uint8_t count;
+};
+
+#endif
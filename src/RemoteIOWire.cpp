@@ -0,0 +1,231 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Codificação dos corpos HTTP: JSON ou MessagePack, medidos e    ##
+##   gravados num buffer de bytes, sem passar por String; arrays    ##
+##   gravados e lidos um elemento por vez.                          ##
+##                                                                  ##
+######################################################################
+*/
+
+#include "RemoteIOWire.h"
+
+const char *RemoteIOWire::contentType(bool msgpack)
+{
+  return msgpack ? WIRE_MSGPACK_TYPE : WIRE_JSON_TYPE;
+}
+
+// Bytes do corpo codificado, sem terminador.
+size_t RemoteIOWire::measure(JsonDocument &document, bool msgpack)
+{
+  return msgpack ? measureMsgPack(document) : measureJson(document);
+}
+
+// Grava o corpo em buffer e devolve o tamanho; 0 se não couber. O JSON pede um byte a mais
+// para o '\0' que o ArduinoJson acrescenta.
+size_t RemoteIOWire::encode(JsonDocument &document, bool msgpack, uint8_t *buffer, size_t capacity)
+{
+  size_t length = measure(document, msgpack);
+
+  if (length + (msgpack ? 0 : 1) > capacity) return 0;
+  return msgpack ? serializeMsgPack(document, (void *)buffer, capacity) : serializeJson(document, (void *)buffer, capacity);
+}
+
+DeserializationError RemoteIOWire::decode(JsonDocument &document, Stream &stream, bool msgpack, JsonDocument &filter)
+{
+  if (msgpack) return deserializeMsgPack(document, stream, DeserializationOption::Filter(filter));
+  return deserializeJson(document, stream, DeserializationOption::Filter(filter));
+}
+
+// Lê o cabeçalho de um array MessagePack; -1 se o próximo valor não for um array.
+int32_t RemoteIOWire::readMsgPackArraySize(Stream &stream)
+{
+  uint8_t header[5];
+
+  if (stream.readBytes(header, 1) != 1) return -1;
+  if ((header[0] & 0xF0) == 0x90) return header[0] & 0x0F;
+
+  if (header[0] == 0xDC)
+  {
+    if (stream.readBytes(&header[1], 2) != 2) return -1;
+    return (header[1] << 8) | header[2];
+  }
+
+  if (header[0] == 0xDD)
+  {
+    if (stream.readBytes(&header[1], 4) != 4) return -1;
+    return ((uint32_t)header[1] << 24) | ((uint32_t)header[2] << 16) | (header[3] << 8) | header[4];
+  }
+  return -1;
+}
+
+RemoteIOWireArray::RemoteIOWireArray()
+{
+  begin();
+}
+
+void RemoteIOWireArray::begin()
+{
+  state = WIRE_ARRAY_START;
+  remaining = 0;
+  count = 0;
+}
+
+uint8_t RemoteIOWireArray::next(Stream &stream, bool msgpack, JsonDocument &element, JsonDocument &filter)
+{
+  if (state == WIRE_ARRAY_DONE) return WIRE_END;
+
+  if (state == WIRE_ARRAY_START)
+  {
+    if (stream.available() <= 0) return WIRE_WAIT;
+
+    if (msgpack)
+    {
+      remaining = RemoteIOWire::readMsgPackArraySize(stream);
+      if (remaining < 0)
+      {
+        state = WIRE_ARRAY_DONE;
+        return WIRE_ERROR;
+      }
+      state = WIRE_ARRAY_ELEMENT;
+    }
+    else
+    {
+      // espaços antes do '[' são ignorados; qualquer outro caractere não é um array
+      while (stream.available() > 0)
+      {
+        int c = stream.read();
+        if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')) continue;
+
+        state = (c == '[') ? WIRE_ARRAY_FIRST : WIRE_ARRAY_DONE;
+        break;
+      }
+
+      if (state == WIRE_ARRAY_DONE) return WIRE_ERROR;
+      if (state == WIRE_ARRAY_START) return WIRE_WAIT;
+    }
+  }
+
+  if (msgpack)
+  {
+    if (remaining == 0)
+    {
+      state = WIRE_ARRAY_DONE;
+      return WIRE_END;
+    }
+    if (stream.available() <= 0) return WIRE_WAIT;
+  }
+  else
+  {
+    // entre os elementos: ',' ou ']', e antes do primeiro, ']' de um array vazio
+    uint8_t result = separator(stream);
+    if (result != WIRE_ELEMENT) return result;
+  }
+
+  DeserializationError error = RemoteIOWire::decode(element, stream, msgpack, filter);
+  if (error)
+  {
+    state = WIRE_ARRAY_DONE;
+    return WIRE_ERROR;
+  }
+
+  count++;
+  if (msgpack) remaining--;
+  else state = WIRE_ARRAY_SEPARATOR;
+  return WIRE_ELEMENT;
+}
+
+// Consome espaços e o separador; WIRE_ELEMENT quando o próximo byte começa um elemento.
+uint8_t RemoteIOWireArray::separator(Stream &stream)
+{
+  while (stream.available() > 0)
+  {
+    int c = stream.peek();
+
+    if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))
+    {
+      stream.read();
+      continue;
+    }
+
+    if (c == ']')
+    {
+      stream.read();
+      state = WIRE_ARRAY_DONE;
+      return WIRE_END;
+    }
+
+    if (state == WIRE_ARRAY_SEPARATOR)
+    {
+      stream.read();
+      state = (c == ',') ? WIRE_ARRAY_ELEMENT : WIRE_ARRAY_DONE;
+      if (state == WIRE_ARRAY_DONE) return WIRE_ERROR;
+      continue;
+    }
+
+    // WIRE_ARRAY_FIRST ou WIRE_ARRAY_ELEMENT: o elemento começa aqui
+    state = WIRE_ARRAY_ELEMENT;
+    return WIRE_ELEMENT;
+  }
+  return WIRE_WAIT;
+}
+
+// Bytes do array além dos elementos: '[', ',' entre eles, ']' e o '\0' que o ArduinoJson grava
+// depois de cada elemento; no MessagePack, só o cabeçalho.
+size_t RemoteIOWireBatch::overhead(uint16_t count, bool msgpack)
+{
+  if (msgpack) return (count < 16) ? 1 : 3;
+  return (count > 0) ? count + 2 : 3;
+}
+
+void RemoteIOWireBatch::begin(uint8_t *buffer, size_t capacity, uint16_t count, bool msgpack)
+{
+  this->buffer = buffer;
+  this->capacity = capacity;
+  this->msgpack = msgpack;
+  this->count = 0;
+  length = 0;
+  failed = (capacity < overhead(count, msgpack));
+
+  if (failed) return;
+
+  if (!msgpack) buffer[length++] = '[';
+  else if (count < 16) buffer[length++] = 0x90 | count;
+  else
+  {
+    buffer[length++] = 0xDC;
+    buffer[length++] = count >> 8;
+    buffer[length++] = count & 0xFF;
+  }
+}
+
+bool RemoteIOWireBatch::add(JsonDocument &element)
+{
+  if (failed) return false;
+
+  if (!msgpack && (count > 0)) buffer[length++] = ',';
+
+  // o '\0' do JSON cai na posição da próxima ',' ou do ']'
+  size_t written = RemoteIOWire::encode(element, msgpack, buffer + length, capacity - length);
+  if (written == 0)
+  {
+    failed = true;
+    return false;
+  }
+
+  length += written;
+  count++;
+  return true;
+}
+
+// Tamanho do corpo gravado; 0 se algum elemento não coube.
+size_t RemoteIOWireBatch::end()
+{
+  if (failed) return 0;
+  if (msgpack) return length;
+
+  if (length >= capacity) return 0;
+  buffer[length++] = ']';
+  return length;
+}
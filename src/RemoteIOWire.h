@@ -0,0 +1,84 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Codificação dos corpos HTTP: JSON ou MessagePack, medidos e    ##
+##   gravados num buffer de bytes, sem passar por String; arrays    ##
+##   gravados e lidos um elemento por vez.                          ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOWire_h
+#define RemoteIOWire_h
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define WIRE_MSGPACK "msgpack"                        // codificação binária oferecida em /devices/verify
+#define WIRE_MSGPACK_TYPE "application/msgpack"
+#define WIRE_JSON_TYPE "application/json"
+
+#define WIRE_ELEMENT 0      // next(): um elemento lido em element
+#define WIRE_WAIT 1         // next(): o próximo byte ainda não chegou
+#define WIRE_END 2          // next(): fim do array
+#define WIRE_ERROR 3        // next(): o corpo não é um array válido
+
+#define WIRE_ARRAY_START 0        // antes do '[' (ou do cabeçalho MessagePack)
+#define WIRE_ARRAY_FIRST 1        // depois do '[': um elemento ou ']'
+#define WIRE_ARRAY_SEPARATOR 2    // depois de um elemento: ',' ou ']'
+#define WIRE_ARRAY_ELEMENT 3      // depois da ',': um elemento
+#define WIRE_ARRAY_DONE 4
+
+// O corpo MessagePack tem bytes 0x00 (inteiro 0, tamanhos curtos): ele é tratado sempre como
+// (buffer, tamanho), nunca como texto terminado em '\0'.
+class RemoteIOWire
+{
+  public:
+    static const char *contentType(bool msgpack);
+    static size_t measure(JsonDocument &document, bool msgpack);
+    static size_t encode(JsonDocument &document, bool msgpack, uint8_t *buffer, size_t capacity);
+    static DeserializationError decode(JsonDocument &document, Stream &stream, bool msgpack, JsonDocument &filter);
+    static int32_t readMsgPackArraySize(Stream &stream);
+};
+
+// Leitura de um array no topo do corpo, um elemento por chamada de next(): a memória não depende
+// do número de elementos, e a leitura para (WIRE_WAIT) sempre que o próximo byte ainda não chegou,
+// em vez de esperar por ele. Só a leitura de um elemento já começado depende do timeout do stream.
+class RemoteIOWireArray
+{
+  public:
+    RemoteIOWireArray();
+    void begin();
+    uint8_t next(Stream &stream, bool msgpack, JsonDocument &element, JsonDocument &filter);
+
+    uint16_t count;         // elementos lidos
+
+  private:
+    uint8_t separator(Stream &stream);
+
+    uint8_t state;          // WIRE_ARRAY_*
+    int32_t remaining;      // MessagePack: elementos ainda por ler
+};
+
+// Escrita de um array no topo do corpo, um elemento por chamada de add(): cada elemento vem num
+// documento próprio, então a memória de montagem não depende do número de elementos. O chamador
+// mede os elementos antes, para dimensionar o buffer com overhead() + a soma das medidas.
+class RemoteIOWireBatch
+{
+  public:
+    static size_t overhead(uint16_t count, bool msgpack);
+    void begin(uint8_t *buffer, size_t capacity, uint16_t count, bool msgpack);
+    bool add(JsonDocument &element);
+    size_t end();
+
+  private:
+    uint8_t *buffer;
+    size_t capacity;
+    size_t length;
+    uint16_t count;         // elementos gravados
+    bool msgpack;
+    bool failed;            // um elemento não coube: end() devolve 0
+};
+
+#endif
@@ -1,183 +1,172 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Portal de configuração (web/index.html) minificado e gzip,     ##
+##   gerado por scripts/web_assets.py. Não editar.                  ##
+##                                                                  ##
+######################################################################
+*/
+
 #ifndef INDEX_HTML_H
 #define INDEX_HTML_H
 
 #include <pgmspace.h>
 
-const char page_setup[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-    <style>
-        .IndexBody {
-            display: flex;
-            background-color: #F6F8FC;
-            width: 98%;
-            height: 98vh;
-            flex-direction: column;
-            font-family: arial;
-        }
-
-        .Header {
-            display: flex;
-            width: 100%;
-            height: 80px;
-            box-sizing: border-box;
-            align-items: center;
-            padding: 0px 80px 0px 80px;
-        }
-
-        .BoxShadow {
-            background-color: #FAFAFA;
-            display: flex;
-            box-sizing: border-box;
-            padding: 10px 11px 10px 11px;
-            width: 432px;
-            height: 570px; 
-            flex-direction: column;
-            border: 2px;
-            box-shadow: 2px 2px 12px 0.25px #c0c7d9;
-            border-radius: 36px;
-            align-self: center;
-        }
-
-        .TitlePage,
-        h1 {
-            display: flex;
-            justify-content: center;
-            align-self: center;
-            text-align: center;
-            font-size: 24px;
-            font-weight: 700;
-            width: 204px;
-            color: #39496D;
-        }
-
-        .FormBody {
-            display: flex;
-            flex-direction: column;
-            font-size: 14px;
-            font-weight: 400;
-            justify-self: center;
-            padding: 20px 40px 20px 40px;
-        }
-
-        .FormBody label {
-            display: flex;
-            margin-top: 5px;
-            padding: 5px;
-            color: #39496D;
-            font-weight: 400;
-
-        }
-
-        .FormBody input {
-            border-radius: 12.36px;
-            box-sizing: border-box;
-            width: 328px;
-            height: 40px;
-            background-color: #EDF0F4;
-            border: 0px;
-            margin: 5px;
-            padding: 16px;
-        }
-
-        .SubmitButton {
-            display: flex;
-            justify-content: center;
-        }
-
-        .SubmitButton input {
-            display: flex;
-            width: 221px;
-            height: 48px;
-            align-self: center;
-            justify-content: center;
-            font-size: 16px;
-            font-weight: 400;
-            background-color: #265FFF;
-            color: white;
-            margin-top: 30px;
-        }
-
-        .Logo {
-            display: flex;
-            width: 200px;
-            height: 65px;
-        }
-    </style>
-
-    <body class="IndexBody">
-        <div class="Header">
-            <div class="Logo">
-
-                <svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 549 44">
-                    <defs>
-                        <style>
-                            .cls-1 {
-                                fill: #150035;
-                            }
-
-                            .cls-2 {
-                                fill: #265fff;
-                            }
-
-                            .cls-3 {
-                                fill: #fff;
-                            }
-                        </style>
-                    </defs>
-                    <g id="Camada_2" data-name="Camada 2">
-                        <g id="Camada_1-2" data-name="Camada 1">
-                            <path class="cls-1"
-                                d="M153.45,37.55A64.47,64.47,0,0,1,160.82,36a63.23,63.23,0,0,1,10.05-.73,23,23,0,0,1,8.67,1.42,13.31,13.31,0,0,1,5.55,4A15.13,15.13,0,0,1,188,46.83a34.17,34.17,0,0,1,.85,7.9V78.55h-9.8V56.27a32,32,0,0,0-.45-5.8,10.27,10.27,0,0,0-1.46-3.89,5.8,5.8,0,0,0-2.75-2.19,11.82,11.82,0,0,0-4.26-.68,33.12,33.12,0,0,0-3.89.24c-1.35.16-2.35.3-3,.4v34.2h-9.81Z" />
-                            <path class="cls-1"
-                                d="M239.21,57.32a27.46,27.46,0,0,1-1.46,9.16,20.36,20.36,0,0,1-4.13,7,18.6,18.6,0,0,1-6.44,4.53,20.81,20.81,0,0,1-8.31,1.62,20.5,20.5,0,0,1-8.26-1.62,18.77,18.77,0,0,1-6.41-4.53,20.92,20.92,0,0,1-4.17-7,26.71,26.71,0,0,1-1.5-9.16A26.36,26.36,0,0,1,200,48.2a20.49,20.49,0,0,1,4.22-7,18.48,18.48,0,0,1,6.44-4.49,20.61,20.61,0,0,1,8.18-1.58,21,21,0,0,1,8.23,1.58,18.12,18.12,0,0,1,6.44,4.49,21,21,0,0,1,4.17,7A26.36,26.36,0,0,1,239.21,57.32Zm-10.05,0q0-6.32-2.71-10a9.62,9.62,0,0,0-15.15,0q-2.73,3.69-2.72,10t2.72,10.13a9.56,9.56,0,0,0,15.15,0Q229.17,63.71,229.16,57.32Z" />
-                            <path class="cls-1"
-                                d="M287,77.25a56,56,0,0,1-7.33,1.62,56.57,56.57,0,0,1-9.28.73,24.6,24.6,0,0,1-9-1.54,18.58,18.58,0,0,1-6.77-4.41,19.37,19.37,0,0,1-4.29-7,26.62,26.62,0,0,1-1.5-9.2,30.94,30.94,0,0,1,1.25-9.12,20,20,0,0,1,3.69-7,16.35,16.35,0,0,1,5.91-4.5,19.18,19.18,0,0,1,8-1.58,18.25,18.25,0,0,1,5.43.73,23.69,23.69,0,0,1,4.05,1.62V17.29l9.8-1.62Zm-28.12-20q0,6.48,3.08,10.17a10.49,10.49,0,0,0,8.51,3.68,32.7,32.7,0,0,0,4-.2,26.32,26.32,0,0,0,2.72-.44V46.14a15,15,0,0,0-3.45-1.66,13.25,13.25,0,0,0-4.57-.77q-5.36,0-7.82,3.64T258.92,57.24Z" />
-                            <path class="cls-1"
-                                d="M296.7,57.56a26.54,26.54,0,0,1,1.66-9.8,20.55,20.55,0,0,1,4.42-7,18.18,18.18,0,0,1,6.32-4.22,19.61,19.61,0,0,1,7.29-1.41q8.75,0,13.65,5.42T335,56.75c0,.54,0,1.15,0,1.82s-.07,1.29-.13,1.83H306.83a11.2,11.2,0,0,0,3.6,7.9q3.21,2.79,9.28,2.79a30.6,30.6,0,0,0,6.52-.64,27.77,27.77,0,0,0,4.66-1.38l1.3,8a14.71,14.71,0,0,1-2.23.85,29.4,29.4,0,0,1-3.24.81c-1.22.24-2.53.45-3.93.61a38,38,0,0,1-4.29.24,26,26,0,0,1-9.73-1.66,17.92,17.92,0,0,1-6.8-4.62,18.87,18.87,0,0,1-4-7A28.54,28.54,0,0,1,296.7,57.56Zm28.44-4.37a12.81,12.81,0,0,0-.57-3.85,9.25,9.25,0,0,0-1.66-3.16,7.87,7.87,0,0,0-2.67-2.11,8.6,8.6,0,0,0-3.77-.77,8.73,8.73,0,0,0-4,.85,9.1,9.1,0,0,0-2.88,2.23,10.2,10.2,0,0,0-1.82,3.16,17.07,17.07,0,0,0-.89,3.65Z" />
-                            <path class="cls-1" d="M374.1,78.55h-9.81v-38h9.81Z" />
-                            <path class="cls-1"
-                                d="M424.44,57.32A27.46,27.46,0,0,1,423,66.48a20.38,20.38,0,0,1-4.14,7,18.6,18.6,0,0,1-6.44,4.53,20.81,20.81,0,0,1-8.31,1.62,20.5,20.5,0,0,1-8.26-1.62,18.63,18.63,0,0,1-6.4-4.53,20.78,20.78,0,0,1-4.18-7,26.71,26.71,0,0,1-1.49-9.16,26.36,26.36,0,0,1,1.49-9.12,20.65,20.65,0,0,1,4.22-7,18.57,18.57,0,0,1,6.44-4.49,20.61,20.61,0,0,1,8.18-1.58,21,21,0,0,1,8.23,1.58,18.12,18.12,0,0,1,6.44,4.49,21,21,0,0,1,4.17,7A26.36,26.36,0,0,1,424.44,57.32Zm-10,0q0-6.32-2.72-10a9.62,9.62,0,0,0-15.15,0q-2.71,3.69-2.72,10t2.72,10.13a9.56,9.56,0,0,0,15.15,0Q414.4,63.71,414.4,57.32Z" />
-                            <path class="cls-1" d="M471.21,22.39v8.84H454V78.55H443.66V31.23H426.4V22.39Z" />
-                            <rect class="cls-2" x="363.6" y="22.39" width="11.19" height="11.19" rx="3.46" />
-                            <path class="cls-2"
-                                d="M79.29,0H35.46A35.46,35.46,0,0,0,0,35.46V79.3a35.45,35.45,0,0,0,35.46,35.45H79.29A35.46,35.46,0,0,0,114.75,79.3V35.46A35.47,35.47,0,0,0,79.29,0Z" />
-                            <path class="cls-3"
-                                d="M94.56,55V76.79H26a21.4,21.4,0,0,1-3.14-8A20.11,20.11,0,0,1,22.53,65a20.91,20.91,0,0,1,.41-4.14A21.66,21.66,0,0,1,44.21,43.32a22,22,0,0,1,3.37.26V52a13.07,13.07,0,0,0-3.39-.44A13.39,13.39,0,0,0,31.35,68.82H86.28V55a13.4,13.4,0,0,0-13.4-13.39H64.15V60.86H55.86V33.32h17A21.54,21.54,0,0,1,86.28,38a20.9,20.9,0,0,1,3.64,3.64A21.55,21.55,0,0,1,94.56,55Z" />
-                        </g>
-                    </g>
-                </svg>
-            </div>
-        </div>
-
-        <div class="BoxShadow">
-
-            <div class="TitlePage">
-                <h1>Configure seu <br> Wi-Fi e sua conta</h1>
-            </div>
-
-            <div class="FormBody">
-                <form action="/get" method="get">
-                    <label for="ssid">Nome da rede Wi-Fi</label>
-                    <input type="text" id="ssid" name="ssid" required>
-                    <label for="password">Senha:</label>
-                    <input type="text" id="password" name="password" required>
-                    <label for="companyName">Nome da empresa:</label>
-                    <input type="text" id="companyName" name="companyName" required>
-                    <label for="deviceId">Nome do dispositivo:</label>
-                    <input type="text" id="deviceId" name="deviceId" required>
-
-                    <div class="SubmitButton">
-                        <input type="submit" value="Salvar">
-                    </div>
-                </form>
-            </div>
-
-        </div>
-
-    </body>
-
-</html>
-)rawliteral";
-
-#endif
\ No newline at end of file
+// 8604 bytes do HTML original, 6047 minificado
+#define PAGE_SETUP_GZ_LENGTH 2369
+#define PAGE_SETUP_ETAG "\"02e0affc252dba12\""
+
+const uint8_t page_setup_gz[PAGE_SETUP_GZ_LENGTH] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x58, 0x5b, 0x6f, 0xdb, 0xca,
+  0x11, 0x7e, 0xcf, 0xaf, 0x60, 0x15, 0xb4, 0x38, 0x05, 0x96, 0x14, 0xf7, 0x4a, 0x52, 0xb6, 0x03,
+  0x38, 0xc9, 0x31, 0x14, 0xb4, 0x3d, 0x4d, 0x91, 0x40, 0x45, 0xcf, 0x4b, 0xb1, 0x96, 0x28, 0x89,
+  0x2d, 0x25, 0x2a, 0x12, 0x25, 0xdb, 0x0d, 0xf2, 0xdf, 0xfb, 0xcd, 0xee, 0x92, 0x92, 0x6d, 0x25,
+  0x6e, 0x1f, 0x0a, 0x14, 0x96, 0x87, 0xe4, 0xee, 0xec, 0x5c, 0xbf, 0x9d, 0xe1, 0xf2, 0xf2, 0x37,
+  0xef, 0xff, 0xfc, 0xee, 0xf3, 0xdf, 0x3e, 0xfe, 0x1c, 0x2d, 0xdb, 0x55, 0xfd, 0xe6, 0xd5, 0x65,
+  0xb8, 0xec, 0xda, 0x87, 0xba, 0x7c, 0x93, 0x7c, 0x58, 0xcf, 0xca, 0xfb, 0xb7, 0xcd, 0xec, 0xe1,
+  0xeb, 0xac, 0xda, 0x6d, 0x6a, 0xfb, 0x30, 0x9a, 0xd7, 0xe5, 0xfd, 0xc5, 0xad, 0x9d, 0xfe, 0x73,
+  0xb1, 0x6d, 0xf6, 0xeb, 0x59, 0x3c, 0x6d, 0xea, 0x66, 0x3b, 0x7a, 0x7d, 0x63, 0x6e, 0xf2, 0x9b,
+  0x77, 0x17, 0x77, 0xd5, 0xac, 0x5d, 0x8e, 0x8a, 0xfc, 0xb7, 0x17, 0xcb, 0xb2, 0x5a, 0x2c, 0x5b,
+  0xdc, 0x1e, 0x96, 0x17, 0xb4, 0x26, 0x9e, 0x55, 0xdb, 0x72, 0xda, 0x56, 0xcd, 0x7a, 0x84, 0x25,
+  0xfb, 0xd5, 0xfa, 0x62, 0xde, 0xac, 0xdb, 0x78, 0x6e, 0x57, 0x55, 0xfd, 0x30, 0xb2, 0xdb, 0xca,
+  0xd6, 0x17, 0xdf, 0x92, 0x71, 0x69, 0x67, 0xe5, 0xf6, 0xb1, 0x32, 0x2f, 0x93, 0xa7, 0x69, 0x2f,
+  0x34, 0x4f, 0x37, 0xb0, 0xa1, 0xb9, 0x8f, 0x77, 0xd5, 0xbf, 0xaa, 0xf5, 0x62, 0x74, 0xdb, 0x6c,
+  0xb1, 0x2a, 0xc6, 0xc8, 0x85, 0xad, 0xab, 0xc5, 0x3a, 0xae, 0xda, 0x72, 0xb5, 0x1b, 0x4d, 0xcb,
+  0x75, 0x5b, 0x6e, 0x2f, 0x36, 0x76, 0x36, 0x23, 0x2e, 0x2c, 0x8a, 0x68, 0x65, 0xd4, 0xdd, 0x40,
+  0xdf, 0xdb, 0xe6, 0xfe, 0xd3, 0xd2, 0xce, 0x9a, 0xbb, 0xaf, 0x67, 0x5c, 0xba, 0xa6, 0xbf, 0x8b,
+  0xc7, 0x8e, 0x9f, 0x55, 0xda, 0x69, 0xe0, 0x24, 0x99, 0x73, 0x22, 0xdd, 0x5d, 0xb0, 0x5e, 0x49,
+  0x81, 0xfb, 0x60, 0xbe, 0xce, 0x48, 0xf9, 0xf9, 0xa0, 0x78, 0xa9, 0x23, 0xd1, 0x39, 0xe8, 0x8c,
+  0xa3, 0xc7, 0x88, 0xfe, 0x39, 0x91, 0x34, 0x11, 0x1a, 0x97, 0xd7, 0xd3, 0x74, 0x9a, 0xcd, 0x8a,
+  0xb0, 0x22, 0xde, 0xda, 0x59, 0xb5, 0xdf, 0x8d, 0xa4, 0xd9, 0x74, 0x41, 0xd8, 0x95, 0xf5, 0xbc,
+  0x8b, 0xc1, 0xb7, 0xe4, 0x73, 0xd5, 0xd6, 0xe5, 0x47, 0xbb, 0x28, 0xd9, 0x92, 0x3f, 0x8e, 0xef,
+  0x3f, 0xf6, 0xbb, 0xb6, 0x9a, 0x3f, 0xc0, 0x6d, 0xb0, 0xae, 0xdb, 0x6e, 0xc9, 0x73, 0x21, 0x6d,
+  0x79, 0xdf, 0xc6, 0x6e, 0xb8, 0x1b, 0x71, 0x29, 0x44, 0x3c, 0xca, 0x91, 0x50, 0xe4, 0x12, 0x3d,
+  0xde, 0x79, 0x27, 0xb3, 0x34, 0x0d, 0xbe, 0x8b, 0x94, 0xe6, 0x42, 0x50, 0x65, 0xa1, 0x0a, 0xf3,
+  0x1e, 0xf6, 0xdc, 0x34, 0xdb, 0xd5, 0x73, 0x60, 0xfd, 0x00, 0x29, 0x4e, 0x0d, 0x7f, 0xaa, 0x46,
+  0x41, 0x4d, 0xe7, 0xc0, 0xa9, 0xad, 0x5d, 0x4a, 0x04, 0x25, 0x42, 0x11, 0xe9, 0xef, 0x4e, 0x94,
+  0x47, 0xb5, 0xbd, 0x2d, 0xeb, 0xc7, 0x26, 0xac, 0xec, 0x76, 0x51, 0xad, 0xe3, 0xb6, 0xd9, 0x8c,
+  0x10, 0xe6, 0x5e, 0x90, 0x7e, 0xe6, 0xc3, 0x53, 0x33, 0x4e, 0xc4, 0x56, 0xeb, 0xcd, 0xbe, 0xfd,
+  0xfa, 0x38, 0x33, 0x5c, 0x24, 0x2e, 0x39, 0xe7, 0x21, 0xe4, 0x43, 0x25, 0x45, 0x7e, 0x84, 0x89,
+  0xb3, 0xf5, 0x39, 0x2c, 0x7f, 0x7e, 0x7f, 0x93, 0xde, 0xa8, 0x0e, 0x28, 0xc4, 0xe3, 0x2d, 0x7e,
+  0x64, 0x2d, 0x37, 0xce, 0xcf, 0x4f, 0xfb, 0xdb, 0x55, 0xd5, 0xbe, 0xdd, 0xb7, 0x6d, 0xb3, 0xfe,
+  0x8f, 0x92, 0xfe, 0x78, 0x49, 0xf0, 0xe3, 0xcc, 0x6e, 0x14, 0x82, 0x9f, 0x18, 0x9a, 0x9f, 0xc5,
+  0xdc, 0x77, 0x54, 0x9c, 0x24, 0xd3, 0x9c, 0x49, 0xe6, 0x73, 0x87, 0x85, 0xd1, 0x37, 0x37, 0x37,
+  0x21, 0xf8, 0x77, 0x4b, 0xec, 0xed, 0xd3, 0x1c, 0x49, 0x9f, 0xd1, 0x3f, 0x36, 0x8b, 0xe6, 0xac,
+  0xa1, 0x69, 0x7a, 0x34, 0xd4, 0x50, 0x88, 0xbe, 0x5d, 0x0e, 0x7d, 0x71, 0x7b, 0x75, 0x79, 0x4b,
+  0xb9, 0x9a, 0xd6, 0x76, 0xb7, 0xbb, 0x1a, 0xf4, 0x95, 0x6e, 0x80, 0x89, 0x59, 0x75, 0xe8, 0xc6,
+  0x7d, 0x45, 0x7a, 0x32, 0x48, 0xda, 0x68, 0x68, 0x77, 0x58, 0x44, 0xf7, 0xab, 0x7a, 0x8d, 0xa1,
+  0x65, 0xdb, 0x6e, 0x46, 0xc3, 0xe1, 0xdd, 0xdd, 0x5d, 0x72, 0x27, 0x93, 0x66, 0xbb, 0x18, 0x42,
+  0x75, 0x3a, 0x04, 0xc7, 0x20, 0x3a, 0x54, 0xe5, 0x1d, 0x2a, 0xcd, 0xd5, 0x20, 0x8d, 0xd2, 0x48,
+  0xab, 0x22, 0x52, 0xca, 0x09, 0x2c, 0xe7, 0xbb, 0x63, 0xa9, 0x9d, 0xd6, 0xbb, 0x98, 0x7f, 0x9d,
+  0x57, 0x75, 0x3d, 0x7a, 0xcd, 0x75, 0x9a, 0x4a, 0x0d, 0xb7, 0x68, 0x50, 0x84, 0x41, 0xc4, 0x61,
+  0x3e, 0x9f, 0x87, 0x41, 0x19, 0x06, 0xdd, 0xc8, 0xd1, 0xa3, 0x61, 0x90, 0xb9, 0x88, 0xaa, 0xd9,
+  0xd5, 0xe0, 0x9d, 0x5d, 0xd9, 0x99, 0xfd, 0xbb, 0x18, 0x44, 0x33, 0xdb, 0xda, 0x78, 0x6d, 0x57,
+  0x65, 0x37, 0x18, 0x89, 0xc1, 0x53, 0x36, 0x1e, 0x9f, 0x65, 0xe4, 0xc4, 0xb8, 0xb1, 0xed, 0xb2,
+  0x73, 0xde, 0x19, 0x3a, 0x78, 0x85, 0x85, 0x7f, 0xe2, 0x5a, 0x26, 0x4a, 0x33, 0x99, 0x25, 0x5a,
+  0x5f, 0x1b, 0x95, 0xa8, 0x8c, 0x79, 0x9a, 0xe2, 0x8f, 0x33, 0x6e, 0xd2, 0x24, 0x17, 0x4c, 0x1a,
+  0x6b, 0x64, 0x22, 0x24, 0xf3, 0x34, 0xcc, 0xa5, 0x49, 0xaa, 0xe3, 0x24, 0x93, 0x4c, 0xb8, 0x9f,
+  0x1f, 0xcd, 0x13, 0x93, 0x31, 0x9e, 0x28, 0xc1, 0xb8, 0x4c, 0x24, 0x0f, 0xd4, 0xcf, 0x69, 0x28,
+  0x61, 0xea, 0x9a, 0xeb, 0x84, 0x4b, 0xe6, 0x69, 0x10, 0x95, 0xe7, 0x4c, 0x99, 0x24, 0x97, 0x56,
+  0xaa, 0x84, 0x67, 0xcc, 0x53, 0x3f, 0x97, 0xe4, 0x9a, 0x65, 0x49, 0x31, 0xc9, 0x72, 0xac, 0x5e,
+  0xc6, 0x45, 0x92, 0x4f, 0xb4, 0x49, 0x44, 0x66, 0x25, 0xec, 0x12, 0x8e, 0x29, 0x8d, 0xe1, 0x43,
+  0xac, 0x93, 0x9c, 0x6c, 0x12, 0x59, 0xa0, 0x7e, 0x06, 0xa6, 0x98, 0x58, 0x26, 0x79, 0xc1, 0x68,
+  0x9e, 0xfe, 0xfd, 0xb8, 0x48, 0x32, 0x0d, 0xc2, 0x0b, 0xc6, 0x39, 0xb9, 0xe8, 0xa9, 0x9f, 0x53,
+  0x89, 0x30, 0x71, 0x62, 0x72, 0x26, 0x65, 0xc2, 0x45, 0xa0, 0x7e, 0x8a, 0x24, 0x25, 0x42, 0x4d,
+  0x21, 0x57, 0xc2, 0x01, 0x03, 0x11, 0xb8, 0xca, 0x58, 0xb2, 0x44, 0x1d, 0x60, 0xb6, 0x70, 0x16,
+  0xf2, 0x5f, 0x07, 0xd1, 0xf0, 0xfb, 0x41, 0x17, 0x12, 0x32, 0x10, 0x8e, 0x2c, 0x91, 0xc2, 0x8a,
+  0x0c, 0x16, 0x32, 0x4f, 0x9d, 0xc7, 0xce, 0x64, 0x56, 0x40, 0x38, 0x13, 0x29, 0x2a, 0x4e, 0xa0,
+  0x7e, 0x4e, 0x51, 0xd0, 0xe0, 0x21, 0xc2, 0xec, 0x89, 0x1f, 0x36, 0x89, 0x52, 0x4c, 0x25, 0x5a,
+  0x12, 0x73, 0xce, 0x03, 0xf5, 0x73, 0xb9, 0x4b, 0x43, 0x62, 0x04, 0x8d, 0x6a, 0x4f, 0xba, 0x19,
+  0xf8, 0xe9, 0x66, 0x20, 0x2a, 0xcb, 0x02, 0xed, 0x25, 0x92, 0x36, 0x2f, 0xb1, 0x10, 0x81, 0xf6,
+  0x46, 0x64, 0x71, 0xc6, 0x84, 0x49, 0x32, 0x1e, 0x68, 0x67, 0xb9, 0x8e, 0xc9, 0xf0, 0x6b, 0x0c,
+  0x92, 0xe1, 0xa6, 0x37, 0x1c, 0xeb, 0x53, 0xa6, 0xa0, 0xd0, 0x42, 0x90, 0x2a, 0x98, 0xa7, 0x7e,
+  0x0a, 0x51, 0x13, 0xb1, 0xd3, 0xae, 0xf2, 0x40, 0xfd, 0x04, 0x79, 0x05, 0x65, 0x9e, 0xdd, 0xf0,
+  0x40, 0x3b, 0x9c, 0xf1, 0x9c, 0xf4, 0xe5, 0x0c, 0x91, 0x14, 0xc7, 0x51, 0x00, 0xd1, 0x8d, 0x42,
+  0x0e, 0x17, 0x81, 0x1e, 0xa5, 0x31, 0x2f, 0xed, 0x64, 0x85, 0x43, 0x5a, 0x76, 0xce, 0xe0, 0x93,
+  0x24, 0xfd, 0xba, 0x8a, 0x1d, 0xda, 0x59, 0xfa, 0x25, 0x45, 0x64, 0xa4, 0x20, 0xf8, 0xc0, 0xdd,
+  0xd4, 0x16, 0x14, 0x3d, 0x47, 0x02, 0xdc, 0x00, 0x0a, 0x62, 0x23, 0x06, 0xc9, 0x64, 0x62, 0x0a,
+  0xba, 0x83, 0x21, 0x69, 0x1b, 0xae, 0x48, 0x20, 0x56, 0x69, 0xca, 0xb0, 0xf6, 0xba, 0x52, 0x16,
+  0x56, 0xfd, 0x45, 0x88, 0x82, 0xcc, 0xc1, 0x2e, 0xa3, 0xc0, 0x0a, 0x87, 0x01, 0x6f, 0xc0, 0x8f,
+  0xf1, 0x94, 0xc3, 0x85, 0x0c, 0x2f, 0x15, 0x16, 0x12, 0x75, 0x87, 0x09, 0xac, 0x93, 0x3e, 0xef,
+  0xd8, 0x2f, 0x3a, 0x0b, 0xd4, 0xcf, 0xc1, 0xb5, 0xdc, 0xed, 0x5c, 0x05, 0x08, 0x39, 0x12, 0xc6,
+  0x29, 0xa4, 0x8a, 0xc2, 0xe6, 0x43, 0xa8, 0xf3, 0x1e, 0x0e, 0x59, 0x46, 0xa9, 0x00, 0x92, 0x8a,
+  0x44, 0x66, 0x81, 0x76, 0x70, 0x10, 0x85, 0x87, 0x03, 0x61, 0xcc, 0x74, 0xc1, 0xe8, 0xe0, 0x80,
+  0x0d, 0x04, 0xec, 0xa8, 0x40, 0xc3, 0x86, 0x87, 0xb1, 0x84, 0x14, 0xc2, 0x15, 0xfd, 0xfc, 0xa8,
+  0x0b, 0x17, 0x64, 0x23, 0xc2, 0x3a, 0xd0, 0xae, 0x70, 0x14, 0x0e, 0x8c, 0xa4, 0x96, 0xe7, 0x81,
+  0x86, 0x8c, 0xc7, 0x5d, 0xba, 0x85, 0x0e, 0xb4, 0x5b, 0xa3, 0xa4, 0x2f, 0x4e, 0x90, 0x1a, 0x68,
+  0x97, 0x72, 0x64, 0x92, 0x02, 0x33, 0xe1, 0x08, 0x5a, 0x51, 0x63, 0xc3, 0xba, 0x5d, 0x80, 0x2c,
+  0x0b, 0xc2, 0x4b, 0x2c, 0x90, 0x66, 0x82, 0x0b, 0x0a, 0x40, 0x92, 0xba, 0xa2, 0xc2, 0x33, 0xcb,
+  0x1d, 0x62, 0x79, 0x8f, 0xdb, 0x14, 0x60, 0xd3, 0xce, 0x66, 0xb0, 0x21, 0xb7, 0x9e, 0xf8, 0x19,
+  0x15, 0x27, 0x2e, 0x12, 0xb2, 0xa3, 0x7e, 0x98, 0x10, 0x80, 0x52, 0xa5, 0x26, 0xa8, 0x75, 0x5c,
+  0x59, 0xa4, 0x9c, 0xeb, 0xbe, 0xae, 0xa0, 0x82, 0xc1, 0x08, 0x43, 0x05, 0x93, 0x3c, 0x91, 0x9d,
+  0x27, 0x54, 0x8e, 0x74, 0x86, 0x3a, 0x9b, 0x7d, 0x41, 0x89, 0x23, 0x78, 0x22, 0xb3, 0x54, 0x93,
+  0x13, 0xa3, 0x3e, 0x0b, 0x9d, 0xd3, 0xb6, 0x04, 0x46, 0x84, 0x7a, 0x01, 0x23, 0x05, 0x52, 0x48,
+  0x8c, 0xda, 0x58, 0xd8, 0x84, 0x24, 0x7b, 0xda, 0xe5, 0xc3, 0x18, 0x2a, 0x5c, 0xae, 0x3a, 0xe8,
+  0x40, 0xbb, 0x68, 0xa9, 0xb0, 0x3b, 0x79, 0x1e, 0x68, 0xb7, 0x9f, 0xb0, 0x0f, 0x68, 0xef, 0x52,
+  0x3e, 0x0c, 0x0f, 0xd4, 0xcf, 0x51, 0x5c, 0xa9, 0x8e, 0xf1, 0x2f, 0x80, 0x19, 0x49, 0x82, 0x3f,
+  0x46, 0x53, 0x4e, 0xc4, 0x67, 0x89, 0xb4, 0x02, 0x8b, 0x99, 0x9e, 0xa6, 0xcc, 0x5b, 0xc0, 0x1d,
+  0xfa, 0x19, 0x55, 0xe0, 0x5d, 0x9c, 0xa4, 0xd4, 0x3f, 0xb0, 0xdc, 0x35, 0x09, 0xf4, 0x84, 0xb1,
+  0x4c, 0x5d, 0x6b, 0x40, 0x85, 0x76, 0x65, 0xba, 0x8b, 0x26, 0x24, 0x52, 0x63, 0xf8, 0x22, 0x69,
+  0x9b, 0x22, 0xb4, 0x05, 0x23, 0x54, 0xbb, 0x3b, 0x0b, 0xac, 0x19, 0xe6, 0x88, 0xe7, 0x85, 0xab,
+  0x88, 0xbc, 0x51, 0x54, 0x67, 0x51, 0xe2, 0x3c, 0x0d, 0xb9, 0x22, 0xd7, 0x51, 0xcd, 0xf3, 0x1a,
+  0x84, 0xe5, 0x96, 0x2b, 0xda, 0x7c, 0x9e, 0x7a, 0x18, 0x0b, 0x14, 0x15, 0xea, 0x42, 0xd8, 0x8f,
+  0xca, 0x13, 0x3f, 0x0e, 0xc5, 0x0a, 0x65, 0x96, 0x7a, 0x81, 0x00, 0x8f, 0x02, 0xa3, 0xeb, 0xa6,
+  0x98, 0x28, 0x60, 0x1c, 0xb7, 0x12, 0xc8, 0xc8, 0x4f, 0x36, 0x09, 0x78, 0x10, 0x75, 0xfa, 0x75,
+  0xbb, 0x30, 0x93, 0x21, 0xe9, 0x19, 0xa5, 0xd1, 0xd3, 0x6e, 0xc3, 0xe5, 0x58, 0xe3, 0x4b, 0x73,
+  0x9e, 0x05, 0x1a, 0x44, 0xc5, 0xa8, 0x57, 0xb9, 0x4b, 0x61, 0x7e, 0x4c, 0xe1, 0x49, 0x82, 0x7f,
+  0x5d, 0x61, 0xc2, 0x95, 0x4e, 0x09, 0xdc, 0x0a, 0x6a, 0x05, 0x9e, 0x86, 0x66, 0x09, 0x38, 0x39,
+  0x87, 0x0a, 0xc2, 0x58, 0x71, 0x04, 0x9a, 0x43, 0x81, 0xa4, 0xa2, 0x93, 0x91, 0xb6, 0xac, 0x53,
+  0x49, 0xdd, 0xd2, 0x64, 0xd4, 0x2d, 0x5d, 0x7f, 0x67, 0x5d, 0xdf, 0x21, 0xd8, 0x66, 0x0e, 0x9a,
+  0xcc, 0x55, 0x13, 0x47, 0x02, 0x66, 0x99, 0x57, 0xc0, 0xdd, 0x7f, 0x27, 0x24, 0xa7, 0xf4, 0x50,
+  0x85, 0x4e, 0x13, 0xe1, 0x49, 0xa7, 0xd8, 0x01, 0x9a, 0xbb, 0x40, 0x50, 0xfe, 0x1d, 0x0d, 0xd6,
+  0xa2, 0x75, 0x13, 0x78, 0xbe, 0x0b, 0xef, 0x88, 0xe0, 0x2d, 0x33, 0x14, 0x72, 0x76, 0x7c, 0x47,
+  0xe0, 0x87, 0x58, 0xe6, 0xcb, 0x97, 0x5b, 0xb1, 0x42, 0x0a, 0xd1, 0x16, 0x5c, 0x91, 0xbd, 0x7e,
+  0xd6, 0x8a, 0x99, 0xa2, 0x77, 0x1e, 0xaa, 0x04, 0xd4, 0xb6, 0xa4, 0xdb, 0x1e, 0x27, 0x19, 0xe5,
+  0xea, 0x7f, 0xd3, 0x8a, 0x8d, 0x0c, 0xb4, 0x97, 0xd8, 0x77, 0xe2, 0x2c, 0x0f, 0xb4, 0xb7, 0x21,
+  0xff, 0x4e, 0x27, 0x56, 0x45, 0xec, 0xdf, 0x21, 0x9e, 0x75, 0xb6, 0x6e, 0xce, 0x59, 0x61, 0x74,
+  0xa0, 0x4f, 0x7b, 0xb1, 0xee, 0xe8, 0xff, 0x41, 0x2f, 0x3e, 0xcd, 0x92, 0xeb, 0xc5, 0x8f, 0x1a,
+  0xb1, 0x78, 0xa9, 0x11, 0xf3, 0xff, 0xba, 0x11, 0x2b, 0xec, 0x7f, 0x15, 0xfa, 0xb0, 0xbf, 0xff,
+  0x71, 0x1b, 0x76, 0x18, 0x54, 0x19, 0x77, 0xa5, 0x08, 0xaf, 0x84, 0xc5, 0x01, 0xfb, 0x55, 0x8d,
+  0x95, 0x56, 0xfe, 0xbd, 0x75, 0xac, 0xd0, 0x8c, 0x8c, 0x99, 0x48, 0x70, 0xc8, 0xb1, 0x82, 0x6f,
+  0x6a, 0xe2, 0xf8, 0x82, 0x44, 0x3a, 0x2e, 0x9f, 0x4a, 0xc4, 0x7b, 0x3c, 0x0e, 0x1b, 0x12, 0x06,
+  0x98, 0x41, 0xf4, 0x70, 0x35, 0x70, 0xbc, 0x83, 0xc8, 0x9d, 0x88, 0xae, 0x06, 0x28, 0x82, 0x1c,
+  0x4f, 0xfe, 0x4c, 0xd4, 0x3f, 0x6e, 0x69, 0x05, 0xa0, 0x7b, 0xde, 0x46, 0xe1, 0xf1, 0x9e, 0x61,
+  0xbb, 0xa3, 0x7f, 0x8d, 0xf1, 0xd2, 0xaa, 0xcc, 0xb5, 0xa3, 0xcc, 0xd3, 0xb4, 0x2b, 0xab, 0xf4,
+  0x34, 0x01, 0x1f, 0x5e, 0xc6, 0xb5, 0x3b, 0x1b, 0x38, 0x7a, 0x32, 0xe9, 0x47, 0xc6, 0x4e, 0xd4,
+  0x19, 0x11, 0x9c, 0x6a, 0x27, 0xde, 0xd9, 0x21, 0x61, 0x72, 0x54, 0x93, 0x31, 0x4f, 0x3d, 0x4f,
+  0x30, 0xe3, 0x3b, 0xf1, 0x94, 0xde, 0xd6, 0x42, 0x51, 0x62, 0xb4, 0x9e, 0x64, 0x00, 0x76, 0x31,
+  0x16, 0x68, 0x5c, 0x9c, 0x2a, 0x30, 0x3f, 0xa9, 0xc0, 0x5c, 0xc5, 0xf9, 0x35, 0xb0, 0xc8, 0x1d,
+  0x22, 0x79, 0x87, 0x24, 0x41, 0xa5, 0x98, 0x19, 0x4d, 0xdb, 0xb6, 0x70, 0x53, 0x45, 0x37, 0xe5,
+  0xdf, 0x6b, 0xb9, 0xba, 0x16, 0xae, 0xf2, 0x7a, 0x1a, 0x60, 0xa6, 0x28, 0x7f, 0xc8, 0x14, 0xbd,
+  0x96, 0x63, 0x77, 0x88, 0xfe, 0xbd, 0x04, 0xe7, 0x23, 0x61, 0x26, 0x5a, 0x58, 0xf4, 0x31, 0xaa,
+  0x4f, 0xf2, 0x58, 0x9f, 0x30, 0x59, 0x50, 0x53, 0xbf, 0xa6, 0x93, 0x4e, 0xc1, 0x3c, 0x0d, 0xd1,
+  0xa2, 0x43, 0x02, 0x33, 0x80, 0x82, 0x18, 0xe7, 0x38, 0xb3, 0xe0, 0xe4, 0xa2, 0x49, 0x82, 0x62,
+  0x8e, 0x04, 0xa0, 0xe2, 0x36, 0x76, 0xab, 0xc6, 0x38, 0x79, 0x71, 0x3d, 0xa1, 0x23, 0x97, 0x19,
+  0x6b, 0x1c, 0x55, 0x80, 0x17, 0xb2, 0x65, 0xc9, 0x33, 0x32, 0x56, 0x3b, 0xd7, 0xfb, 0x7a, 0xef,
+  0x04, 0xa2, 0xbf, 0x38, 0x17, 0x9d, 0x87, 0xc7, 0xb7, 0x28, 0xe5, 0x88, 0x5b, 0xa4, 0x99, 0xa7,
+  0x7e, 0xae, 0x0b, 0x69, 0x08, 0xfc, 0x70, 0xd1, 0x13, 0x1c, 0x73, 0xdd, 0xe9, 0xb3, 0x3a, 0x1c,
+  0x2f, 0x27, 0xe7, 0xe5, 0xfe, 0x33, 0xdb, 0x93, 0x73, 0x74, 0xff, 0x51, 0x8a, 0xc6, 0x97, 0xfc,
+  0xcd, 0xbb, 0x66, 0x3d, 0xaf, 0x16, 0xfb, 0x6d, 0x19, 0xed, 0xca, 0x7d, 0x74, 0x79, 0xbb, 0x7d,
+  0x13, 0xfd, 0xb5, 0x8a, 0x6f, 0xaa, 0x08, 0x03, 0x7b, 0x1b, 0xd1, 0x97, 0x04, 0x7b, 0x39, 0x04,
+  0xe3, 0x39, 0x25, 0xdd, 0xd7, 0x17, 0x92, 0x35, 0xc7, 0x7d, 0x64, 0xdd, 0x47, 0xa4, 0xab, 0xc1,
+  0x70, 0x51, 0xb6, 0x83, 0x68, 0x55, 0xb6, 0xcb, 0x06, 0xc0, 0xa0, 0x07, 0x70, 0xb8, 0x2f, 0x3f,
+  0x11, 0xf8, 0xae, 0x06, 0xbb, 0x5d, 0x35, 0x1b, 0xbc, 0xf9, 0xa5, 0x59, 0x95, 0x38, 0xfe, 0x46,
+  0xdb, 0x72, 0x56, 0x7a, 0xad, 0x97, 0x43, 0xc7, 0x04, 0x66, 0xf7, 0x1d, 0x24, 0x6a, 0x1f, 0x36,
+  0x38, 0x16, 0xd3, 0x57, 0xb0, 0x81, 0x3b, 0x37, 0xbb, 0x75, 0x91, 0x3f, 0x2c, 0xfb, 0xfb, 0x6d,
+  0xf9, 0x65, 0x5f, 0x41, 0xc0, 0x63, 0xf9, 0x1b, 0x98, 0x77, 0xd7, 0x6c, 0xa1, 0xe3, 0x53, 0xb9,
+  0x5e, 0xda, 0xd1, 0x4b, 0x72, 0x7b, 0xfe, 0x20, 0xfb, 0xf8, 0x7c, 0x5e, 0xfe, 0xb4, 0x59, 0x6d,
+  0xec, 0xfa, 0xe1, 0x17, 0x30, 0x1f, 0xdd, 0x28, 0x57, 0x9b, 0x6d, 0xb9, 0x7b, 0x59, 0xd9, 0xe9,
+  0xe2, 0xa0, 0xef, 0xd1, 0xd0, 0x79, 0x95, 0xb3, 0xf2, 0x50, 0x4d, 0xcb, 0x0f, 0x7d, 0xd8, 0x9a,
+  0x88, 0xbe, 0xbd, 0x34, 0xbb, 0xaa, 0xad, 0x0e, 0xcd, 0x8b, 0x3a, 0xfb, 0xd5, 0x41, 0xe1, 0xf1,
+  0xf9, 0xbc, 0xb6, 0xba, 0x99, 0xda, 0xfa, 0x0f, 0x25, 0x32, 0xfb, 0x6e, 0x69, 0x0f, 0xce, 0xbd,
+  0xeb, 0x8f, 0x1f, 0x22, 0x37, 0x1c, 0xfd, 0xb4, 0xfa, 0x5d, 0x65, 0xa7, 0xfb, 0xb6, 0xbc, 0x58,
+  0x57, 0xab, 0x26, 0xe2, 0x26, 0x9a, 0xda, 0x2d, 0x52, 0x5f, 0xc2, 0xfd, 0xdf, 0xbf, 0x68, 0x4a,
+  0x2f, 0x3a, 0x98, 0x72, 0x7c, 0x5e, 0x55, 0xeb, 0xba, 0x5c, 0x2f, 0x5c, 0xc5, 0x34, 0x8f, 0x2c,
+  0x3b, 0xc1, 0xdc, 0xe9, 0xd7, 0xb2, 0xc1, 0x13, 0x25, 0x3b, 0x37, 0x37, 0x88, 0x0e, 0xb6, 0xde,
+  0xe3, 0xf1, 0x93, 0xad, 0x0f, 0xd6, 0x7d, 0x48, 0xea, 0xb6, 0x09, 0x81, 0xf4, 0xd9, 0xae, 0x19,
+  0xd2, 0x47, 0x29, 0xba, 0xba, 0x0f, 0xf1, 0xff, 0x06, 0x95, 0xdf, 0xab, 0xfb, 0x9f, 0x17, 0x00,
+  0x00,
+};
+
+#endif
@@ -0,0 +1,481 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do Arduino.h para os testes no host: String, Print, ##
+##   Stream, Serial, ESP e GPIO, com relógio simulado. delay()      ##
+##   avança o relógio em vez de esperar.                            ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestArduino_h
+#define RemoteIOTestArduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <functional>
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (s)
+#define vsnprintf_P vsnprintf
+#define snprintf_P snprintf
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x00
+#define INPUT_PULLUP 0x02
+#define OUTPUT 0x01
+#define CHANGE 0x03
+#define FALLING 0x02
+#define RISING 0x01
+#define A0 17
+
+#define STUB_PIN_COUNT 18   // GPIO0 a GPIO16 e A0
+
+// os testes avançam o relógio escrevendo aqui
+inline uint32_t stubMillis = 0;
+inline uint32_t stubMicros = 0;   // fração de milissegundo, avançada por delayMicroseconds()
+inline uint32_t stubRandomSeed = 1;
+
+inline unsigned long millis()
+{
+  return stubMillis;
+}
+
+inline unsigned long micros()
+{
+  return (unsigned long)(stubMillis * 1000UL + stubMicros);
+}
+
+// chamadas bloqueantes do firmware aparecem como tempo simulado gasto dentro do loop()
+inline void delay(unsigned long ms)
+{
+  stubMillis += ms;
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+  stubMicros += us;
+  stubMillis += stubMicros / 1000;
+  stubMicros %= 1000;
+}
+
+inline void yield()
+{
+}
+
+// LCG determinístico: a sequência se repete a cada execução do teste
+inline long secureRandom(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) return howsmall;
+
+  stubRandomSeed = stubRandomSeed * 1103515245 + 12345;
+  return howsmall + (long)((stubRandomSeed >> 8) % (uint32_t)(howbig - howsmall));
+}
+
+inline long secureRandom(long howbig)
+{
+  return secureRandom(0, howbig);
+}
+
+// alocações feitas pelo firmware no host (String e operator new, contados pelos testes que os sobrescrevem)
+struct StubHeap
+{
+  uint32_t allocations;
+  uint64_t bytes;
+};
+inline StubHeap stubHeap = { 0, 0 };
+
+/* ### String ### */
+
+class String
+{
+  public:
+    String() {}
+    String(const char *text) { if (text != nullptr) data = text; }
+    String(const String &other) : data(other.data) {}
+    String(String &&other) : data(std::move(other.data)) {}
+    explicit String(char c) : data(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(int value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned int value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(float value, unsigned char decimals = 2) { fromDouble(value, decimals); }
+    explicit String(double value, unsigned char decimals = 2) { fromDouble(value, decimals); }
+
+    String &operator=(const String &other) { data = other.data; return *this; }
+    String &operator=(String &&other) { data = std::move(other.data); return *this; }
+    String &operator=(const char *text) { if (text == nullptr) data.clear(); else data = text; return *this; }
+
+    const char *c_str() const { return data.c_str(); }
+    unsigned int length() const { return data.size(); }
+    bool isEmpty() const { return data.empty(); }
+    bool reserve(unsigned int size) { data.reserve(size); return true; }
+    char operator[](unsigned int index) const { return (index < data.size()) ? data[index] : '\0'; }
+    char &operator[](unsigned int index) { return data[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    // como no core: concat(const char *) para no primeiro NUL; a versão com tamanho copia tudo
+    bool concat(const char *text) { if (text != nullptr) data += text; return true; }
+    bool concat(const char *text, unsigned int length) { data.append(text, length); return true; }
+    bool concat(const String &other) { data += other.data; return true; }
+    bool concat(char c) { data += c; return true; }
+    bool concat(int value) { return concat(String(value)); }
+    bool concat(unsigned int value) { return concat(String(value)); }
+    bool concat(long value) { return concat(String(value)); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+
+    String &operator+=(const String &other) { concat(other); return *this; }
+    String &operator+=(const char *text) { concat(text); return *this; }
+    String &operator+=(char c) { concat(c); return *this; }
+    String &operator+=(int value) { concat(value); return *this; }
+    String &operator+=(unsigned int value) { concat(value); return *this; }
+    String &operator+=(long value) { concat(value); return *this; }
+    String &operator+=(unsigned long value) { concat(value); return *this; }
+
+    bool equals(const char *text) const { return data == (text != nullptr ? text : ""); }
+    bool equals(const String &other) const { return data == other.data; }
+    bool equalsIgnoreCase(const String &other) const { return strcasecmp(c_str(), other.c_str()) == 0; }
+    bool operator==(const String &other) const { return equals(other); }
+    bool operator==(const char *text) const { return equals(text); }
+    bool operator!=(const String &other) const { return !equals(other); }
+    bool operator!=(const char *text) const { return !equals(text); }
+    bool operator<(const String &other) const { return data < other.data; }
+
+    bool startsWith(const String &prefix) const { return data.compare(0, prefix.data.size(), prefix.data) == 0; }
+    bool startsWith(const char *prefix) const { return startsWith(String(prefix)); }
+    bool endsWith(const String &suffix) const { return (data.size() >= suffix.data.size()) && (data.compare(data.size() - suffix.data.size(), suffix.data.size(), suffix.data) == 0); }
+
+    int indexOf(char c, unsigned int from = 0) const { size_t i = data.find(c, from); return (i == std::string::npos) ? -1 : (int)i; }
+    int indexOf(const char *text, unsigned int from = 0) const { size_t i = data.find(text, from); return (i == std::string::npos) ? -1 : (int)i; }
+    int indexOf(const String &text, unsigned int from = 0) const { return indexOf(text.c_str(), from); }
+    int lastIndexOf(char c) const { size_t i = data.rfind(c); return (i == std::string::npos) ? -1 : (int)i; }
+
+    String substring(unsigned int from) const { return substring(from, data.size()); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+      if (from > to) { unsigned int swap = from; from = to; to = swap; }
+      if (from >= data.size()) return String();
+      if (to > data.size()) to = data.size();
+      String result;
+      result.data = data.substr(from, to - from);
+      return result;
+    }
+
+    void replace(const char *find, const char *replacement)
+    {
+      size_t findLength = strlen(find);
+      if (findLength == 0) return;
+      for (size_t i = data.find(find); i != std::string::npos; i = data.find(find, i + strlen(replacement))) data.replace(i, findLength, replacement);
+    }
+    void replace(const String &find, const String &replacement) { replace(find.c_str(), replacement.c_str()); }
+    void remove(unsigned int index) { if (index < data.size()) data.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < data.size()) data.erase(index, count); }
+    void toLowerCase() { for (char &c : data) c = tolower((unsigned char)c); }
+    void toUpperCase() { for (char &c : data) c = toupper((unsigned char)c); }
+    void trim()
+    {
+      size_t begin = data.find_first_not_of(" \t\r\n");
+      if (begin == std::string::npos) { data.clear(); return; }
+      data = data.substr(begin, data.find_last_not_of(" \t\r\n") - begin + 1);
+    }
+    long toInt() const { return strtol(data.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(data.c_str(), nullptr); }
+
+  private:
+    void fromSigned(long long value, unsigned char base)
+    {
+      if ((value < 0) && (base == 10)) { fromUnsigned((unsigned long long)(-value), base); data.insert(data.begin(), '-'); }
+      else fromUnsigned((unsigned long long)value, base);
+    }
+    void fromUnsigned(unsigned long long value, unsigned char base)
+    {
+      char buffer[68];
+      int i = sizeof(buffer) - 1;
+      buffer[i] = '\0';
+      do { buffer[--i] = "0123456789abcdefghijklmnopqrstuvwxyz"[value % base]; value /= base; } while (value > 0);
+      data = &buffer[i];
+    }
+    void fromDouble(double value, unsigned char decimals)
+    {
+      char buffer[48];
+      snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+      data = buffer;
+    }
+
+    std::string data;
+};
+
+class StringSumHelper : public String
+{
+  public:
+    StringSumHelper(const String &text) : String(text) {}
+    StringSumHelper(const char *text) : String(text) {}
+};
+
+inline StringSumHelper operator+(const StringSumHelper &left, const String &right) { StringSumHelper result(left); result.concat(right); return result; }
+inline StringSumHelper operator+(const StringSumHelper &left, const char *right) { StringSumHelper result(left); result.concat(right); return result; }
+inline StringSumHelper operator+(const StringSumHelper &left, char right) { StringSumHelper result(left); result.concat(right); return result; }
+inline StringSumHelper operator+(const char *left, const String &right) { StringSumHelper result(left); result.concat(right); return result; }
+inline bool operator==(const char *left, const String &right) { return right == left; }
+inline bool operator!=(const char *left, const String &right) { return right != left; }
+
+/* ### Print e Stream ### */
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+      size_t n = 0;
+      while ((n < size) && write(buffer[n])) n++;
+      return n;
+    }
+    size_t write(const char *text) { return (text == nullptr) ? 0 : write((const uint8_t *)text, strlen(text)); }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char *text) { return write(text); }
+    size_t print(const String &text) { return write((const uint8_t *)text.c_str(), text.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, (unsigned char)decimals)); }
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T &value) { size_t n = print(value); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+      char buffer[256];
+      va_list args;
+      va_start(args, format);
+      int length = vsnprintf(buffer, sizeof(buffer), format, args);
+      va_end(args);
+
+      if (length < 0) return 0;
+      if (length < (int)sizeof(buffer)) return write((const uint8_t *)buffer, length);
+
+      std::string large(length + 1, '\0');
+      va_start(args, format);
+      vsnprintf(&large[0], large.size(), format, args);
+      va_end(args);
+      return write((const uint8_t *)large.data(), length);
+    }
+};
+
+// Sem espera nas leituras: readBytes() e find() só consomem o que já está disponível,
+// como um Stream do core cujo timeout venceu. Quem quiser esperar avança o relógio.
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { streamTimeout = timeout; }
+    unsigned long getTimeout() const { return streamTimeout; }
+
+    size_t readBytes(char *buffer, size_t length)
+    {
+      size_t n = 0;
+      while (n < length)
+      {
+        int c = read();
+        if (c < 0) break;
+        buffer[n++] = (char)c;
+      }
+      return n;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+
+    bool find(const char *target) { return findUntil(target, nullptr); }
+    bool find(char target) { char text[2] = { target, '\0' }; return find(text); }
+
+    bool findUntil(const char *target, const char *terminator)
+    {
+      size_t targetLength = strlen(target);
+      size_t terminatorLength = (terminator != nullptr) ? strlen(terminator) : 0;
+      size_t matched = 0;
+      size_t terminatorMatched = 0;
+
+      while (true)
+      {
+        int c = read();
+        if (c < 0) return false;
+
+        matched = (c == target[matched]) ? matched + 1 : ((c == target[0]) ? 1 : 0);
+        if (matched == targetLength) return true;
+
+        if (terminatorLength > 0)
+        {
+          terminatorMatched = (c == terminator[terminatorMatched]) ? terminatorMatched + 1 : ((c == terminator[0]) ? 1 : 0);
+          if (terminatorMatched == terminatorLength) return false;
+        }
+      }
+    }
+
+    String readStringUntil(char terminator)
+    {
+      String text;
+      int c;
+      while (((c = read()) >= 0) && (c != terminator)) text += (char)c;
+      return text;
+    }
+
+    String readString()
+    {
+      String text;
+      int c;
+      while ((c = read()) >= 0) text += (char)c;
+      return text;
+    }
+
+  protected:
+    unsigned long streamTimeout = 1000;
+};
+
+/* ### Serial e ESP ### */
+
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long baud) { this->baud = baud; }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+      if (echo) fwrite(buffer, 1, size, stdout);
+      written += size;
+      return size;
+    }
+    int availableForWrite() override { return 128; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    bool echo = false;    // true: o log do firmware aparece na saída do teste
+    unsigned long baud = 0;
+    uint64_t written = 0;
+};
+
+inline HardwareSerial Serial;
+
+class EspClass
+{
+  public:
+    uint32_t getFreeHeap() { return freeHeap; }
+    uint32_t getMaxFreeBlockSize() { return freeHeap / 2; }
+    uint8_t getHeapFragmentation() { return 10; }
+    uint32_t getFreeContStack() { return 2048; }
+    uint32_t getChipId() { return 0x00C0FFEE; }
+
+    // no host não há reinício: o teste confere o contador e refaz o objeto se precisar
+    void restart() { restarts++; }
+
+    uint32_t freeHeap = 40000;
+    uint32_t restarts = 0;
+};
+
+inline EspClass ESP;
+
+/* ### GPIO ### */
+
+struct StubPins
+{
+  uint8_t mode[STUB_PIN_COUNT];
+  int level[STUB_PIN_COUNT];        // nível escrito pelo firmware ou imposto pelo teste nas entradas
+  uint32_t writes[STUB_PIN_COUNT];
+  uint32_t writtenAt[STUB_PIN_COUNT];   // micros() da última escrita
+  void (*isr[STUB_PIN_COUNT])(void *);
+  void *isrArg[STUB_PIN_COUNT];
+  uint32_t analogReads;
+};
+
+inline StubPins stubPins = {};
+inline int stubAnalogValue = 0;
+
+inline void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < STUB_PIN_COUNT) stubPins.mode[pin] = mode;
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t level)
+{
+  if (pin >= STUB_PIN_COUNT) return;
+
+  stubPins.level[pin] = level ? HIGH : LOW;
+  stubPins.writes[pin]++;
+  stubPins.writtenAt[pin] = micros();
+}
+
+inline int digitalRead(uint8_t pin)
+{
+  return (pin < STUB_PIN_COUNT) ? stubPins.level[pin] : LOW;
+}
+
+inline int analogRead(uint8_t pin)
+{
+  stubPins.analogReads++;
+  return stubAnalogValue;
+}
+
+inline void attachInterruptArg(uint8_t pin, void (*isr)(void *), void *arg, int mode)
+{
+  if (pin >= STUB_PIN_COUNT) return;
+
+  stubPins.isr[pin] = isr;
+  stubPins.isrArg[pin] = arg;
+}
+
+inline void detachInterrupt(uint8_t pin)
+{
+  if (pin < STUB_PIN_COUNT) stubPins.isr[pin] = nullptr;
+}
+
+// muda o nível de uma entrada e dispara a interrupção registrada nela, como uma borda real
+inline void stubSetInput(uint8_t pin, int level)
+{
+  if ((pin >= STUB_PIN_COUNT) || (stubPins.level[pin] == level)) return;
+
+  stubPins.level[pin] = level;
+  if (stubPins.isr[pin] != nullptr) stubPins.isr[pin](stubPins.isrArg[pin]);
+}
+
+inline void configTime(long gmtOffset, int daylightOffset, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr)
+{
+}
+
+// relógio de parede: o do host, ou, com o SNTP ainda sem resposta, segundos desde o boot como no core
+inline bool stubClockSynced = true;
+
+inline time_t stubTime(time_t *result)
+{
+  time_t now = stubClockSynced ? ::time(nullptr) : (time_t)(millis() / 1000);
+  if (result != nullptr) *result = now;
+  return now;
+}
+#define time(result) stubTime(result)
+
+#endif
@@ -0,0 +1,15 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do AsyncJson.h para os testes no host.              ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestAsyncJson_h
+#define RemoteIOTestAsyncJson_h
+
+#include <ESPAsyncWebServer.h>
+
+#endif
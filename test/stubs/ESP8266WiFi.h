@@ -0,0 +1,297 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do ESP8266WiFi.h para os testes no host: uma rede   ##
+##   simulada em stubNetwork, com tempo de associação, DHCP e DNS.  ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestESP8266WiFi_h
+#define RemoteIOTestESP8266WiFi_h
+
+#include <Arduino.h>
+
+typedef enum
+{
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} WiFiMode_t;
+
+class IPAddress
+{
+  public:
+    IPAddress() : address(0) {}
+    IPAddress(uint32_t address) : address(address) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+
+    operator uint32_t() const { return address; }
+    bool isSet() const { return address != 0; }
+
+    String toString() const
+    {
+      char text[16];
+      snprintf(text, sizeof(text), "%u.%u.%u.%u", address & 0xFF, (address >> 8) & 0xFF, (address >> 16) & 0xFF, address >> 24);
+      return String(text);
+    }
+
+    bool fromString(const char *text)
+    {
+      unsigned int a, b, c, d;
+      char tail;
+      if (sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4) return false;
+      if ((a > 255) || (b > 255) || (c > 255) || (d > 255)) return false;
+      address = a | (b << 8) | (c << 16) | ((uint32_t)d << 24);
+      return true;
+    }
+    bool fromString(const String &text) { return fromString(text.c_str()); }
+
+  private:
+    uint32_t address;
+};
+
+// a rede vista pelo dispositivo; os testes mudam canal, BSSID ou sub-rede para simular trocas no AP
+struct StubNetwork
+{
+  bool up = true;                   // AP no ar
+  bool dns = true;                  // servidor DNS responde
+  String ssid = "remoteio-lab";
+  String password = "remoteio-pass";
+  uint8_t bssid[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+  int32_t channel = 6;
+  uint32_t ip = IPAddress(10, 0, 0, 50);
+  uint32_t gateway = IPAddress(10, 0, 0, 1);
+  uint32_t subnet = IPAddress(255, 255, 255, 0);
+  uint32_t scanJoinTime = 3000;     // ms da associação com busca de canais e DHCP
+  uint32_t directJoinTime = 250;    // ms da associação direta, com IP fixo
+
+  uint32_t joins = 0;               // chamadas a WiFi.begin()
+  uint32_t dnsLookups = 0;
+};
+
+inline StubNetwork stubNetwork;
+
+class ESP8266WiFiClass
+{
+  public:
+    wl_status_t status()
+    {
+      if (!joining || !stubNetwork.up || !credentialsMatch) return WL_DISCONNECTED;
+      return (millis() - joinStart >= joinTime) ? WL_CONNECTED : WL_DISCONNECTED;
+    }
+
+    bool mode(WiFiMode_t mode) { currentMode = mode; return true; }
+    WiFiMode_t getMode() { return currentMode; }
+
+    bool softAP(const char *ssid, const char *password = nullptr) { softAPSsid = ssid; return true; }
+    bool softAPConfig(IPAddress local, IPAddress gateway, IPAddress subnet) { softAPAddress = local; return true; }
+    IPAddress softAPIP() { return softAPAddress; }
+
+    bool setHostname(const char *name) { hostname = name; return true; }
+
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0, IPAddress dns2 = (uint32_t)0)
+    {
+      staticIp = local;
+      staticGateway = gateway;
+      staticSubnet = subnet;
+      return true;
+    }
+
+    wl_status_t begin(const String &ssid, const String &password, int32_t channel = 0, const uint8_t *bssid = nullptr, bool connect = true)
+    {
+      stubNetwork.joins++;
+      joining = true;
+      joinStart = millis();
+
+      bool directed = (channel != 0) && (bssid != nullptr);
+      credentialsMatch = (ssid == stubNetwork.ssid) && (password == stubNetwork.password);
+      if (directed) credentialsMatch = credentialsMatch && (channel == stubNetwork.channel) && (memcmp(bssid, stubNetwork.bssid, 6) == 0);
+      joinTime = directed ? stubNetwork.directJoinTime : stubNetwork.scanJoinTime;
+      return WL_DISCONNECTED;
+    }
+
+    bool disconnect(bool wifiOff = false)
+    {
+      joining = false;
+      return true;
+    }
+
+    uint8_t *BSSID() { return stubNetwork.bssid; }
+    int32_t channel() { return stubNetwork.channel; }
+    IPAddress localIP() { return (status() != WL_CONNECTED) ? IPAddress() : (staticIp ? IPAddress(staticIp) : IPAddress(stubNetwork.ip)); }
+    IPAddress gatewayIP() { return staticIp ? staticGateway : stubNetwork.gateway; }
+    IPAddress subnetMask() { return staticIp ? staticSubnet : stubNetwork.subnet; }
+    IPAddress dnsIP(uint8_t index = 0) { return stubNetwork.gateway; }
+    String macAddress() { return String("02:00:00:00:00:42"); }
+    int32_t RSSI() { return -60; }
+
+    // o tráfego só passa com o endereço na sub-rede atual do AP: um IP fixo velho associa, mas não roteia
+    bool routable()
+    {
+      if (status() != WL_CONNECTED) return false;
+
+      uint32_t address = staticIp ? staticIp : stubNetwork.ip;
+      return (address & stubNetwork.subnet) == (stubNetwork.gateway & stubNetwork.subnet);
+    }
+
+    int hostByName(const char *host, IPAddress &result, uint32_t timeout = 10000)
+    {
+      stubNetwork.dnsLookups++;
+
+      if (!routable() || !stubNetwork.dns)
+      {
+        result = IPAddress();
+        return 0;
+      }
+      result = IPAddress(10, 0, 0, 2);
+      return 1;
+    }
+
+    String hostname;
+    String softAPSsid;
+
+  private:
+    bool joining = false;
+    bool credentialsMatch = false;
+    uint32_t joinStart = 0;
+    uint32_t joinTime = 0;
+    uint32_t staticIp = 0;
+    uint32_t staticGateway = 0;
+    uint32_t staticSubnet = 0;
+    WiFiMode_t currentMode = WIFI_OFF;
+    IPAddress softAPAddress;
+};
+
+inline ESP8266WiFiClass WiFi;
+
+// Servidor do outro lado dos sockets (a plataforma simulada, em FakeNodeIoT.h). respond()
+// consome uma requisição completa de request e devolve a resposta; false enquanto falta algo.
+class StubServer
+{
+  public:
+    virtual ~StubServer() {}
+    virtual bool respond(std::string &request, std::string &response, bool &close) = 0;
+
+    bool online = true;           // aceita conexões
+    uint32_t latency = 0;         // ms entre a requisição e o primeiro byte da resposta
+    uint32_t idleTimeout = 0;     // ms sem tráfego até o servidor fechar uma conexão keep-alive, 0 para nunca
+    uint32_t connections = 0;
+};
+
+inline StubServer *stubServer = nullptr;
+
+class WiFiClient : public Stream
+{
+  public:
+    virtual ~WiFiClient() {}
+
+    virtual int connect(const char *host, uint16_t port)
+    {
+      IPAddress address;
+
+      stop();
+      if (!WiFi.hostByName(host, address) || (stubServer == nullptr) || !stubServer->online) return 0;
+
+      stubServer->connections++;
+      open = true;
+      lastActivity = millis();
+      return 1;
+    }
+    int connect(const String &host, uint16_t port) { return connect(host.c_str(), port); }
+
+    uint8_t connected()
+    {
+      if (!open) return 0;
+
+      // o servidor fechou a conexão ociosa (FIN): o que já chegou ainda pode ser lido
+      if (!closing && (stubServer != nullptr) && (stubServer->idleTimeout > 0) && (millis() - lastActivity >= stubServer->idleTimeout) && (unread() == 0)) closing = true;
+      if (!WiFi.routable()) closing = true;
+      return (closing && (unread() == 0)) ? 0 : 1;
+    }
+
+    int available() override
+    {
+      if (!open || ((int32_t)(millis() - readyAt) < 0)) return 0;
+      return unread();
+    }
+
+    int read() override { return available() ? (uint8_t)rx[rxOffset++] : -1; }
+    int peek() override { return available() ? (uint8_t)rx[rxOffset] : -1; }
+
+    int read(uint8_t *buffer, size_t size)
+    {
+      size_t n = 0;
+      while ((n < size) && available()) buffer[n++] = rx[rxOffset++];
+      return n;
+    }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+      if (!connected() || closing) return 0;
+
+      tx.append((const char *)buffer, size);
+      bytesSent += size;
+      lastActivity = millis();
+
+      std::string response;
+      bool close = false;
+
+      while ((stubServer != nullptr) && stubServer->respond(tx, response, close))
+      {
+        compact();
+        rx += response;
+        readyAt = millis() + stubServer->latency;
+        lastActivity = readyAt;
+        if (close) closing = true;
+        response.clear();
+      }
+      return size;
+    }
+    using Print::write;
+
+    int availableForWrite() override { return open ? 1460 : 0; }
+
+    void stop()
+    {
+      open = false;
+      closing = false;
+      rx.clear();
+      tx.clear();
+      rxOffset = 0;
+    }
+
+    void setNoDelay(bool noDelay) {}
+
+    uint64_t bytesSent = 0;
+
+  protected:
+    int unread() { return rx.size() - rxOffset; }
+    void compact()
+    {
+      rx.erase(0, rxOffset);
+      rxOffset = 0;
+    }
+
+    bool open = false;
+    bool closing = false;
+    std::string rx;
+    size_t rxOffset = 0;
+    std::string tx;
+    uint32_t readyAt = 0;
+    uint32_t lastActivity = 0;
+};
+
+#endif
@@ -0,0 +1,28 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do ESP8266mDNS.h para os testes no host.            ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestESP8266mDNS_h
+#define RemoteIOTestESP8266mDNS_h
+
+#include <ESP8266WiFi.h>
+
+class MDNSResponder
+{
+  public:
+    bool begin(const String &hostname) { this->hostname = hostname; return true; }
+    bool addService(const char *service, const char *protocol, uint16_t port) { services++; return true; }
+    void update() {}
+
+    String hostname;
+    uint32_t services = 0;
+};
+
+inline MDNSResponder MDNS;
+
+#endif
@@ -0,0 +1,16 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do ESPAsyncTCP.h para os testes no host: o servidor ##
+##   local simulado fica em ESPAsyncWebServer.h.                    ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestESPAsyncTCP_h
+#define RemoteIOTestESPAsyncTCP_h
+
+#include <ESP8266WiFi.h>
+
+#endif
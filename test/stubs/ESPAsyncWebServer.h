@@ -0,0 +1,340 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do ESPAsyncWebServer.h para os testes no host: as   ##
+##   rotas registradas ficam numa tabela, e o teste faz requisições ##
+##   e abre clientes websocket chamando os handlers diretamente.    ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestESPAsyncWebServer_h
+#define RemoteIOTestESPAsyncWebServer_h
+
+#include <ESP8266WiFi.h>
+#include <vector>
+#include <memory>
+
+typedef enum
+{
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_DELETE = 0b00000100,
+  HTTP_PUT = 0b00001000,
+  HTTP_ANY = 0b01111111
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebParameter
+{
+  public:
+    AsyncWebParameter(const String &name, const String &value) : parameterName(name), parameterValue(value) {}
+    const String &name() const { return parameterName; }
+    const String &value() const { return parameterValue; }
+
+  private:
+    String parameterName;
+    String parameterValue;
+};
+
+class AsyncWebHeader
+{
+  public:
+    AsyncWebHeader(const String &name, const String &value) : headerName(name), headerValue(value) {}
+    const String &name() const { return headerName; }
+    const String &value() const { return headerValue; }
+
+  private:
+    String headerName;
+    String headerValue;
+};
+
+class AsyncWebServerResponse
+{
+  public:
+    AsyncWebServerResponse(int code, const String &contentType, const String &content) : code(code), contentType(contentType), body(content) {}
+    virtual ~AsyncWebServerResponse() {}
+
+    void addHeader(const String &name, const String &value) { headers.push_back(AsyncWebHeader(name, value)); }
+
+    String header(const char *name) const
+    {
+      for (const AsyncWebHeader &header : headers) if (header.name().equalsIgnoreCase(name)) return header.value();
+      return String();
+    }
+
+    int code;
+    String contentType;
+    String body;
+    std::vector<AsyncWebHeader> headers;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print
+{
+  public:
+    AsyncResponseStream(const String &contentType) : AsyncWebServerResponse(200, contentType, String()) {}
+
+    size_t write(uint8_t c) override { body.concat((char)c); return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { body.concat((const char *)buffer, size); return size; }
+    using Print::write;
+};
+
+class AsyncWebServerRequest
+{
+  public:
+    AsyncWebServerRequest(WebRequestMethodComposite method, const String &url) : requestMethod(method), requestUrl(url) {}
+
+    // lado do teste
+    AsyncWebServerRequest &param(const String &name, const String &value) { params.push_back(AsyncWebParameter(name, value)); return *this; }
+    AsyncWebServerRequest &header(const String &name, const String &value) { headers.push_back(AsyncWebHeader(name, value)); return *this; }
+    AsyncWebServerRequest &credentials(const String &user, const String &password)
+    {
+      authUser = user;
+      authPassword = password;
+      hasCredentials = true;
+      return *this;
+    }
+
+    WebRequestMethodComposite method() const { return requestMethod; }
+    const String &url() const { return requestUrl; }
+
+    bool hasParam(const char *name) const { return getParam(name) != nullptr; }
+    const AsyncWebParameter *getParam(const char *name) const
+    {
+      for (const AsyncWebParameter &param : params) if (param.name() == name) return &param;
+      return nullptr;
+    }
+
+    const AsyncWebHeader *getHeader(const char *name) const
+    {
+      for (const AsyncWebHeader &header : headers) if (header.name().equalsIgnoreCase(name)) return &header;
+      return nullptr;
+    }
+
+    bool authenticate(const char *user, const char *password, const char *realm = nullptr, bool passwordIsHash = false)
+    {
+      return hasCredentials && (authUser == user) && (authPassword == password);
+    }
+
+    void requestAuthentication(const char *realm = nullptr, bool isDigest = true)
+    {
+      send(401, "text/plain", "");
+    }
+
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(), const String &content = String())
+    {
+      return new AsyncWebServerResponse(code, contentType, content);
+    }
+
+    AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content, size_t length)
+    {
+      String body;
+      body.concat((const char *)content, length);
+      return new AsyncWebServerResponse(code, contentType, body);
+    }
+
+    AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460)
+    {
+      return new AsyncResponseStream(contentType);
+    }
+
+    void send(AsyncWebServerResponse *response) { this->response.reset(response); }
+    void send(int code, const String &contentType = String(), const String &content = String())
+    {
+      send(new AsyncWebServerResponse(code, contentType, content));
+    }
+
+    std::unique_ptr<AsyncWebServerResponse> response;
+
+  private:
+    WebRequestMethodComposite requestMethod;
+    String requestUrl;
+    std::vector<AsyncWebParameter> params;
+    std::vector<AsyncWebHeader> headers;
+    String authUser;
+    String authPassword;
+    bool hasCredentials = false;
+};
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebHandler
+{
+  public:
+    virtual ~AsyncWebHandler() {}
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler
+{
+  public:
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+};
+
+/* ### WebSocket ### */
+
+#define WS_CONTINUATION 0x00
+#define WS_TEXT 0x01
+#define WS_BINARY 0x02
+
+typedef enum
+{
+  WS_EVT_CONNECT,
+  WS_EVT_DISCONNECT,
+  WS_EVT_PONG,
+  WS_EVT_ERROR,
+  WS_EVT_DATA
+} AwsEventType;
+
+typedef struct
+{
+  uint8_t message_opcode;
+  uint32_t num;
+  uint8_t final;
+  uint8_t masked;
+  uint8_t opcode;
+  uint64_t len;
+  uint8_t mask[4];
+  uint64_t index;
+} AwsFrameInfo;
+
+class AsyncWebSocket;
+
+class AsyncWebSocketClient
+{
+  public:
+    void text(const char *message) { received.push_back(String(message)); }
+    void text(const String &message) { received.push_back(message); }
+
+    std::vector<String> received;   // mensagens enviadas pelo dispositivo a este cliente
+    bool connected = true;
+};
+
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t length)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler
+{
+  public:
+    AsyncWebSocket(const String &url) : url(url) {}
+
+    void setAuthentication(const char *user, const char *password)
+    {
+      authUser = user;
+      authPassword = password;
+    }
+
+    void onEvent(AwsEventHandler handler) { this->handler = handler; }
+    size_t count() const { return clients.size(); }
+
+    void textAll(const char *message) { for (auto &client : clients) client->text(message); }
+    void textAll(const String &message) { textAll(message.c_str()); }
+    void cleanupClients(uint16_t maxClients = 8) {}
+
+    // lado do teste: abre um cliente com as credenciais da API local; nullptr se recusado
+    AsyncWebSocketClient *connect(const String &user, const String &password)
+    {
+      if ((authUser.length() > 0) && ((user != authUser) || (password != authPassword))) return nullptr;
+
+      clients.push_back(std::unique_ptr<AsyncWebSocketClient>(new AsyncWebSocketClient()));
+      AsyncWebSocketClient *client = clients.back().get();
+      if (handler) handler(this, client, WS_EVT_CONNECT, nullptr, nullptr, 0);
+      return client;
+    }
+
+    // entrega uma mensagem de texto completa, num único quadro, como faria a biblioteca
+    void receive(AsyncWebSocketClient *client, const String &message)
+    {
+      AwsFrameInfo info = {};
+      info.final = 1;
+      info.opcode = WS_TEXT;
+      info.message_opcode = WS_TEXT;
+      info.len = message.length();
+
+      std::vector<uint8_t> buffer(message.c_str(), message.c_str() + message.length());
+      if (handler) handler(this, client, WS_EVT_DATA, &info, buffer.data(), buffer.size());
+    }
+
+    String url;
+
+  private:
+    AwsEventHandler handler;
+    String authUser;
+    String authPassword;
+    std::vector<std::unique_ptr<AsyncWebSocketClient>> clients;
+};
+
+/* ### Servidor ### */
+
+class DefaultHeaders
+{
+  public:
+    static DefaultHeaders &Instance()
+    {
+      static DefaultHeaders instance;
+      return instance;
+    }
+
+    void addHeader(const String &name, const String &value) { headers.push_back(AsyncWebHeader(name, value)); }
+
+    std::vector<AsyncWebHeader> headers;
+};
+
+class AsyncWebServer;
+inline AsyncWebServer *stubWebServer = nullptr;   // último servidor criado, para os testes
+
+class AsyncWebServer
+{
+  public:
+    AsyncWebServer(uint16_t port) : port(port) { stubWebServer = this; }
+
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest)
+    {
+      routes.push_back(std::unique_ptr<AsyncCallbackWebHandler>(new AsyncCallbackWebHandler()));
+      AsyncCallbackWebHandler &route = *routes.back();
+      route.uri = uri;
+      route.method = method;
+      route.onRequest = onRequest;
+      return route;
+    }
+
+    void onNotFound(ArRequestHandlerFunction handler) { notFound = handler; }
+    void addHandler(AsyncWebHandler *handler) { handlers.push_back(handler); }
+    void begin() { started = true; }
+
+    // lado do teste: entrega a requisição à rota registrada, como o servidor assíncrono faria
+    void handle(AsyncWebServerRequest &request)
+    {
+      for (auto &route : routes)
+      {
+        if ((route->uri == request.url()) && (route->method & request.method()))
+        {
+          route->onRequest(&request);
+          return;
+        }
+      }
+      if (notFound) notFound(&request);
+    }
+
+    AsyncWebSocket *socket(const char *url)
+    {
+      for (AsyncWebHandler *handler : handlers)
+      {
+        AsyncWebSocket *socket = dynamic_cast<AsyncWebSocket *>(handler);
+        if ((socket != nullptr) && (socket->url == url)) return socket;
+      }
+      return nullptr;
+    }
+
+    uint16_t port;
+    bool started = false;
+
+  private:
+    std::vector<std::unique_ptr<AsyncCallbackWebHandler>> routes;
+    std::vector<AsyncWebHandler *> handlers;
+    ArRequestHandlerFunction notFound;
+};
+
+#endif
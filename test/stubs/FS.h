@@ -0,0 +1,207 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do FS.h para os testes no host: sistema de arquivos ##
+##   em memória, com corte de energia simulado no meio da gravação  ##
+##   e rename() com a semântica do SPIFFS.                          ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestFS_h
+#define RemoteIOTestFS_h
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+class FS;
+
+enum SeekMode
+{
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File : public Stream
+{
+  public:
+    File() {}
+    File(FS *owner, const std::string &path, std::shared_ptr<std::vector<uint8_t>> data, bool readable, bool writable, size_t position) :
+      owner(owner), path(path), data(data), readable(readable), writable(writable), offset(position) {}
+
+    explicit operator bool() const { return data != nullptr; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    int available() override { return (data && readable && (offset < data->size())) ? (int)(data->size() - offset) : 0; }
+    int read() override { return available() ? (*data)[offset++] : -1; }
+    int peek() override { return available() ? (*data)[offset] : -1; }
+
+    size_t read(uint8_t *buffer, size_t size)
+    {
+      size_t n = 0;
+      while ((n < size) && available()) buffer[n++] = (*data)[offset++];
+      return n;
+    }
+
+    bool seek(uint32_t position, SeekMode mode = SeekSet)
+    {
+      if (!data) return false;
+
+      size_t target = (mode == SeekSet) ? position : ((mode == SeekCur) ? offset + position : data->size() + position);
+      if (target > data->size()) return false;
+      offset = target;
+      return true;
+    }
+
+    size_t position() const { return offset; }
+    size_t size() const { return data ? data->size() : 0; }
+
+    bool truncate(uint32_t size)
+    {
+      if (!data || !writable || (size > data->size())) return false;
+
+      data->resize(size);
+      if (offset > size) offset = size;
+      return true;
+    }
+
+    const char *name() const { return path.c_str(); }
+    void close() { data = nullptr; }
+
+  private:
+    FS *owner = nullptr;
+    std::string path;
+    std::shared_ptr<std::vector<uint8_t>> data;
+    bool readable = false;
+    bool writable = false;
+    size_t offset = 0;
+};
+
+class Dir
+{
+  public:
+    Dir() {}
+    explicit Dir(std::vector<std::string> names) : names(names) {}
+
+    bool next() { return ++index < (int)names.size(); }
+    String fileName() const { return String(names[index].c_str()); }
+
+  private:
+    std::vector<std::string> names;
+    int index = -1;
+};
+
+class FS
+{
+  public:
+    bool begin() { return mounted; }
+    void end() {}
+    bool format() { files.clear(); return true; }
+
+    File open(const char *path, const char *mode)
+    {
+      std::string name(path);
+      auto found = files.find(name);
+      bool exists = (found != files.end());
+
+      if (mode[0] == 'r')
+      {
+        if (!exists) return File();
+        return File(this, name, found->second, true, mode[1] == '+', 0);
+      }
+
+      if ((mode[0] == 'w') || !exists) files[name] = std::make_shared<std::vector<uint8_t>>();
+
+      std::shared_ptr<std::vector<uint8_t>> data = files[name];
+      return File(this, name, data, mode[1] == '+', true, (mode[0] == 'a') ? data->size() : 0);
+    }
+    File open(const String &path, const char *mode) { return open(path.c_str(), mode); }
+
+    bool exists(const char *path) { return files.count(path) > 0; }
+    bool exists(const String &path) { return exists(path.c_str()); }
+
+    bool remove(const char *path) { return files.erase(path) > 0; }
+    bool remove(const String &path) { return remove(path.c_str()); }
+
+    // como no SPIFFS: falha quando o destino já existe
+    bool rename(const char *from, const char *to)
+    {
+      auto found = files.find(from);
+      if ((found == files.end()) || exists(to)) return false;
+
+      files[to] = found->second;
+      files.erase(found);
+      renames++;
+      return true;
+    }
+    bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+
+    Dir openDir(const char *path)
+    {
+      std::string prefix = std::string(path) + "/";
+      std::vector<std::string> names;
+
+      for (auto &file : files)
+      {
+        if (file.first.compare(0, prefix.size(), prefix) == 0) names.push_back(file.first);
+      }
+      return Dir(names);
+    }
+    Dir openDir(const String &path) { return openDir(path.c_str()); }
+
+    // bytes ainda gravados antes do corte de energia; negativo desliga a simulação
+    size_t takeWriteBudget(size_t size)
+    {
+      if (writeBudget < 0) return size;
+
+      size_t allowed = ((long)size > writeBudget) ? (size_t)writeBudget : size;
+      writeBudget -= allowed;
+      return allowed;
+    }
+
+    std::string contents(const char *path) { return exists(path) ? std::string(files[path]->begin(), files[path]->end()) : std::string(); }
+
+    void reset()
+    {
+      files.clear();
+      mounted = true;
+      writeBudget = -1;
+      bytesWritten = 0;
+      renames = 0;
+    }
+
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+    bool mounted = true;
+    long writeBudget = -1;
+    uint64_t bytesWritten = 0;
+    uint32_t renames = 0;
+};
+
+inline size_t File::write(const uint8_t *buffer, size_t size)
+{
+  if (!data || !writable) return 0;
+
+  size_t allowed = owner->takeWriteBudget(size);
+
+  // grava na posição atual: "w" começa vazio e "a" abre no fim, como no SPIFFS
+  if (offset > data->size()) offset = data->size();
+  for (size_t i = 0; i < allowed; i++)
+  {
+    if (offset < data->size()) (*data)[offset] = buffer[i];
+    else data->push_back(buffer[i]);
+    offset++;
+  }
+  owner->bytesWritten += allowed;
+  return allowed;
+}
+
+inline FS SPIFFS;
+
+#endif
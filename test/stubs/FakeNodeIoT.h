@@ -0,0 +1,337 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Plataforma Node IOT simulada para os testes no host: atende    ##
+##   /devices/verify, /devices/getdata e /broker/data/ pelos        ##
+##   sockets do WiFiClient simulado, e o websocket (Socket.IO) do   ##
+##   SocketIOclient simulado. Guarda as amostras recebidas.         ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestFakeNodeIoT_h
+#define RemoteIOTestFakeNodeIoT_h
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WiFi.h>
+#include <SocketIOclient.h>
+#include <map>
+#include <vector>
+
+struct FakeSample
+{
+  std::string ref;
+  std::string value;
+  uint32_t timestamp;
+  uint32_t uptime;      // segundos desde o boot, quando o horário não pôde ser convertido
+  bool hasStats;        // resumo de uma janela do modo aggregate
+  bool overSocket;      // chegou como evento Socket.IO, e não por /broker/data/
+};
+
+struct FakeRequest
+{
+  std::string method;
+  std::string path;
+  std::string version;
+  std::map<std::string, std::string> headers;   // nomes em minúsculas
+  std::string body;
+};
+
+class FakeNodeIoT : public StubServer, public StubSocketServer
+{
+  public:
+    FakeNodeIoT()
+    {
+      stubServer = this;
+      stubSocketServer = this;
+      reset();
+    }
+
+    // volta à configuração padrão e zera o que foi observado
+    void reset()
+    {
+      online = true;
+      latency = 0;
+      idleTimeout = 0;
+      connections = 0;
+      toDevice.clear();
+      dropSocket = false;
+
+      state = "accepted";
+      token = "fake-token";
+      serverAddr = "http://10.0.0.2:5000";
+      gpio = "[]";
+      rules = "[]";
+      latest = "[]";
+      verifyStatus = 200;
+      garbledVerify = false;
+      dataStatus = 200;
+      retryAfter = 0;
+      acceptMsgPack = false;
+      keepAlive = true;
+      keepAliveHttp10 = false;
+      chunked = false;
+
+      requests.clear();
+      samples.clear();
+      dataRequests = 0;
+      socketFrames.clear();
+      socketConnects = 0;
+      joinedRoom = false;
+    }
+
+    // envia um evento Socket.IO ao dispositivo, ex.: event("digitalOutput", "led", "1")
+    void event(const char *name, const char *ref, const char *value)
+    {
+      std::string frame = std::string("[\"") + name + "\",{\"ref\":\"" + ref + "\",\"value\":\"" + value + "\"}]";
+      toDevice.push_back(frame);
+    }
+
+    size_t count(const char *path) const
+    {
+      size_t n = 0;
+      for (const FakeRequest &request : requests) if (request.path == path) n++;
+      return n;
+    }
+
+    /* ### HTTP ### */
+
+    bool respond(std::string &input, std::string &response, bool &close) override
+    {
+      size_t headerEnd = input.find("\r\n\r\n");
+      if (headerEnd == std::string::npos) return false;
+
+      FakeRequest request;
+      size_t lineEnd = input.find("\r\n");
+      std::string line = input.substr(0, lineEnd);
+      size_t first = line.find(' ');
+      size_t second = line.find(' ', first + 1);
+
+      request.method = line.substr(0, first);
+      request.path = line.substr(first + 1, second - first - 1);
+      request.version = line.substr(second + 1);
+
+      size_t position = lineEnd + 2;
+      while (position < headerEnd)
+      {
+        size_t end = input.find("\r\n", position);
+        std::string header = input.substr(position, end - position);
+        size_t colon = header.find(':');
+
+        if (colon != std::string::npos)
+        {
+          std::string name = header.substr(0, colon);
+          for (char &c : name) c = tolower((unsigned char)c);
+          size_t valueStart = header.find_first_not_of(' ', colon + 1);
+          request.headers[name] = (valueStart == std::string::npos) ? std::string() : header.substr(valueStart);
+        }
+        position = end + 2;
+      }
+
+      size_t length = request.headers.count("content-length") ? strtoul(request.headers["content-length"].c_str(), nullptr, 10) : 0;
+      if (input.size() < headerEnd + 4 + length) return false;
+
+      request.body = input.substr(headerEnd + 4, length);
+      input.erase(0, headerEnd + 4 + length);
+
+      size_t query = request.path.find('?');
+      if (query != std::string::npos) request.path.erase(query);
+      requests.push_back(request);
+
+      int status = 404;
+      std::string contentType = "application/json";
+      std::string body = "{\"message\":\"Not found\"}";
+
+      if (request.path == "/api/devices/verify") status = verify(request, body);
+      else if (request.path == "/api/devices/getdata") status = getdata(request, contentType, body);
+      else if (request.path == "/api/broker/data/") status = data(request, body);
+
+      // HTTP/1.1 mantém a conexão por padrão; HTTP/1.0 só com "Connection: keep-alive", e só se o servidor aceitar
+      std::string connection = request.headers.count("connection") ? request.headers["connection"] : std::string();
+      bool http11 = (request.version == "HTTP/1.1");
+      bool persistent = keepAlive && (http11 ? (connection.find("close") == std::string::npos) : (keepAliveHttp10 && (connection.find("keep-alive") != std::string::npos)));
+      bool useChunks = chunked && http11;
+
+      char head[256];
+      snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nConnection: %s\r\n", status, (status == 200) ? "OK" : "Error", contentType.c_str(), persistent ? "keep-alive" : "close");
+      response = head;
+
+      if ((retryAfter > 0) && (status != 200)) response += "Retry-After: " + std::to_string(retryAfter) + "\r\n";
+
+      if (useChunks)
+      {
+        // dois pedaços, para exercitar a leitura entre fronteiras de chunk
+        size_t half = body.size() / 2;
+        response += "Transfer-Encoding: chunked\r\n\r\n";
+        response += chunk(body.substr(0, half)) + chunk(body.substr(half)) + "0\r\n\r\n";
+      }
+      else
+      {
+        response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+      }
+
+      close = !persistent;
+      return true;
+    }
+
+    /* ### Socket.IO ### */
+
+    bool socketAccept(const std::string &path) override
+    {
+      if (!online || (path.find("token=" + token) == std::string::npos)) return false;
+
+      socketConnects++;
+      return true;
+    }
+
+    void socketReceive(const char *payload, size_t length) override
+    {
+      std::string frame(payload, length);
+      socketFrames.push_back(frame);
+
+      if (frame.rfind("[\"joinRoom\"", 0) == 0) joinedRoom = true;
+      if (frame.rfind("[\"deviceData\"", 0) != 0) return;
+
+      JsonDocument document;
+      if (deserializeJson(document, frame)) return;
+
+      // um objeto por amostra, ou um array com o lote inteiro
+      JsonVariant content = document[1];
+      if (content.is<JsonArray>()) for (JsonObject item : content.as<JsonArray>()) addSample(item, true);
+      else addSample(content.as<JsonObject>(), true);
+    }
+
+    /* ### configuração ### */
+
+    std::string state;
+    std::string token;
+    std::string serverAddr;
+    std::string gpio;           // lista "gpio" devolvida pelo verify, em JSON
+    std::string rules;          // lista "rules" devolvida pelo verify, em JSON
+    std::string latest;         // resposta do getdata, em JSON
+    int verifyStatus;
+    bool garbledVerify;         // o verify responde 200 com um corpo truncado
+    int dataStatus;
+    uint32_t retryAfter;        // s, enviado com respostas de erro quando diferente de 0
+    bool acceptMsgPack;         // responde "encoding": "msgpack" quando o dispositivo oferece
+    bool keepAlive;             // mantém conexões persistentes
+    bool keepAliveHttp10;       // atende "Connection: keep-alive" de clientes HTTP/1.0
+    bool chunked;               // respostas HTTP/1.1 em Transfer-Encoding: chunked
+
+    /* ### observado ### */
+
+    std::vector<FakeRequest> requests;
+    std::vector<FakeSample> samples;
+    uint32_t dataRequests;
+    std::vector<std::string> socketFrames;
+    uint32_t socketConnects;
+    bool joinedRoom;
+
+  private:
+    static std::string chunk(const std::string &data)
+    {
+      char size[16];
+      snprintf(size, sizeof(size), "%zx\r\n", data.size());
+      return size + data + "\r\n";
+    }
+
+    bool authorized(FakeRequest &request)
+    {
+      return request.headers["authorization"] == "Bearer " + token;
+    }
+
+    int verify(FakeRequest &request, std::string &body)
+    {
+      if (verifyStatus != 200)
+      {
+        body = "{}";
+        return verifyStatus;
+      }
+
+      if (garbledVerify)
+      {
+        body = "{\"state\":\"acc";
+        return 200;
+      }
+
+      JsonDocument received;
+      deserializeJson(received, request.body);
+
+      bool msgpackOffered = false;
+      for (JsonVariant encoding : received["encodings"].as<JsonArray>()) if (encoding == "msgpack") msgpackOffered = true;
+
+      JsonDocument document;
+      document["state"] = state;
+      document["token"] = token;
+      document["serverAddr"] = serverAddr;
+
+      JsonDocument list;
+      deserializeJson(list, gpio);
+      document["gpio"] = list;
+
+      JsonDocument compiled;
+      deserializeJson(compiled, rules);
+      document["rules"] = compiled;
+
+      if (acceptMsgPack && msgpackOffered) document["encoding"] = "msgpack";
+
+      body.clear();
+      serializeJson(document, body);
+      return 200;
+    }
+
+    int getdata(FakeRequest &request, std::string &contentType, std::string &body)
+    {
+      if (!authorized(request))
+      {
+        body = "{}";
+        return 401;
+      }
+
+      body = latest;
+
+      if (acceptMsgPack && (request.headers["accept"].find("msgpack") != std::string::npos))
+      {
+        JsonDocument document;
+        deserializeJson(document, latest);
+        body.clear();
+        serializeMsgPack(document, body);
+        contentType = "application/msgpack";
+      }
+      return 200;
+    }
+
+    int data(FakeRequest &request, std::string &body)
+    {
+      body = "{}";
+      if (!authorized(request)) return 401;
+      if (dataStatus != 200) return dataStatus;
+
+      JsonDocument document;
+      DeserializationError error = (request.headers["content-type"].find("msgpack") != std::string::npos) ? deserializeMsgPack(document, request.body) : deserializeJson(document, request.body);
+      if (error) return 400;
+
+      dataRequests++;
+      if (document.is<JsonArray>()) for (JsonObject item : document.as<JsonArray>()) addSample(item, false);
+      else addSample(document.as<JsonObject>(), false);
+      return 200;
+    }
+
+    void addSample(JsonObject item, bool overSocket)
+    {
+      FakeSample sample;
+      sample.ref = item["ref"] | "";
+      sample.value = item["value"].is<const char *>() ? std::string(item["value"].as<const char *>()) : std::to_string(item["value"].as<double>());
+      sample.timestamp = item["timestamp"] | 0;
+      sample.uptime = item["uptime"] | 0;
+      sample.hasStats = item["stats"].is<JsonObject>();
+      sample.overSocket = overSocket;
+      samples.push_back(sample);
+    }
+};
+
+inline FakeNodeIoT fakeNodeIoT;
+
+#endif
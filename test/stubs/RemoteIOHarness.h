@@ -0,0 +1,103 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Ambiente dos testes da biblioteca inteira no host: zera a rede,##
+##   a flash e a plataforma simuladas, grava as credenciais e roda  ##
+##   o loop() com o relógio simulado.                               ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestHarness_h
+#define RemoteIOTestHarness_h
+
+#include <ESP8266RemoteIO.h>
+#include "FakeNodeIoT.h"
+#include <lwip/dns.h>
+#include <memory>
+
+#define HARNESS_LOCAL_KEY "0123456789abcdef"
+#define HARNESS_START_MILLIS 1000   // ms, relógio no início de cada teste
+
+// volta rede, flash, pinos, TLS e plataforma ao estado inicial
+inline void harnessReset()
+{
+  stubMillis = HARNESS_START_MILLIS;
+  stubMicros = 0;
+  stubClockSynced = true;
+  stubHeap = { 0, 0 };
+  stubPins = {};
+  stubAnalogValue = 0;
+  stubNetwork = StubNetwork();
+  stubTls = StubTls();
+  stubTickers.clear();
+  stubDnsLookups.clear();
+  WiFi = ESP8266WiFiClass();
+  SPIFFS.reset();
+  fakeNodeIoT.reset();
+  ESP.restarts = 0;
+}
+
+// grava /config.json como o /get do ponto de acesso faria
+inline void harnessConfigure(const char *localKey = HARNESS_LOCAL_KEY)
+{
+  JsonDocument document;
+
+  document["deviceId"] = "bancada";
+  document["companyName"] = "remoteio";
+  document["ssid"] = stubNetwork.ssid;
+  document["password"] = stubNetwork.password;
+  document["model"] = "ESP_8266";
+  document["ssidAuth"] = false;
+  document["localKey"] = localKey;
+
+  File file = SPIFFS.open("/config.json", "w");
+  serializeJson(document, file);
+  file.close();
+}
+
+// uma passagem do firmware: avança o relógio, dispara os Tickers, entrega as respostas DNS e chama loop()
+inline void harnessStep(RemoteIO &device, uint32_t step = 1)
+{
+  stubMillis += step;
+  stubRunTickers();
+  stubRunDns();
+  device.loop();
+}
+
+inline void harnessRun(RemoteIO &device, uint32_t duration, uint32_t step = 1)
+{
+  uint32_t start = millis();
+  while (millis() - start < duration) harnessStep(device, step);
+}
+
+// roda até a primeira conexão com a plataforma; false se não conectar em timeout ms
+inline bool harnessConnect(RemoteIO &device, uint32_t timeout = 30000)
+{
+  uint32_t start = millis();
+
+  while (device.getBootMetrics().connected == 0)
+  {
+    if (millis() - start >= timeout) return false;
+    harnessStep(device);
+  }
+
+  // o websocket entra na sala pouco depois: espera os eventos da plataforma chegarem
+  harnessRun(device, 50);
+  return true;
+}
+
+// dispositivo configurado e conectado, com a tabela de IO informada em JSON
+inline std::unique_ptr<RemoteIO> harnessDevice(const char *gpio, RemoteIOCallback callback = nullptr, void *context = nullptr)
+{
+  harnessReset();
+  harnessConfigure();
+  fakeNodeIoT.gpio = gpio;
+
+  std::unique_ptr<RemoteIO> device(new RemoteIO());
+  device->begin(callback, context);
+  return device;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do SocketIOclient.h para os testes no host: os      ##
+##   quadros vão para a plataforma simulada (StubSocketServer) e    ##
+##   os eventos dela são entregues no loop(), como na biblioteca.   ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestSocketIOclient_h
+#define RemoteIOTestSocketIOclient_h
+
+#include <WebSocketsClient.h>
+#include <deque>
+#include <vector>
+
+typedef enum
+{
+  sIOtype_CONNECT = '0',
+  sIOtype_DISCONNECT = '1',
+  sIOtype_EVENT = '2',
+  sIOtype_ACK = '3',
+  sIOtype_ERROR = '4',
+  sIOtype_BINARY_EVENT = '5',
+  sIOtype_BINARY_ACK = '6'
+} socketIOmessageType_t;
+
+// lado da plataforma do websocket (FakeNodeIoT.h)
+class StubSocketServer
+{
+  public:
+    virtual ~StubSocketServer() {}
+    virtual bool socketAccept(const std::string &path) = 0;
+    virtual void socketReceive(const char *payload, size_t length) = 0;
+
+    std::deque<std::string> toDevice;   // eventos a entregar no próximo SocketIOclient::loop()
+    bool dropSocket = false;            // derruba o websocket no próximo loop()
+};
+
+inline StubSocketServer *stubSocketServer = nullptr;
+
+typedef std::function<void(socketIOmessageType_t type, uint8_t *payload, size_t length)> SocketIOclientEvent;
+
+class SocketIOclient
+{
+  public:
+    void begin(const String &host, uint16_t port, const String &url = "/socket.io/?EIO=3", const String &protocol = "arduino")
+    {
+      path = url.c_str();
+      begun = true;
+      connected = false;
+      nextAttempt = millis();
+    }
+
+    void onEvent(SocketIOclientEvent callback) { handler = callback; }
+    void setReconnectInterval(unsigned long interval) { reconnectInterval = interval; }
+    bool isConnected() { return connected; }
+
+    void loop()
+    {
+      if (!begun || (stubSocketServer == nullptr)) return;
+
+      if (connected && (stubSocketServer->dropSocket || !WiFi.routable()))
+      {
+        stubSocketServer->dropSocket = false;
+        connected = false;
+        nextAttempt = millis() + reconnectInterval;
+        dispatch(sIOtype_DISCONNECT, "");
+        return;
+      }
+
+      if (!connected)
+      {
+        if ((int32_t)(millis() - nextAttempt) < 0) return;
+
+        if (!WiFi.routable() || !stubSocketServer->socketAccept(path))
+        {
+          nextAttempt = millis() + reconnectInterval;
+          return;
+        }
+        connected = true;
+        dispatch(sIOtype_CONNECT, "/");
+        return;
+      }
+
+      // como na biblioteca: o payload é um buffer do websocket, que o callback pode alterar
+      while (connected && !stubSocketServer->toDevice.empty())
+      {
+        std::string frame = stubSocketServer->toDevice.front();
+        stubSocketServer->toDevice.pop_front();
+        dispatch(sIOtype_EVENT, frame);
+      }
+    }
+
+    bool send(socketIOmessageType_t type, const char *payload, size_t length = 0)
+    {
+      if (!connected) return false;
+      sentFrames++;
+      return true;
+    }
+    bool send(socketIOmessageType_t type, String &payload) { return send(type, payload.c_str(), payload.length()); }
+
+    bool sendEVENT(const char *payload, size_t length = 0)
+    {
+      if (!connected || (stubSocketServer == nullptr)) return false;
+      if (length == 0) length = strlen(payload);
+
+      sentFrames++;
+      stubSocketServer->socketReceive(payload, length);
+      return true;
+    }
+    bool sendEVENT(String &payload) { return sendEVENT(payload.c_str(), payload.length()); }
+
+    uint32_t sentFrames = 0;
+
+  private:
+    void dispatch(socketIOmessageType_t type, const std::string &payload)
+    {
+      if (!handler) return;
+
+      std::vector<uint8_t> buffer(payload.begin(), payload.end());
+      buffer.push_back('\0');
+      handler(type, buffer.data(), payload.size());
+    }
+
+    SocketIOclientEvent handler;
+    std::string path;
+    bool begun = false;
+    bool connected = false;
+    unsigned long reconnectInterval = 500;
+    unsigned long nextAttempt = 0;
+};
+
+#endif
@@ -0,0 +1,31 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do StreamString.h para os testes no host.           ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestStreamString_h
+#define RemoteIOTestStreamString_h
+
+#include <Arduino.h>
+
+class StreamString : public String, public Stream
+{
+  public:
+    size_t write(uint8_t c) override { concat((char)c); return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { concat((const char *)buffer, size); return size; }
+    int available() override { return length() - position; }
+    int read() override { return (position < length()) ? (uint8_t)charAt(position++) : -1; }
+    int peek() override { return (position < length()) ? (uint8_t)charAt(position) : -1; }
+
+    using Print::print;
+    using Print::write;
+
+  private:
+    unsigned int position = 0;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do Ticker.h para os testes no host: os timers ativos ##
+##   disparam em stubRunTickers(), chamada pelo teste entre as      ##
+##   passagens do loop(), como o timer do SDK faria.                ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestTicker_h
+#define RemoteIOTestTicker_h
+
+#include <Arduino.h>
+#include <vector>
+
+class Ticker;
+inline std::vector<Ticker *> stubTickers;
+
+class Ticker
+{
+  public:
+    ~Ticker() { detach(); }
+
+    template <typename TArg> void attach_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg)
+    {
+      detach();
+      interval = milliseconds;
+      dueAt = millis() + milliseconds;
+      function = [callback, arg]() { callback(arg); };
+      stubTickers.push_back(this);
+    }
+
+    void attach_ms(uint32_t milliseconds, void (*callback)())
+    {
+      detach();
+      interval = milliseconds;
+      dueAt = millis() + milliseconds;
+      function = callback;
+      stubTickers.push_back(this);
+    }
+
+    void detach()
+    {
+      for (size_t i = 0; i < stubTickers.size(); i++)
+      {
+        if (stubTickers[i] == this) stubTickers.erase(stubTickers.begin() + i);
+      }
+      function = nullptr;
+    }
+
+    bool active() { return (bool)function; }
+
+    // dispara todos os vencimentos até agora, inclusive os que ficaram para trás
+    void run()
+    {
+      while (function && (interval > 0) && ((int32_t)(millis() - dueAt) >= 0))
+      {
+        dueAt += interval;
+        function();
+      }
+    }
+
+  private:
+    std::function<void()> function;
+    uint32_t interval = 0;
+    uint32_t dueAt = 0;
+};
+
+inline void stubRunTickers()
+{
+  std::vector<Ticker *> active = stubTickers;
+  for (Ticker *ticker : active) ticker->run();
+}
+
+#endif
@@ -0,0 +1,16 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do WebSocketsClient.h para os testes no host: o     ##
+##   transporte do Socket.IO fica em SocketIOclient.h.              ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestWebSocketsClient_h
+#define RemoteIOTestWebSocketsClient_h
+
+#include <ESP8266WiFi.h>
+
+#endif
@@ -0,0 +1,80 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do WiFiClientSecure.h (BearSSL) para os testes no   ##
+##   host: o handshake custa tempo simulado, menor quando a sessão  ##
+##   TLS é retomada, e a sondagem MFLN abre uma conexão própria.    ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestWiFiClientSecure_h
+#define RemoteIOTestWiFiClientSecure_h
+
+#include <ESP8266WiFi.h>
+
+struct StubTls
+{
+  uint32_t handshakeTime = 0;         // ms de um handshake completo (bloqueante, como no BearSSL)
+  uint32_t resumedTime = 0;           // ms de um handshake com a sessão retomada
+  bool mfln = true;                   // servidor aceita Maximum Fragment Length Negotiation
+
+  uint32_t handshakes = 0;
+  uint32_t resumed = 0;
+  uint32_t probes = 0;
+  uint32_t probedAt = 0;              // millis() da última sondagem MFLN
+  int rxBufferSize = 0;               // buffers pedidos na última setBufferSizes()
+  int txBufferSize = 0;
+};
+
+inline StubTls stubTls;
+
+namespace BearSSL
+{
+  class Session
+  {
+    public:
+      bool valid = false;
+  };
+
+  class WiFiClientSecure : public ::WiFiClient
+  {
+    public:
+      void setInsecure() {}
+      void setSession(Session *session) { this->session = session; }
+      void setBufferSizes(int recv, int xmit)
+      {
+        stubTls.rxBufferSize = recv;
+        stubTls.txBufferSize = xmit;
+      }
+
+      int connect(const char *host, uint16_t port) override
+      {
+        if (!::WiFiClient::connect(host, port)) return 0;
+
+        bool resume = (session != nullptr) && session->valid;
+        delay(resume ? stubTls.resumedTime : stubTls.handshakeTime);
+        stubTls.handshakes++;
+        if (resume) stubTls.resumed++;
+        if (session != nullptr) session->valid = true;
+        return 1;
+      }
+      using ::WiFiClient::connect;
+
+      static bool probeMaxFragmentLength(const String &host, uint16_t port, uint16_t length)
+      {
+        stubTls.probes++;
+        stubTls.probedAt = millis();
+        delay(stubTls.handshakeTime);
+        return stubTls.mfln;
+      }
+
+    private:
+      Session *session = nullptr;
+  };
+}
+
+using BearSSL::WiFiClientSecure;
+
+#endif
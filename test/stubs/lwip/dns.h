@@ -0,0 +1,77 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do lwip/dns.h para os testes no host: a consulta    ##
+##   assíncrona responde pela rede simulada em stubNetwork, em      ##
+##   stubRunDns(), chamada pelo teste entre as passagens do loop(). ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestLwipDns_h
+#define RemoteIOTestLwipDns_h
+
+#include <ESP8266WiFi.h>
+#include <string>
+#include <vector>
+
+#define ERR_OK 0
+#define ERR_INPROGRESS -5
+#define ERR_ARG -16
+
+#define STUB_DNS_TIME 20          // ms até a resposta de um servidor DNS alcançável
+#define STUB_DNS_GIVE_UP 5000     // ms até o lwIP desistir de um servidor que não responde
+
+typedef int8_t err_t;
+
+typedef struct
+{
+  uint32_t addr;
+} ip_addr_t;
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+struct StubDnsLookup
+{
+  std::string name;
+  dns_found_callback found;
+  void *arg;
+  uint32_t due;
+  bool answered;    // sem resposta, o callback recebe nullptr ao desistir
+};
+
+inline std::vector<StubDnsLookup> stubDnsLookups;
+
+inline err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg)
+{
+  if ((hostname == nullptr) || (found == nullptr)) return ERR_ARG;
+
+  stubNetwork.dnsLookups++;
+
+  bool answered = WiFi.routable() && stubNetwork.dns;
+  stubDnsLookups.push_back({ hostname, found, callback_arg, millis() + (answered ? STUB_DNS_TIME : STUB_DNS_GIVE_UP), answered });
+  return ERR_INPROGRESS;
+}
+
+// entrega as respostas vencidas, fora do loop(), como o lwIP faria
+inline void stubRunDns()
+{
+  std::vector<StubDnsLookup> due;
+  std::vector<StubDnsLookup> pending;
+
+  for (StubDnsLookup &lookup : stubDnsLookups)
+  {
+    if ((int32_t)(millis() - lookup.due) >= 0) due.push_back(lookup);
+    else pending.push_back(lookup);
+  }
+  stubDnsLookups = pending;
+
+  for (StubDnsLookup &lookup : due)
+  {
+    ip_addr_t address = { (uint32_t)IPAddress(10, 0, 0, 2) };
+    lookup.found(lookup.name.c_str(), lookup.answered ? &address : nullptr, lookup.arg);
+  }
+}
+
+#endif
@@ -0,0 +1,16 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Substituto do pgmspace.h para os testes no host: no computador ##
+##   a PROGMEM é RAM comum.                                         ##
+##                                                                  ##
+######################################################################
+*/
+
+#ifndef RemoteIOTestPgmspace_h
+#define RemoteIOTestPgmspace_h
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,118 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes do resumo de janelas analógicas.                        ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include "RemoteIOAggregate.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_aggregate_empty()
+{
+  RemoteIOAggregate aggregate;
+  AggregateSummary summary;
+
+  TEST_ASSERT_FALSE(aggregate.summarize(summary));
+  TEST_ASSERT_EQUAL(0, aggregate.percentile(50));
+  TEST_ASSERT_EQUAL(0, aggregate.count());
+}
+
+void test_aggregate_summary()
+{
+  RemoteIOAggregate aggregate;
+  AggregateSummary summary;
+
+  uint16_t samples[] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+  for (uint16_t sample : samples) aggregate.add(sample);
+
+  TEST_ASSERT_TRUE(aggregate.summarize(summary));
+  TEST_ASSERT_EQUAL(8, summary.count);
+  TEST_ASSERT_EQUAL(2, summary.min);
+  TEST_ASSERT_EQUAL(9, summary.max);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 5.0, summary.mean);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 2.0, summary.stddev);
+}
+
+void test_aggregate_clamps_range()
+{
+  RemoteIOAggregate aggregate;
+  AggregateSummary summary;
+
+  aggregate.add(5000);
+  aggregate.summarize(summary);
+  TEST_ASSERT_EQUAL(AGGREGATE_RANGE - 1, summary.max);
+}
+
+void test_aggregate_long_window()
+{
+  RemoteIOAggregate aggregate;
+  AggregateSummary summary;
+
+  // Σx² passa de 2^32: a média e o desvio precisam continuar exatos
+  for (uint32_t i = 0; i < 100000; i++) aggregate.add((i & 1) ? 1023 : 1021);
+
+  aggregate.summarize(summary);
+  TEST_ASSERT_EQUAL(100000, summary.count);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1022.0, summary.mean);
+  TEST_ASSERT_FLOAT_WITHIN(0.05, 1.0, summary.stddev);
+}
+
+void test_aggregate_percentiles()
+{
+  RemoteIOAggregate aggregate;
+
+  for (uint16_t i = 0; i < AGGREGATE_RANGE; i++) aggregate.add(i);
+
+  // histograma de faixas: o erro fica dentro da largura de uma faixa
+  uint16_t width = AGGREGATE_RANGE / AGGREGATE_BUCKETS;
+  TEST_ASSERT_UINT16_WITHIN(width, 511, aggregate.percentile(50));
+  TEST_ASSERT_UINT16_WITHIN(width, 921, aggregate.percentile(90));
+  TEST_ASSERT_UINT16_WITHIN(width, 1013, aggregate.percentile(99));
+  TEST_ASSERT_EQUAL(AGGREGATE_RANGE - 1, aggregate.percentile(100));
+  TEST_ASSERT_EQUAL(0, aggregate.percentile(0));
+}
+
+void test_aggregate_percentile_within_observed_range()
+{
+  RemoteIOAggregate aggregate;
+
+  for (uint8_t i = 0; i < 10; i++) aggregate.add(300);
+
+  TEST_ASSERT_EQUAL(300, aggregate.percentile(1));
+  TEST_ASSERT_EQUAL(300, aggregate.percentile(50));
+  TEST_ASSERT_EQUAL(300, aggregate.percentile(99));
+}
+
+void test_aggregate_reset()
+{
+  RemoteIOAggregate aggregate;
+  AggregateSummary summary;
+
+  aggregate.add(10);
+  aggregate.reset();
+  aggregate.add(20);
+
+  aggregate.summarize(summary);
+  TEST_ASSERT_EQUAL(1, summary.count);
+  TEST_ASSERT_EQUAL(20, summary.min);
+  TEST_ASSERT_EQUAL(20, summary.max);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_aggregate_empty);
+  RUN_TEST(test_aggregate_summary);
+  RUN_TEST(test_aggregate_clamps_range);
+  RUN_TEST(test_aggregate_long_window);
+  RUN_TEST(test_aggregate_percentiles);
+  RUN_TEST(test_aggregate_percentile_within_observed_range);
+  RUN_TEST(test_aggregate_reset);
+  return UNITY_END();
+}
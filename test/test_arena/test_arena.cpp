@@ -0,0 +1,246 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes do alocador por pilha dos documentos JSON.              ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include "RemoteIOArena.h"
+#include "RemoteIOHarness.h"
+
+static bool inArena(RemoteIOArena &arena, void *pointer)
+{
+  return ((uint8_t *)pointer >= (uint8_t *)&arena) && ((uint8_t *)pointer < (uint8_t *)&arena + sizeof(arena));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_arena_alignment()
+{
+  RemoteIOArena arena;
+
+  void *first = arena.allocate(3);
+  void *second = arena.allocate(5);
+
+  TEST_ASSERT_EQUAL(0, (uintptr_t)first % 8);
+  TEST_ASSERT_EQUAL(0, (uintptr_t)second % 8);
+  TEST_ASSERT_TRUE(inArena(arena, first));
+  TEST_ASSERT_TRUE(inArena(arena, second));
+
+  arena.deallocate(second);
+  arena.deallocate(first);
+}
+
+void test_arena_rewinds_when_empty()
+{
+  RemoteIOArena arena;
+
+  void *first = arena.allocate(100);
+  void *second = arena.allocate(100);
+  arena.deallocate(first);
+  arena.deallocate(second);
+
+  // sem blocos vivos, a próxima alocação volta ao início
+  TEST_ASSERT_EQUAL_PTR(first, arena.allocate(10));
+}
+
+void test_arena_top_block_grows_in_place()
+{
+  RemoteIOArena arena;
+
+  arena.allocate(16);
+  uint8_t *top = (uint8_t *)arena.allocate(16);
+  memset(top, 0x5A, 16);
+
+  uint8_t *grown = (uint8_t *)arena.reallocate(top, 1024);
+  TEST_ASSERT_EQUAL_PTR(top, grown);
+  TEST_ASSERT_EQUAL_HEX8(0x5A, grown[15]);
+  TEST_ASSERT_TRUE(arena.peak >= 1024);
+}
+
+void test_arena_inner_block_moves()
+{
+  RemoteIOArena arena;
+
+  uint8_t *inner = (uint8_t *)arena.allocate(16);
+  arena.allocate(16);
+  memset(inner, 0x33, 16);
+
+  uint8_t *moved = (uint8_t *)arena.reallocate(inner, 64);
+  TEST_ASSERT_TRUE(moved != inner);
+  TEST_ASSERT_TRUE(inArena(arena, moved));
+  TEST_ASSERT_EQUAL_HEX8(0x33, moved[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x33, moved[15]);
+}
+
+void test_arena_inner_block_shrinks_in_place()
+{
+  RemoteIOArena arena;
+
+  void *inner = arena.allocate(64);
+  arena.allocate(16);
+
+  TEST_ASSERT_EQUAL_PTR(inner, arena.reallocate(inner, 8));
+}
+
+void test_arena_reclaims_blocks_freed_out_of_order()
+{
+  RemoteIOArena arena;
+
+  void *base = arena.allocate(64);
+  uint8_t *first = (uint8_t *)arena.allocate(16);
+  void *second = arena.allocate(16);
+  void *third = arena.allocate(16);
+
+  // liberados fora de ordem, acima de um bloco que continua vivo: voltam quando o topo é liberado
+  arena.deallocate(first);
+  arena.deallocate(second);
+  arena.deallocate(third);
+
+  TEST_ASSERT_EQUAL_PTR(first, arena.allocate(16));
+  TEST_ASSERT_TRUE(inArena(arena, base));
+}
+
+void test_arena_falls_back_to_heap()
+{
+  RemoteIOArena arena;
+
+  void *large = arena.allocate(JSON_ARENA_SIZE);
+  TEST_ASSERT_NOT_NULL(large);
+  TEST_ASSERT_FALSE(inArena(arena, large));
+  TEST_ASSERT_EQUAL(1, arena.fallbacks);
+
+  // blocos do heap continuam crescendo pelo heap
+  large = arena.reallocate(large, JSON_ARENA_SIZE * 2);
+  TEST_ASSERT_NOT_NULL(large);
+  arena.deallocate(large);
+
+  void *small = arena.allocate(32);
+  TEST_ASSERT_TRUE(inArena(arena, small));
+}
+
+void test_arena_with_json_document()
+{
+  RemoteIOArena arena;
+
+  {
+    JsonDocument document(&arena);
+    char key[8];
+    for (uint8_t i = 0; i < 20; i++)
+    {
+      snprintf(key, sizeof(key), "key%u", i);
+      document[key] = i;
+    }
+    TEST_ASSERT_EQUAL(19, document["key19"].as<int>());
+  }
+
+  TEST_ASSERT_EQUAL(0, arena.fallbacks);
+  TEST_ASSERT_TRUE(arena.peak > 0);
+
+  // documento liberado: a arena volta ao início
+  void *first = arena.allocate(8);
+  arena.deallocate(first);
+  TEST_ASSERT_EQUAL_PTR(first, arena.allocate(8));
+}
+
+// tabela de IO cheia: saídas em todos os GPIO livres, o A0 e refs virtuais até IO_TABLE_CAPACITY
+static std::string fullGpio()
+{
+  static const uint8_t OUTPUT_PINS[] = { 0, 1, 2, 3, 4, 5, 12, 13, 14, 15, 16 };
+  std::string gpio = "[";
+  char item[96];
+
+  for (uint8_t slot = 0; slot < IO_TABLE_CAPACITY; slot++)
+  {
+    if (slot < sizeof(OUTPUT_PINS))
+      snprintf(item, sizeof(item), "{\"ref\":\"saida_%02u\",\"pin\":%u,\"type\":\"OUTPUT\"}", slot, OUTPUT_PINS[slot]);
+    else if (slot == sizeof(OUTPUT_PINS))
+      snprintf(item, sizeof(item), "{\"ref\":\"nivel\",\"pin\":17,\"type\":\"INPUT_ANALOG\",\"delay\":60}");
+    else
+      snprintf(item, sizeof(item), "{\"ref\":\"virtual_%02u\",\"pin\":0,\"type\":\"N/L\"}", slot);
+
+    if (slot > 0) gpio += ",";
+    gpio += item;
+  }
+  return gpio + "]";
+}
+
+// uso da arena e relatório de memória lidos de /metrics.json
+static void readMetrics(JsonDocument &metrics)
+{
+  AsyncWebServerRequest request(HTTP_GET, "/metrics.json");
+  request.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY);
+  stubWebServer->handle(request);
+  TEST_ASSERT_EQUAL(200, request.response->code);
+  TEST_ASSERT_TRUE(deserializeJson(metrics, request.response->body) == DeserializationError::Ok);
+}
+
+void test_arena_budget_for_full_io_table()
+{
+  std::string gpio = fullGpio();
+  std::unique_ptr<RemoteIO> device = harnessDevice(gpio.c_str());
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  harnessRun(*device, 2000);
+
+  // verify com 32 refs, cache de boot e getdata: tudo dentro da arena
+  JsonDocument metrics;
+  readMetrics(metrics);
+  TEST_ASSERT_EQUAL(0, metrics["arena"]["fallbacks"].as<int>());
+  TEST_ASSERT_TRUE(metrics["arena"]["peak"].as<unsigned>() > 0);
+  TEST_ASSERT_TRUE(metrics["arena"]["peak"].as<unsigned>() <= JSON_ARENA_SIZE);
+  printf("[arena] verify com %u refs: pico %u de %u bytes\n", (unsigned)IO_TABLE_CAPACITY,
+         metrics["arena"]["peak"].as<unsigned>(), (unsigned)JSON_ARENA_SIZE);
+
+  // relatório de memória: as partes somam a instância inteira
+  uint32_t total = 0;
+  for (JsonPair part : metrics["memory"].as<JsonObject>()) total += part.value().as<uint32_t>();
+  TEST_ASSERT_EQUAL_UINT32(sizeof(RemoteIO), total);
+  TEST_ASSERT_EQUAL_UINT32(sizeof(RemoteIOArena), metrics["memory"]["json_arena"].as<uint32_t>());
+}
+
+void test_arena_budget_for_full_uplink_batch()
+{
+  // tabela de IO pequena: o pico da arena desde o boot é o do lote
+  std::unique_ptr<RemoteIO> device = harnessDevice("[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"}]");
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  // um lote com a fila inteira, no maior corpo que o envio monta
+  device->setUplinkBatch(UPLINK_QUEUE_CAPACITY, 60000);
+  size_t before = fakeNodeIoT.samples.size();
+  char ref[16];
+  for (uint8_t i = 0; i < UPLINK_QUEUE_CAPACITY; i++)
+  {
+    snprintf(ref, sizeof(ref), "virtual_%02u", i);
+    device->espPOST(ref, String(1000 + i));
+  }
+  harnessRun(*device, 1000);
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples.size() - before >= UPLINK_QUEUE_CAPACITY);
+
+  JsonDocument metrics;
+  readMetrics(metrics);
+  TEST_ASSERT_EQUAL(0, metrics["arena"]["fallbacks"].as<int>());
+  TEST_ASSERT_TRUE(metrics["arena"]["peak"].as<unsigned>() <= JSON_ARENA_SIZE);
+  printf("[arena] lote de %u amostras: pico %u de %u bytes\n", (unsigned)UPLINK_QUEUE_CAPACITY,
+         metrics["arena"]["peak"].as<unsigned>(), (unsigned)JSON_ARENA_SIZE);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_arena_alignment);
+  RUN_TEST(test_arena_rewinds_when_empty);
+  RUN_TEST(test_arena_top_block_grows_in_place);
+  RUN_TEST(test_arena_inner_block_moves);
+  RUN_TEST(test_arena_inner_block_shrinks_in_place);
+  RUN_TEST(test_arena_reclaims_blocks_freed_out_of_order);
+  RUN_TEST(test_arena_falls_back_to_heap);
+  RUN_TEST(test_arena_with_json_document);
+  RUN_TEST(test_arena_budget_for_full_io_table);
+  RUN_TEST(test_arena_budget_for_full_uplink_batch);
+  return UNITY_END();
+}
@@ -0,0 +1,119 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes da espera entre tentativas de reconexão.                ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include "RemoteIOBackoff.h"
+
+void setUp()
+{
+  stubMillis = 1000;
+  stubRandomSeed = 1;
+}
+
+void tearDown() {}
+
+void test_backoff_ready_after_reset()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  TEST_ASSERT_TRUE(backoff.ready());
+  TEST_ASSERT_EQUAL(0, backoff.failures);
+}
+
+void test_backoff_attempt_bounds()
+{
+  RemoteIOBackoff backoff(500, 30000);
+  uint32_t previous = 500;
+
+  for (uint8_t i = 0; i < 50; i++)
+  {
+    uint32_t wait = backoff.attempt();
+
+    // jitter descorrelacionado: entre a base e 3x a espera anterior, até o teto
+    TEST_ASSERT_TRUE(wait >= 500);
+    TEST_ASSERT_TRUE(wait <= 30000);
+    TEST_ASSERT_TRUE(wait <= previous * 3);
+    previous = wait;
+  }
+  TEST_ASSERT_EQUAL(50, backoff.failures);
+}
+
+void test_backoff_waits()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  uint32_t wait = backoff.attempt();
+  TEST_ASSERT_FALSE(backoff.ready());
+
+  stubMillis += wait - 1;
+  TEST_ASSERT_FALSE(backoff.ready());
+
+  stubMillis += 1;
+  TEST_ASSERT_TRUE(backoff.ready());
+}
+
+void test_backoff_millis_rollover()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  stubMillis = 0xFFFFFF00;
+  uint32_t wait = backoff.attempt();
+  stubMillis += wait;
+  TEST_ASSERT_TRUE(backoff.ready());
+}
+
+void test_backoff_defer_only_extends()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  backoff.defer(10000);
+  stubMillis += 5000;
+  TEST_ASSERT_FALSE(backoff.ready());
+
+  // um pedido menor que a espera restante não encurta a espera
+  backoff.defer(100);
+  stubMillis += 4999;
+  TEST_ASSERT_FALSE(backoff.ready());
+  stubMillis += 1;
+  TEST_ASSERT_TRUE(backoff.ready());
+}
+
+void test_backoff_defer_limit()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  backoff.defer(0xFFFFFFFF);
+  stubMillis += BACKOFF_MAX_DEFER;
+  TEST_ASSERT_TRUE(backoff.ready());
+}
+
+void test_backoff_reset()
+{
+  RemoteIOBackoff backoff(500, 30000);
+
+  for (uint8_t i = 0; i < 10; i++) backoff.attempt();
+  backoff.reset();
+
+  TEST_ASSERT_TRUE(backoff.ready());
+  TEST_ASSERT_EQUAL(0, backoff.failures);
+  TEST_ASSERT_TRUE(backoff.attempt() < 1500);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_backoff_ready_after_reset);
+  RUN_TEST(test_backoff_attempt_bounds);
+  RUN_TEST(test_backoff_waits);
+  RUN_TEST(test_backoff_millis_rollover);
+  RUN_TEST(test_backoff_defer_only_extends);
+  RUN_TEST(test_backoff_defer_limit);
+  RUN_TEST(test_backoff_reset);
+  return UNITY_END();
+}
@@ -0,0 +1,412 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Medidas da biblioteca inteira no host, contra a plataforma     ##
+##   simulada: latência comando -> pino (plataforma e API local),   ##
+##   vazão do envio, codificação dos corpos, bytes alocados por     ##
+##   operação, busca de refs e distribuição do tempo do loop().     ##
+##   O tempo simulado inclui os bloqueios do firmware (handshakes   ##
+##   TLS); o tempo do host mede só o processamento.                 ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+#include <StreamString.h>
+#include "RemoteIOHarness.h"
+
+// contagem de alocações do processo inteiro, lida como diferença em volta de cada operação
+void *operator new(size_t size)
+{
+  stubHeap.allocations++;
+  stubHeap.bytes += size;
+  void *pointer = malloc(size ? size : 1);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t size) noexcept { free(pointer); }
+
+#define BENCH_COMMANDS 500
+#define BENCH_SAMPLES 512
+#define BENCH_LOOPS 20000
+#define BENCH_LOOKUPS 20000
+
+static const char GPIO_BENCH[] =
+  "[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"},"
+  "{\"ref\":\"rele\",\"pin\":4,\"type\":\"OUTPUT\"},"
+  "{\"ref\":\"botao\",\"pin\":14,\"type\":\"INPUT\",\"mode\":\"interrupt\"},"
+  "{\"ref\":\"nivel\",\"pin\":17,\"type\":\"INPUT_ANALOG\"}]";
+
+// só saídas: as amostras enviadas são apenas as do próprio teste
+static const char GPIO_OUTPUTS[] =
+  "[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"},"
+  "{\"ref\":\"rele\",\"pin\":4,\"type\":\"OUTPUT\"}]";
+
+static uint64_t hostNanos()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t percentile(std::vector<uint64_t> values, double fraction)
+{
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(fraction * (values.size() - 1));
+  return values[index];
+}
+
+// plataforma na nuvem: handshake TLS completo e latência de rede típicos
+static void cloudProfile()
+{
+  stubTls.handshakeTime = 1200;
+  stubTls.resumedTime = 300;
+  fakeNodeIoT.latency = 40;
+}
+
+// passos do loop() até o dispositivo receber a resposta de mais um lote; devolve o tempo simulado em us
+static uint32_t deliverBatch(RemoteIO &device)
+{
+  uint32_t requests = device.getUplinkStats().requests;
+  uint32_t start = micros();
+
+  for (int i = 0; (i < 10000) && (device.getUplinkStats().requests == requests); i++) harnessStep(device);
+  return micros() - start;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_command_to_pin_latency()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_OUTPUTS);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  std::vector<uint64_t> host;
+  uint32_t worstPasses = 0;
+
+  for (int i = 0; i < BENCH_COMMANDS; i++)
+  {
+    const char *value = (i & 1) ? "0" : "1";
+    uint32_t writes = stubPins.writes[5];
+    uint32_t passes = 0;
+
+    fakeNodeIoT.event("digitalOutput", "led", value);
+    uint64_t start = hostNanos();
+
+    while ((stubPins.writes[5] == writes) && (passes < 100))
+    {
+      harnessStep(*device);
+      passes++;
+    }
+    host.push_back(hostNanos() - start);
+
+    TEST_ASSERT_EQUAL(atoi(value), stubPins.level[5]);
+    worstPasses = std::max(worstPasses, passes);
+  }
+
+  printf("[bench] comando -> pino: %u comandos, p50 %llu ns, p99 %llu ns (host), pior caso %u passagem(ens) do loop()\n", BENCH_COMMANDS,
+    (unsigned long long)percentile(host, 0.5), (unsigned long long)percentile(host, 0.99), worstPasses);
+
+  // o evento chega no socketIO.loop() e vai direto ao pino, na mesma passagem
+  TEST_ASSERT_EQUAL(1, worstPasses);
+}
+
+void test_local_api_latency()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_BENCH);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  std::vector<uint64_t> list;
+  std::vector<uint64_t> command;
+  uint32_t worstPasses = 0;
+
+  for (int i = 0; i < BENCH_COMMANDS; i++)
+  {
+    AsyncWebServerRequest read(HTTP_GET, "/api/io");
+    read.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY);
+    uint64_t start = hostNanos();
+    stubWebServer->handle(read);
+    list.push_back(hostNanos() - start);
+    TEST_ASSERT_EQUAL(200, read.response->code);
+
+    // POST /api/io até o pino: a requisição só enfileira, o loop() aplica o comando
+    const char *value = (i & 1) ? "0" : "1";
+    uint32_t writes = stubPins.writes[5];
+    uint32_t passes = 0;
+    AsyncWebServerRequest write(HTTP_POST, "/api/io");
+    write.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY).param("ref", "led").param("value", value);
+
+    start = hostNanos();
+    stubWebServer->handle(write);
+    while ((stubPins.writes[5] == writes) && (passes < 100))
+    {
+      harnessStep(*device);
+      passes++;
+    }
+    command.push_back(hostNanos() - start);
+
+    TEST_ASSERT_EQUAL(202, write.response->code);
+    TEST_ASSERT_EQUAL(atoi(value), stubPins.level[5]);
+    worstPasses = std::max(worstPasses, passes);
+  }
+
+  printf("[bench] API local: GET /api/io p50 %llu ns, p99 %llu ns; POST /api/io -> pino p50 %llu ns, p99 %llu ns (host), pior caso %u passagem(ens) do loop()\n",
+    (unsigned long long)percentile(list, 0.5), (unsigned long long)percentile(list, 0.99),
+    (unsigned long long)percentile(command, 0.5), (unsigned long long)percentile(command, 0.99), worstPasses);
+
+  TEST_ASSERT_EQUAL(1, worstPasses);
+}
+
+void test_uplink_throughput()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_OUTPUTS);
+  cloudProfile();
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  device->setUplinkBatch(8, 2000);
+  uint32_t simulatedStart = millis();
+  uint64_t hostStart = hostNanos();
+
+  // um lote cheio por vez, entregue antes do próximo: a vazão máxima sem passar pelo diário
+  for (int i = 0; i < BENCH_SAMPLES; i++)
+  {
+    device->espPOST("temperatura", String(i));
+    if (i % 8 == 7) deliverBatch(*device);
+  }
+
+  uint32_t simulated = millis() - simulatedStart;
+  uint64_t host = hostNanos() - hostStart;
+
+  printf("[bench] envio: %u amostras em %u requisições, %lu ms simulados (%.1f amostras/s), %llu us no host, %u handshakes TLS\n",
+    (unsigned)fakeNodeIoT.samples.size(), fakeNodeIoT.dataRequests, (unsigned long)simulated, 1000.0 * fakeNodeIoT.samples.size() / simulated,
+    (unsigned long long)(host / 1000), stubTls.handshakes);
+
+  TEST_ASSERT_EQUAL(BENCH_SAMPLES, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(BENCH_SAMPLES / 8, fakeNodeIoT.dataRequests);
+  TEST_ASSERT_EQUAL(0, device->getUplinkStats().journaled);
+}
+
+// latência de cada lote enviado, da amostra que o completa até a resposta, em tempo simulado, e handshakes TLS feitos para isso
+static void measureHandshakes(const char *label, bool keepAlive, bool chunked)
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_OUTPUTS);
+  cloudProfile();
+  fakeNodeIoT.keepAlive = keepAlive;
+  fakeNodeIoT.chunked = chunked;
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(8, 2000);
+
+  uint32_t handshakes = stubTls.handshakes;
+  std::vector<uint64_t> latency;
+
+  for (int batch = 0; batch < 32; batch++)
+  {
+    for (int i = 0; i < 7; i++) device->espPOST("temperatura", "20");
+    device->espPOST("temperatura", "21");
+    latency.push_back(deliverBatch(*device));
+
+    harnessRun(*device, 100);
+  }
+
+  printf("[bench] HTTPS %s: 32 lotes, %u handshakes (boot: %u, sondagens MFLN: %u), latência p50 %llu ms, máx %llu ms (simulado)\n", label,
+    stubTls.handshakes - handshakes, handshakes, stubTls.probes, (unsigned long long)percentile(latency, 0.5) / 1000, (unsigned long long)percentile(latency, 1.0) / 1000);
+
+  TEST_ASSERT_EQUAL(256, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(1, stubTls.probes);
+  if (keepAlive) TEST_ASSERT_EQUAL(0, stubTls.handshakes - handshakes);
+}
+
+void test_https_handshakes()
+{
+  measureHandshakes("keep-alive", true, false);
+  measureHandshakes("keep-alive, chunked", true, true);
+  measureHandshakes("Connection: close", false, false);
+}
+
+void test_bytes_allocated_per_operation()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_OUTPUTS);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(8, 2000);
+
+  // aquecimento: strings e buffers que só crescem na primeira vez
+  fakeNodeIoT.event("digitalOutput", "led", "1");
+  harnessStep(*device);
+  for (int i = 0; i < 8; i++) device->espPOST("temperatura", "20");
+  deliverBatch(*device);
+
+  StubHeap before = stubHeap;
+  for (int i = 0; i < 100; i++)
+  {
+    fakeNodeIoT.event("digitalOutput", "led", (i & 1) ? "1" : "0");
+    harnessStep(*device);
+  }
+  StubHeap command = { stubHeap.allocations - before.allocations, stubHeap.bytes - before.bytes };
+
+  before = stubHeap;
+  for (int i = 0; i < 96; i++)
+  {
+    device->espPOST("temperatura", "21");
+    if (i % 8 == 7) deliverBatch(*device);
+  }
+  StubHeap sample = { stubHeap.allocations - before.allocations, stubHeap.bytes - before.bytes };
+
+  before = stubHeap;
+  for (int i = 0; i < 1000; i++) harnessStep(*device);
+  StubHeap idle = { stubHeap.allocations - before.allocations, stubHeap.bytes - before.bytes };
+
+  // inclui as alocações da plataforma simulada e dos substitutos do core, que entram igualmente em todas as versões
+  printf("[bench] alocações por comando: %.1f (%.0f bytes); por amostra enviada: %.1f (%.0f bytes); por loop() ocioso: %.2f (%.1f bytes)\n",
+    command.allocations / 100.0, command.bytes / 100.0, sample.allocations / 96.0, sample.bytes / 96.0, idle.allocations / 1000.0, idle.bytes / 1000.0);
+
+  TEST_ASSERT_EQUAL(96, fakeNodeIoT.samples.size() - 8);
+}
+
+// codificação de um lote cheio como o de sendUplinkBatch: tamanho do corpo e tempo no host
+static void measureCodec(const char *label, bool msgpack)
+{
+  JsonDocument document;
+  JsonArray batch = document.to<JsonArray>();
+
+  for (int i = 0; i < UPLINK_BATCH_SIZE; i++)
+  {
+    JsonObject item = batch.add<JsonObject>();
+    item["deviceId"] = "bancada";
+    item["ref"] = "temperatura";
+    item["value"] = String(20.5 + i);
+    item["timestamp"] = 1700000000 + i;
+  }
+
+  std::vector<uint64_t> encode;
+  std::vector<uint64_t> decode;
+  uint8_t buffer[1024];
+  size_t length = 0;
+
+  for (int i = 0; i < BENCH_COMMANDS; i++)
+  {
+    uint64_t start = hostNanos();
+    length = RemoteIOWire::encode(document, msgpack, buffer, RemoteIOWire::measure(document, msgpack) + 1);
+    encode.push_back(hostNanos() - start);
+
+    StreamString stream;
+    stream.write(buffer, length);
+    JsonDocument filter;
+    filter.set(true);
+    JsonDocument decoded;
+
+    start = hostNanos();
+    TEST_ASSERT_TRUE(RemoteIOWire::decode(decoded, stream, msgpack, filter) == DeserializationError::Ok);
+    decode.push_back(hostNanos() - start);
+    TEST_ASSERT_EQUAL(UPLINK_BATCH_SIZE, decoded.size());
+  }
+
+  printf("[bench] corpo %s: lote de %u amostras em %u bytes; medir + codificar p50 %llu ns, decodificar p50 %llu ns (host)\n", label, UPLINK_BATCH_SIZE,
+    (unsigned)length, (unsigned long long)percentile(encode, 0.5), (unsigned long long)percentile(decode, 0.5));
+}
+
+void test_wire_codec()
+{
+  measureCodec("JSON", false);
+  measureCodec("MessagePack", true);
+}
+
+// tempo médio por busca, em ns no host; soma os valores lidos para comparar as duas buscas
+template <typename Lookup>
+static uint64_t measureLookup(const std::vector<String> &refs, int64_t &sum, Lookup lookup)
+{
+  sum = 0;
+  uint64_t start = hostNanos();
+  for (int i = 0; i < BENCH_LOOKUPS; i++) sum += lookup(refs[i % refs.size()]);
+  return (hostNanos() - start) / BENCH_LOOKUPS;
+}
+
+void test_io_lookup()
+{
+  // tabela cheia: a busca binária de findIO contra a busca linear nas chaves do setIO
+  std::string gpio = "[";
+  std::vector<String> refs;
+
+  for (int i = 0; i < IO_TABLE_CAPACITY; i++)
+  {
+    char ref[16];
+    snprintf(ref, sizeof(ref), "sensor%02d", i);
+    refs.push_back(ref);
+    gpio += std::string(i ? "," : "") + "{\"ref\":\"" + ref + "\",\"pin\":17,\"type\":\"INPUT_ANALOG\",\"delay\":3600}";
+  }
+  gpio += "]";
+
+  std::unique_ptr<RemoteIO> device = harnessDevice(gpio.c_str());
+  stubAnalogValue = 300;
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  // getIOValue é a busca pública por findIO
+  int64_t tableSum;
+  int64_t jsonSum;
+  uint64_t table = measureLookup(refs, tableSum, [&](const String &ref) { return device->getIOValue(ref); });
+  uint64_t json = measureLookup(refs, jsonSum, [&](const String &ref) { return device->setIO[ref]["value"].as<int32_t>(); });
+
+  printf("[bench] busca de ref com %u refs: getIOValue (findIO) %llu ns, setIO[ref][\"value\"] %llu ns (host)\n", IO_TABLE_CAPACITY,
+    (unsigned long long)table, (unsigned long long)json);
+
+  // o setIO é uma cópia da tabela: as duas buscas leem os mesmos valores
+  TEST_ASSERT_TRUE(tableSum == jsonSum);
+  TEST_ASSERT_TRUE(tableSum != 0);
+}
+
+void test_loop_time_distribution()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_BENCH);
+  cloudProfile();
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(8, 2000);
+
+  std::vector<uint64_t> simulated;
+  std::vector<uint64_t> host;
+
+  for (int i = 0; i < BENCH_LOOPS; i++)
+  {
+    // tráfego de fundo: um comando e uma borda na entrada a cada 50 ms, uma amostra a cada 100 ms
+    if (i % 50 == 0) fakeNodeIoT.event("digitalOutput", "rele", (i & 64) ? "1" : "0");
+    if (i % 50 == 25) stubSetInput(14, (i / 50) & 1);
+    if (i % 100 == 0) device->espPOST("temperatura", String(i));
+    stubAnalogValue = 512 + (i % 7);
+
+    stubMillis++;
+    stubRunTickers();
+
+    uint32_t simulatedStart = micros();
+    uint64_t hostStart = hostNanos();
+    device->loop();
+    host.push_back(hostNanos() - hostStart);
+    simulated.push_back(micros() - simulatedStart);
+  }
+
+  printf("[bench] loop(): %u passagens, simulado p50 %llu us, p99 %llu us, máx %llu us; host p50 %llu ns, p99 %llu ns, máx %llu ns\n", BENCH_LOOPS,
+    (unsigned long long)percentile(simulated, 0.5), (unsigned long long)percentile(simulated, 0.99), (unsigned long long)percentile(simulated, 1.0),
+    (unsigned long long)percentile(host, 0.5), (unsigned long long)percentile(host, 0.99), (unsigned long long)percentile(host, 1.0));
+
+  // a passagem típica não bloqueia; o máximo mostra o custo das etapas de rede
+  TEST_ASSERT_EQUAL(0, percentile(simulated, 0.5));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_command_to_pin_latency);
+  RUN_TEST(test_local_api_latency);
+  RUN_TEST(test_uplink_throughput);
+  RUN_TEST(test_https_handshakes);
+  RUN_TEST(test_bytes_allocated_per_operation);
+  RUN_TEST(test_wire_codec);
+  RUN_TEST(test_io_lookup);
+  RUN_TEST(test_loop_time_distribution);
+  return UNITY_END();
+}
@@ -0,0 +1,173 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes do leitor de eventos do Socket.IO.                      ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <ArduinoJson.h>
+#include "RemoteIOEvent.h"
+
+#define EVENT_BENCH_COUNT 200000    // eventos lidos em cada medição de vazão
+
+static uint64_t allocatedBytes = 0;
+
+// bytes alocados pelo processo inteiro, lidos como diferença em volta de cada medição
+void *operator new(size_t size)
+{
+  allocatedBytes += size;
+  void *pointer = malloc(size ? size : 1);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t size) noexcept { free(pointer); }
+
+static bool parse(char *payload, RemoteIOEvent &event)
+{
+  return parseRemoteIOEvent(payload, strlen(payload), event);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_event_fields()
+{
+  char payload[] = "[\"digitalOutput\",{\"ref\":\"led\",\"value\":1,\"function\":\"set\"}]";
+  RemoteIOEvent event;
+
+  TEST_ASSERT_TRUE(parse(payload, event));
+  TEST_ASSERT_EQUAL(0, event.id);
+  TEST_ASSERT_EQUAL_STRING("digitalOutput", event.name);
+  TEST_ASSERT_EQUAL_STRING("led", event.ref);
+  TEST_ASSERT_EQUAL(3, event.refLength);
+  TEST_ASSERT_EQUAL_STRING("1", event.value);
+  TEST_ASSERT_FALSE(event.valueIsString);
+  TEST_ASSERT_EQUAL_STRING("set", event.function);
+}
+
+void test_event_ack_id()
+{
+  char payload[] = "42[\"getdata\",{\"ref\":\"a\"}]";
+  RemoteIOEvent event;
+
+  TEST_ASSERT_TRUE(parse(payload, event));
+  TEST_ASSERT_EQUAL(42, event.id);
+  TEST_ASSERT_EQUAL_STRING("getdata", event.name);
+}
+
+void test_event_missing_fields_are_null()
+{
+  char payload[] = "[\"ping\"]";
+  RemoteIOEvent event;
+
+  TEST_ASSERT_TRUE(parse(payload, event));
+  TEST_ASSERT_EQUAL_STRING("ping", event.name);
+  TEST_ASSERT_EQUAL_STRING("null", event.ref);
+  TEST_ASSERT_EQUAL_STRING("null", event.value);
+  TEST_ASSERT_EQUAL(4, event.valueLength);
+  TEST_ASSERT_EQUAL_STRING("null", event.function);
+}
+
+void test_event_string_escapes()
+{
+  char payload[] = "[\"e\",{\"ref\":\"a\\\"b\",\"value\":\"\\u00e9\\n\\ud83d\\ude00\"}]";
+  RemoteIOEvent event;
+
+  TEST_ASSERT_TRUE(parse(payload, event));
+  TEST_ASSERT_EQUAL_STRING("a\"b", event.ref);
+  TEST_ASSERT_TRUE(event.valueIsString);
+  TEST_ASSERT_EQUAL_STRING("\xC3\xA9\n\xF0\x9F\x98\x80", event.value);
+  TEST_ASSERT_EQUAL(7, event.valueLength);
+}
+
+void test_event_nested_value()
+{
+  char payload[] = "[\"e\",{\"value\":{\"a\":[1,\"}\"]},\"ref\":\"x\"}]";
+  RemoteIOEvent event;
+
+  TEST_ASSERT_TRUE(parse(payload, event));
+  TEST_ASSERT_EQUAL_STRING("{\"a\":[1,\"}\"]}", event.value);
+  TEST_ASSERT_FALSE(event.valueIsString);
+  TEST_ASSERT_EQUAL_STRING("x", event.ref);
+}
+
+void test_event_malformed()
+{
+  RemoteIOEvent event;
+
+  char notArray[] = "{\"ref\":\"a\"}";
+  TEST_ASSERT_FALSE(parse(notArray, event));
+
+  char truncated[] = "[\"e\",{\"ref\":\"a";
+  TEST_ASSERT_FALSE(parse(truncated, event));
+
+  char missingColon[] = "[\"e\",{\"ref\" \"a\"}]";
+  TEST_ASSERT_FALSE(parse(missingColon, event));
+}
+
+// vazão e alocação por evento do leitor em linha, contra uma leitura completa com ArduinoJson
+void test_event_throughput()
+{
+  static const char command[] = "[\"digitalOutput\",{\"ref\":\"rel1\",\"value\":1,\"function\":\"set\",\"deviceId\":\"bancada\"}]";
+  char payload[sizeof(command)];
+  RemoteIOEvent event;
+  uint32_t refs = 0;
+
+  uint64_t bytes = allocatedBytes;
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t i = 0; i < EVENT_BENCH_COUNT; i++)
+  {
+    // o leitor escreve no buffer: cada evento chega numa cópia nova, como no websocket
+    memcpy(payload, command, sizeof(command));
+    if (parse(payload, event) && (event.refLength == 4)) refs++;
+  }
+
+  uint64_t inlineNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  uint64_t inlineBytes = allocatedBytes - bytes;
+
+  TEST_ASSERT_EQUAL_UINT32(EVENT_BENCH_COUNT, refs);
+  TEST_ASSERT_TRUE(inlineBytes == 0);
+
+  refs = 0;
+  bytes = allocatedBytes;
+  start = std::chrono::steady_clock::now();
+
+  for (uint32_t i = 0; i < EVENT_BENCH_COUNT; i++)
+  {
+    JsonDocument document;
+    if (!deserializeJson(document, command, sizeof(command) - 1) && (strcmp(document[1]["ref"] | "", "rel1") == 0)) refs++;
+  }
+
+  uint64_t documentNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  uint64_t documentBytes = allocatedBytes - bytes;
+
+  TEST_ASSERT_EQUAL_UINT32(EVENT_BENCH_COUNT, refs);
+
+  printf("[bench] eventos: leitor em linha %.0f eventos/s, %.1f bytes/evento; JsonDocument %.0f eventos/s, %.1f bytes/evento\n",
+         EVENT_BENCH_COUNT * 1e9 / inlineNanos, (double)inlineBytes / EVENT_BENCH_COUNT,
+         EVENT_BENCH_COUNT * 1e9 / documentNanos, (double)documentBytes / EVENT_BENCH_COUNT);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_event_fields);
+  RUN_TEST(test_event_ack_id);
+  RUN_TEST(test_event_missing_fields_are_null);
+  RUN_TEST(test_event_string_escapes);
+  RUN_TEST(test_event_nested_value);
+  RUN_TEST(test_event_malformed);
+  RUN_TEST(test_event_throughput);
+  return UNITY_END();
+}
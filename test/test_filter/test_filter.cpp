@@ -0,0 +1,191 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes dos filtros do ADC em ponto fixo.                       ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "RemoteIOFilter.h"
+
+#define ONE (1 << FILTER_FRACTION_BITS)
+#define REFERENCE_SAMPLES 8192      // leituras do sinal de referência
+#define REFERENCE_STEP 3000         // leitura em que o sinal sobe de 200 para 800
+#define REFERENCE_TOLERANCE 0.25    // contagens do ADC entre o ponto fixo e a referência em double
+
+// ADC simulado: degrau com ruído pseudoaleatório de +-40 contagens, sempre o mesmo
+static uint16_t referenceSample(uint32_t index, uint32_t &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  int32_t noise = (int32_t)((seed >> 16) % 81) - 40;
+  int32_t value = ((index < REFERENCE_STEP) ? 200 : 800) + noise;
+  return (value < 0) ? 0 : ((value > 1023) ? 1023 : value);
+}
+
+// a mesma cadeia em double, sem arredondamentos; devolve o maior erro do ponto fixo, em contagens
+static double compareWithReference(uint8_t decimation, uint8_t window, uint8_t shift)
+{
+  RemoteIOFilter filter;
+  filter.configure(decimation, window, shift);
+
+  double values[FILTER_WINDOW_MAX];
+  double sum = 0;
+  double lowPass = 0;
+  uint8_t decimated = 0;
+  uint8_t filled = 0;
+  uint8_t position = 0;
+  uint32_t outputs = 0;
+  double worst = 0;
+  uint32_t seed = 1;
+
+  for (uint32_t i = 0; i < REFERENCE_SAMPLES; i++)
+  {
+    uint16_t sample = referenceSample(i, seed);
+    int32_t output;
+    bool ready = filter.push(sample, output);
+
+    sum += sample;
+    if (++decimated < decimation)
+    {
+      TEST_ASSERT_FALSE(ready);
+      continue;
+    }
+    TEST_ASSERT_TRUE(ready);
+
+    double mean = sum / decimation;
+    sum = 0;
+    decimated = 0;
+
+    values[position] = mean;
+    position = (position + 1) % window;
+    if (filled < window) filled++;
+
+    double average = 0;
+    for (uint8_t j = 0; j < filled; j++) average += values[j];
+    average /= filled;
+
+    lowPass = (outputs == 0) ? average : lowPass + (average - lowPass) / (1 << shift);
+    outputs++;
+
+    double error = fabs((double)output / ONE - lowPass);
+    if (error > worst) worst = error;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(REFERENCE_SAMPLES / decimation, outputs);
+  return worst;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_filter_decimator()
+{
+  FilterDecimator decimator;
+  int32_t output = -1;
+
+  decimator.configure(4);
+  TEST_ASSERT_FALSE(decimator.push(10, output));
+  TEST_ASSERT_FALSE(decimator.push(11, output));
+  TEST_ASSERT_FALSE(decimator.push(12, output));
+  TEST_ASSERT_TRUE(decimator.push(12, output));
+
+  // 45 / 4 = 11,25, com 4 bits de fração
+  TEST_ASSERT_EQUAL(45 * ONE / 4, output);
+}
+
+void test_filter_decimator_limits()
+{
+  FilterDecimator decimator;
+  int32_t output;
+
+  decimator.configure(0);
+  TEST_ASSERT_TRUE(decimator.push(7, output));
+  TEST_ASSERT_EQUAL(7 * ONE, output);
+
+  // a soma de FILTER_DECIMATION_MAX leituras de 10 bits cabe no acumulador
+  decimator.configure(255);
+  for (uint8_t i = 1; i < FILTER_DECIMATION_MAX; i++) TEST_ASSERT_FALSE(decimator.push(1023, output));
+  TEST_ASSERT_TRUE(decimator.push(1023, output));
+  TEST_ASSERT_EQUAL(1023 * ONE, output);
+}
+
+void test_filter_moving_average()
+{
+  FilterMovingAverage average;
+
+  average.configure(4);
+  TEST_ASSERT_EQUAL(8, average.push(8));
+  TEST_ASSERT_EQUAL(6, average.push(4));
+  TEST_ASSERT_EQUAL(4, average.push(0));
+  TEST_ASSERT_EQUAL(3, average.push(0));
+  TEST_ASSERT_EQUAL(1, average.push(0));
+  TEST_ASSERT_EQUAL(0, average.push(0));
+}
+
+void test_filter_low_pass()
+{
+  FilterLowPass lowPass;
+
+  lowPass.configure(2);
+  TEST_ASSERT_EQUAL(100, lowPass.push(100));
+
+  // degrau: o estado anda 1/4 da diferença a cada entrada, sem perder a fração
+  TEST_ASSERT_EQUAL(75, lowPass.push(0));
+  int32_t output = 0;
+  for (uint8_t i = 0; i < 40; i++) output = lowPass.push(0);
+  TEST_ASSERT_EQUAL(0, output);
+
+  for (uint8_t i = 0; i < 60; i++) output = lowPass.push(1);
+  TEST_ASSERT_EQUAL(1, output);
+}
+
+void test_filter_chain()
+{
+  RemoteIOFilter filter;
+  int32_t output = 0;
+  uint8_t outputs = 0;
+
+  filter.configure(2, 2, 0);
+
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (filter.push(512, output)) outputs++;
+  }
+
+  TEST_ASSERT_EQUAL(4, outputs);
+  TEST_ASSERT_EQUAL(512 * ONE, output);
+
+  filter.reset();
+  TEST_ASSERT_FALSE(filter.push(0, output));
+  TEST_ASSERT_TRUE(filter.push(0, output));
+  TEST_ASSERT_EQUAL(0, output);
+}
+
+void test_filter_chain_matches_reference()
+{
+  // configurações do mínimo ao máximo de cada estágio, atravessando o degrau com ruído
+  static const uint8_t configs[][3] = { { 1, 1, 0 }, { 4, 8, 2 }, { 8, 4, 4 }, { 16, 16, 6 }, { FILTER_DECIMATION_MAX, FILTER_WINDOW_MAX, FILTER_SHIFT_MAX } };
+
+  for (const uint8_t *config : configs)
+  {
+    double worst = compareWithReference(config[0], config[1], config[2]);
+    printf("[bench] filtro %u/%u/%u: maior erro %.4f contagens\n", config[0], config[1], config[2], worst);
+    TEST_ASSERT_TRUE(worst <= REFERENCE_TOLERANCE);
+  }
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_filter_decimator);
+  RUN_TEST(test_filter_decimator_limits);
+  RUN_TEST(test_filter_moving_average);
+  RUN_TEST(test_filter_low_pass);
+  RUN_TEST(test_filter_chain);
+  RUN_TEST(test_filter_chain_matches_reference);
+  return UNITY_END();
+}
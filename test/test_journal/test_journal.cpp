@@ -0,0 +1,212 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes do diário de amostras em flash, sobre o SPIFFS em       ##
+##   memória: queda de energia, rotação, ordem e cursor.            ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include "RemoteIOJournal.h"
+
+#define JOURNAL_TEST_REF "sensor_de_temperatura_da_sala_1"   // 31 caracteres: registro de 62 bytes
+#define JOURNAL_TEST_VALUE "12345678901234567890123"         // 23 caracteres
+#define JOURNAL_TEST_RECORD 62
+#define JOURNAL_TEST_PER_SEGMENT (JOURNAL_SEGMENT_SIZE / JOURNAL_TEST_RECORD)
+
+static uint32_t segmentFiles()
+{
+  uint32_t count = 0;
+  Dir dir = SPIFFS.openDir(JOURNAL_DIR);
+
+  while (dir.next())
+  {
+    if (dir.fileName() != JOURNAL_CURSOR_FILE) count++;
+  }
+  return count;
+}
+
+// lê e confirma tudo o que resta, conferindo a ordem pelos timestamps
+static uint32_t drain(RemoteIOJournal &journal, uint32_t &first, uint32_t &last)
+{
+  JournalRecord records[8];
+  uint32_t total = 0;
+  uint8_t count;
+
+  while ((count = journal.read(records, 8)) > 0)
+  {
+    for (uint8_t i = 0; i < count; i++)
+    {
+      if (total == 0) first = records[i].timestamp;
+      else TEST_ASSERT_EQUAL_UINT32(last + 1, records[i].timestamp);
+      last = records[i].timestamp;
+      total++;
+    }
+    journal.commit();
+  }
+  return total;
+}
+
+void setUp()
+{
+  SPIFFS.reset();
+}
+
+void tearDown() {}
+
+void test_journal_recovers_torn_tail()
+{
+  RemoteIOJournal journal;
+  journal.begin(SPIFFS);
+
+  for (uint32_t i = 1; i <= 3; i++) TEST_ASSERT_TRUE(journal.append("d1", "1", i));
+
+  // energia cai no meio do quarto registro: só 5 dos 11 bytes chegam à flash
+  SPIFFS.writeBudget = 5;
+  journal.append("d1", "0", 4);
+  SPIFFS.writeBudget = -1;
+
+  RemoteIOJournal rebooted;
+  rebooted.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(5, rebooted.recoveredBytes);
+  TEST_ASSERT_EQUAL_UINT32(3 * 11, SPIFFS.contents(JOURNAL_DIR "/00000001").size());
+
+  // o registro seguinte é gravado logo após o último íntegro
+  TEST_ASSERT_TRUE(rebooted.append("d1", "1", 4));
+
+  uint32_t first = 0;
+  uint32_t last = 0;
+  TEST_ASSERT_EQUAL_UINT32(4, drain(rebooted, first, last));
+  TEST_ASSERT_EQUAL_UINT32(1, first);
+  TEST_ASSERT_EQUAL_UINT32(4, last);
+  TEST_ASSERT_TRUE(rebooted.empty());
+}
+
+void test_journal_rotates_over_max_segments()
+{
+  RemoteIOJournal journal;
+  journal.begin(SPIFFS);
+
+  uint32_t total = (JOURNAL_MAX_SEGMENTS + 2) * JOURNAL_TEST_PER_SEGMENT;
+  for (uint32_t i = 1; i <= total; i++) TEST_ASSERT_TRUE(journal.append(JOURNAL_TEST_REF, JOURNAL_TEST_VALUE, i));
+
+  // dois segmentos além do limite: os dois mais antigos foram descartados
+  TEST_ASSERT_EQUAL_UINT32(2, journal.droppedSegments);
+  TEST_ASSERT_EQUAL_UINT32(JOURNAL_MAX_SEGMENTS, segmentFiles());
+
+  // a leitura recomeça no segmento mais antigo que sobrou, sem lacunas até o último registro
+  uint32_t first = 0;
+  uint32_t last = 0;
+  uint32_t kept = drain(journal, first, last);
+  TEST_ASSERT_EQUAL_UINT32(2 * JOURNAL_TEST_PER_SEGMENT + 1, first);
+  TEST_ASSERT_EQUAL_UINT32(total, last);
+  TEST_ASSERT_EQUAL_UINT32(JOURNAL_MAX_SEGMENTS * JOURNAL_TEST_PER_SEGMENT, kept);
+  TEST_ASSERT_EQUAL_UINT32(0, segmentFiles());
+}
+
+void test_journal_cursor_survives_reboot()
+{
+  RemoteIOJournal journal;
+  journal.begin(SPIFFS);
+
+  uint32_t total = 2 * JOURNAL_TEST_PER_SEGMENT + 10;
+  for (uint32_t i = 1; i <= total; i++) TEST_ASSERT_TRUE(journal.append(JOURNAL_TEST_REF, JOURNAL_TEST_VALUE, i));
+
+  // confirma o primeiro segmento inteiro e parte do segundo
+  JournalRecord records[8];
+  uint32_t confirmed = 0;
+  while (confirmed < JOURNAL_TEST_PER_SEGMENT + 5)
+  {
+    uint8_t count = journal.read(records, 1);
+    TEST_ASSERT_EQUAL_UINT8(1, count);
+    TEST_ASSERT_EQUAL_UINT32(confirmed + 1, records[0].timestamp);
+    journal.commit();
+    confirmed++;
+  }
+  TEST_ASSERT_FALSE(SPIFFS.exists(JOURNAL_DIR "/00000001"));
+
+  // lido sem confirmar: volta a ser entregue depois do reboot
+  TEST_ASSERT_EQUAL_UINT8(3, journal.read(records, 3));
+  TEST_ASSERT_EQUAL_UINT32(confirmed + 1, records[0].timestamp);
+
+  RemoteIOJournal rebooted;
+  rebooted.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(0, rebooted.recoveredBytes);
+
+  uint32_t first = 0;
+  uint32_t last = 0;
+  TEST_ASSERT_EQUAL_UINT32(total - confirmed, drain(rebooted, first, last));
+  TEST_ASSERT_EQUAL_UINT32(confirmed + 1, first);
+  TEST_ASSERT_EQUAL_UINT32(total, last);
+  TEST_ASSERT_EQUAL_UINT32(total - confirmed, rebooted.replayed);
+
+  // diário vazio: segmentos e cursor apagados
+  TEST_ASSERT_TRUE(rebooted.empty());
+  TEST_ASSERT_EQUAL_UINT32(0, segmentFiles());
+  TEST_ASSERT_FALSE(SPIFFS.exists(JOURNAL_CURSOR_FILE));
+}
+
+void test_journal_marks_current_boot()
+{
+  RemoteIOJournal journal;
+  journal.begin(SPIFFS);
+  TEST_ASSERT_TRUE(journal.append("d1", "1", 1));
+  TEST_ASSERT_TRUE(journal.append("d1", "0", 2));
+
+  RemoteIOJournal rebooted;
+  rebooted.begin(SPIFFS);
+  TEST_ASSERT_TRUE(rebooted.append("d1", "1", 3));
+
+  // registros do boot anterior, no mesmo segmento dos novos
+  JournalRecord records[8];
+  TEST_ASSERT_EQUAL_UINT8(3, rebooted.read(records, 8));
+  TEST_ASSERT_FALSE(records[0].currentBoot);
+  TEST_ASSERT_FALSE(records[1].currentBoot);
+  TEST_ASSERT_TRUE(records[2].currentBoot);
+  TEST_ASSERT_EQUAL_STRING("d1", records[2].ref);
+  TEST_ASSERT_EQUAL_STRING("1", records[2].value);
+  rebooted.commit();
+
+  // diário vazio no boot: tudo o que for gravado é deste boot
+  TEST_ASSERT_TRUE(rebooted.append("d1", "0", 4));
+  TEST_ASSERT_EQUAL_UINT8(1, rebooted.read(records, 8));
+  TEST_ASSERT_TRUE(records[0].currentBoot);
+}
+
+void test_journal_keeps_extra_text()
+{
+  RemoteIOJournal journal;
+  journal.begin(SPIFFS);
+  TEST_ASSERT_TRUE(journal.append("nivel", "512.5", 1, "{\"count\":10,\"min\":500,\"max\":525}"));
+  TEST_ASSERT_TRUE(journal.append("nivel", "510", 2));
+
+  // texto extra além do limite: o registro é recusado, e não truncado
+  char extra[JOURNAL_EXTRA_LENGTH + 1];
+  memset(extra, 'x', JOURNAL_EXTRA_LENGTH);
+  extra[JOURNAL_EXTRA_LENGTH] = '\0';
+  TEST_ASSERT_FALSE(journal.append("nivel", "0", 3, extra));
+
+  RemoteIOJournal rebooted;
+  rebooted.begin(SPIFFS);
+  TEST_ASSERT_EQUAL_UINT32(0, rebooted.recoveredBytes);
+
+  JournalRecord records[8];
+  TEST_ASSERT_EQUAL_UINT8(2, rebooted.read(records, 8));
+  TEST_ASSERT_EQUAL_STRING("512.5", records[0].value);
+  TEST_ASSERT_EQUAL_STRING("{\"count\":10,\"min\":500,\"max\":525}", records[0].extra);
+  TEST_ASSERT_EQUAL_STRING("510", records[1].value);
+  TEST_ASSERT_EQUAL_STRING("", records[1].extra);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_journal_recovers_torn_tail);
+  RUN_TEST(test_journal_rotates_over_max_segments);
+  RUN_TEST(test_journal_cursor_survives_reboot);
+  RUN_TEST(test_journal_marks_current_boot);
+  RUN_TEST(test_journal_keeps_extra_text);
+  return UNITY_END();
+}
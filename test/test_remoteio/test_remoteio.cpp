@@ -0,0 +1,670 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes da biblioteca inteira no host, contra a plataforma      ##
+##   simulada: conexão, comandos, envio de amostras e API local.    ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <chrono>
+#include "RemoteIOHarness.h"
+
+static const char GPIO_LED[] = "[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"}]";
+
+#define SOCKET_BENCH_PASSES 2000    // passagens do loop() no teste de vazão do websocket
+#define SOCKET_BENCH_SAMPLES 16     // amostras enfileiradas por passagem
+
+struct CallbackLog
+{
+  uint32_t calls;
+  std::string ref;
+  std::string value;
+};
+
+static void recordCommand(const RemoteIOCommand &command, void *context)
+{
+  CallbackLog *log = (CallbackLog *)context;
+  log->calls++;
+  log->ref.assign(command.ref, command.refLength);
+  log->value.assign(command.value, command.valueLength);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_boot_connects_to_platform()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.count("/api/devices/verify"));
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.count("/api/devices/getdata"));
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.socketConnects);
+  TEST_ASSERT_TRUE(fakeNodeIoT.joinedRoom);
+  TEST_ASSERT_EQUAL(OUTPUT, stubPins.mode[5]);
+}
+
+void test_boot_without_credentials_stays_offline()
+{
+  harnessReset();
+  RemoteIO device;
+  device.begin(nullptr, nullptr);
+
+  harnessRun(device, 5000);
+  TEST_ASSERT_EQUAL(0, stubNetwork.joins);
+  TEST_ASSERT_EQUAL(0, fakeNodeIoT.requests.size());
+  TEST_ASSERT_NOT_NULL(stubWebServer);
+  TEST_ASSERT_TRUE(stubWebServer->started);
+}
+
+void test_command_reaches_pin()
+{
+  CallbackLog log = {};
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED, recordCommand, &log);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  fakeNodeIoT.event("digitalOutput", "led", "1");
+  harnessStep(*device);
+
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[5]);
+  TEST_ASSERT_EQUAL(1, log.calls);
+  TEST_ASSERT_EQUAL_STRING("led", log.ref.c_str());
+  TEST_ASSERT_EQUAL_STRING("1", log.value.c_str());
+
+  fakeNodeIoT.event("digitalOutput", "led", "0");
+  harnessStep(*device);
+  TEST_ASSERT_EQUAL(LOW, stubPins.level[5]);
+  TEST_ASSERT_EQUAL(2, log.calls);
+
+  // avisos da plataforma e eventos sem "ref" não são comandos: o callback não é chamado
+  fakeNodeIoT.toDevice.push_back("[\"infoUpdated\",{\"function\":\"gpio\"}]");
+  fakeNodeIoT.toDevice.push_back("[\"ping\"]");
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(2, log.calls);
+}
+
+void test_uplink_batch_reaches_platform()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  device->setUplinkBatch(8, 2000);
+  for (int i = 0; i < 8; i++) TEST_ASSERT_EQUAL(1, device->espPOST("temperatura", String(20 + i)));
+
+  // espPOST só enfileira; o lote cheio sai pelas passagens seguintes do loop(), numa única requisição
+  TEST_ASSERT_EQUAL(0, fakeNodeIoT.dataRequests);
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.dataRequests);
+  TEST_ASSERT_EQUAL(8, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL_STRING("temperatura", fakeNodeIoT.samples[0].ref.c_str());
+  TEST_ASSERT_EQUAL_STRING("27", fakeNodeIoT.samples[7].value.c_str());
+
+  // amostra isolada: sai pela latência máxima do lote
+  device->espPOST("temperatura", "30");
+  harnessRun(*device, 2100);
+  TEST_ASSERT_EQUAL(2, fakeNodeIoT.dataRequests);
+  TEST_ASSERT_EQUAL(9, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(1, device->getUplinkStats().flushByDeadline);
+
+  // flushUplink devolve quantas amostras o pedido vai enviar
+  TEST_ASSERT_EQUAL(0, device->flushUplink());
+  device->espPOST("temperatura", "31");
+  device->espPOST("temperatura", "32");
+  TEST_ASSERT_EQUAL(2, device->flushUplink());
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(11, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(1, device->getUplinkStats().flushForced);
+
+  // fila cheia com o lote em envio: a amostra nova vai para o diário, e espPOST devolve 0
+  fakeNodeIoT.latency = 200;
+  device->setUplinkBatch(UPLINK_QUEUE_CAPACITY, 2000);
+  for (int i = 0; i < UPLINK_QUEUE_CAPACITY; i++) device->espPOST("temperatura", String(i));
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(0, device->espPOST("temperatura", "99"));
+  TEST_ASSERT_EQUAL(1, device->getUplinkStats().journaled);
+}
+
+static uint32_t deviceDataFrames()
+{
+  uint32_t frames = 0;
+  for (const std::string &frame : fakeNodeIoT.socketFrames) if (frame.rfind("[\"deviceData\"", 0) == 0) frames++;
+  return frames;
+}
+
+void test_uplink_retries_transient_failure()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(4, 2000);
+
+  // uma falha isolada: o lote fica na memória e sai na nova tentativa, sem passar pela flash
+  fakeNodeIoT.dataStatus = 503;
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(i));
+  harnessRun(*device, 100);
+  TEST_ASSERT_EQUAL(1, device->getUplinkStats().failures);
+
+  fakeNodeIoT.dataStatus = 200;
+  harnessRun(*device, UPLINK_BACKOFF_BASE * 3);
+  TEST_ASSERT_EQUAL(4, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(0, device->getUplinkStats().journaled);
+
+  // o envio seguinte já sai sem espera
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(10 + i));
+  harnessRun(*device, 100);
+  TEST_ASSERT_EQUAL(8, fakeNodeIoT.samples.size());
+
+  // falhas seguidas: a fila vai para o diário e volta com o reenvio quando a plataforma responde
+  fakeNodeIoT.dataStatus = 503;
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(20 + i));
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_TRUE(device->getUplinkStats().failures >= 1 + UPLINK_MAX_FAILURES);
+  TEST_ASSERT_EQUAL(4, device->getUplinkStats().journaled);
+
+  fakeNodeIoT.dataStatus = 200;
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(12, fakeNodeIoT.samples.size());
+}
+
+void test_journal_skips_rejected_batch()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(4, 2000);
+
+  fakeNodeIoT.dataStatus = 503;
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(i));
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(4, device->getUplinkStats().journaled);
+
+  // lote recusado em definitivo: é pulado, e não repetido para sempre
+  fakeNodeIoT.dataStatus = HTTP_CODE_PAYLOAD_TOO_LARGE;
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(4, device->getUplinkStats().replayDropped);
+
+  // o diário livre não segura mais o envio ao vivo
+  fakeNodeIoT.dataStatus = 200;
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(10 + i));
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(4, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL_STRING("10", fakeNodeIoT.samples[0].value.c_str());
+}
+
+void test_journal_replays_before_sntp()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(4, 2000);
+  stubClockSynced = false;
+
+  fakeNodeIoT.dataStatus = 503;
+  for (int i = 0; i < 4; i++) device->espPOST("temperatura", String(i));
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(4, device->getUplinkStats().journaled);
+
+  // sem SNTP o diário é reenviado mesmo assim, com os segundos desde o boot no lugar do horário
+  fakeNodeIoT.dataStatus = 200;
+  harnessRun(*device, UPLINK_BACKOFF_MAX);
+  TEST_ASSERT_EQUAL(4, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(0, fakeNodeIoT.samples[0].timestamp);
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples[0].uptime > 0);
+}
+
+void test_socket_uplink_one_event_per_batch()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  device->setUplinkBatch(UPLINK_QUEUE_CAPACITY, 2000);
+  device->setSocketUplink(true);
+
+  // as amostras de uma passagem saem juntas na seguinte, num único evento e sem HTTPS
+  for (int i = 0; i < 5; i++) device->espPOST("temperatura", String(20 + i));
+  TEST_ASSERT_EQUAL(0, deviceDataFrames());
+  harnessStep(*device);
+  TEST_ASSERT_EQUAL(1, deviceDataFrames());
+  TEST_ASSERT_EQUAL(5, fakeNodeIoT.samples.size());
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples[4].overSocket);
+  TEST_ASSERT_EQUAL_STRING("24", fakeNodeIoT.samples[4].value.c_str());
+  TEST_ASSERT_EQUAL(0, fakeNodeIoT.dataRequests);
+
+  // vazão: um quadro por passagem, qualquer que seja o número de amostras
+  fakeNodeIoT.samples.clear();
+  fakeNodeIoT.socketFrames.clear();
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t pass = 0; pass < SOCKET_BENCH_PASSES; pass++)
+  {
+    for (uint32_t i = 0; i < SOCKET_BENCH_SAMPLES; i++) device->espPOST("temperatura", String(pass * SOCKET_BENCH_SAMPLES + i));
+    harnessStep(*device);
+  }
+
+  uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+  TEST_ASSERT_EQUAL(SOCKET_BENCH_PASSES, deviceDataFrames());
+  TEST_ASSERT_EQUAL(SOCKET_BENCH_PASSES * SOCKET_BENCH_SAMPLES, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(0, device->getUplinkStats().journaled);
+
+  printf("[bench] websocket: %u amostras em %u eventos, %.2f us/amostra no host\n",
+         SOCKET_BENCH_PASSES * SOCKET_BENCH_SAMPLES, (unsigned)deviceDataFrames(), nanos / 1000.0 / (SOCKET_BENCH_PASSES * SOCKET_BENCH_SAMPLES));
+}
+
+void test_config_update_replaces_io_table()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(
+    "[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"},"
+    "{\"ref\":\"botao\",\"pin\":14,\"type\":\"INPUT\",\"delay\":30},"
+    "{\"ref\":\"nivel\",\"pin\":17,\"type\":\"INPUT_ANALOG\",\"delay\":60}]");
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  fakeNodeIoT.event("digitalOutput", "led", "1");
+  harnessStep(*device);
+  TEST_ASSERT_EQUAL(1, device->getIOValue("led"));
+  TEST_ASSERT_EQUAL(1, device->setIO["led"]["value"].as<int>());
+  TEST_ASSERT_EQUAL(30, device->setIO["botao"]["delay"].as<int>());
+  harnessRun(*device, OUTPUT_CACHE_INTERVAL + 100);    // grava o valor das saídas no cache de boot
+
+  // novo boot: o cache aplica a configuração antiga, a revalidação traz a nova sem "botao" e sem "delay"
+  fakeNodeIoT.gpio =
+    "[{\"ref\":\"nivel\",\"pin\":17,\"type\":\"INPUT_ANALOG\"},"
+    "{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"}]";
+  device.reset();
+  device.reset(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  harnessRun(*device, 2000);
+
+  TEST_ASSERT_TRUE(device->setIO["botao"].isNull());
+  TEST_ASSERT_TRUE(device->setIO["nivel"]["delay"].isNull());
+  TEST_ASSERT_EQUAL(1, device->getIOValue("led"));
+  TEST_ASSERT_EQUAL(1, device->setIO["led"]["value"].as<int>());
+
+  AsyncWebServerRequest list(HTTP_GET, "/api/io");
+  list.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY);
+  stubWebServer->handle(list);
+  TEST_ASSERT_TRUE(list.response->body.indexOf("\"ref\":\"botao\"") < 0);
+  TEST_ASSERT_TRUE(list.response->body.indexOf("\"ref\":\"nivel\"") >= 0);
+  TEST_ASSERT_TRUE(list.response->body.indexOf("\"ref\":\"led\"") >= 0);
+
+  // o índice refeito ainda resolve as refs que ficaram
+  fakeNodeIoT.event("digitalOutput", "led", "0");
+  harnessStep(*device);
+  TEST_ASSERT_EQUAL(LOW, stubPins.level[5]);
+  TEST_ASSERT_EQUAL(0, device->getIOValue("led"));
+  TEST_ASSERT_EQUAL(0, device->setIO["led"]["value"].as<int>());
+
+  // a escrita pelo setIO, como nos sketches antigos, ainda chega ao pino
+  device->setIO["led"]["value"] = 1;
+  device->updatePinOutput("led");
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[5]);
+  TEST_ASSERT_EQUAL(1, device->getIOValue("led"));
+}
+
+void test_board_outputs_boot_at_safe_level()
+{
+  harnessReset();
+  harnessConfigure();
+
+  File file = SPIFFS.open("/model.json", "w");
+  file.print("{\"model\":\"ESP_8266R8\"}");
+  file.close();
+
+  // níveis contrários aos seguros, como se o firmware anterior tivesse deixado os relés ligados
+  stubPins.level[2] = LOW;
+  stubPins.level[4] = HIGH;
+  stubPins.level[15] = HIGH;
+
+  RemoteIO device;
+  device.begin(nullptr, nullptr);
+
+  // GPIO2 e GPIO15 são pinos de strapping: ficam nos níveis que o próximo boot exige
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[2]);
+  TEST_ASSERT_EQUAL(LOW, stubPins.level[15]);
+  TEST_ASSERT_EQUAL(LOW, stubPins.level[4]);
+  TEST_ASSERT_EQUAL(OUTPUT, stubPins.mode[2]);
+  TEST_ASSERT_EQUAL(OUTPUT, stubPins.mode[15]);
+}
+
+void test_rule_reads_cyclic_input_fresh()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(
+    "[{\"ref\":\"led\",\"pin\":5,\"type\":\"OUTPUT\"},"
+    "{\"ref\":\"botao\",\"pin\":14,\"type\":\"INPUT\",\"delay\":30}]");
+  fakeNodeIoT.rules = "[{\"if\":\"botao\",\"op\":\"==\",\"value\":1,\"then\":\"led\",\"set\":1,\"else\":0}]";
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  // a entrada cíclica só é amostrada a cada 30 s, mas a regra vê o pino mudar na hora
+  stubPins.level[14] = HIGH;
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[5]);
+
+  stubPins.level[14] = LOW;
+  harnessRun(*device, 10);
+  TEST_ASSERT_EQUAL(LOW, stubPins.level[5]);
+}
+
+void test_msgpack_uplink()
+{
+  harnessReset();
+  harnessConfigure();
+  fakeNodeIoT.gpio = GPIO_LED;
+  fakeNodeIoT.acceptMsgPack = true;
+
+  RemoteIO device;
+  device.begin(nullptr, nullptr);
+  TEST_ASSERT_TRUE(harnessConnect(device));
+
+  // corpo binário: enviado pelo tamanho medido, com o Content-Type negociado no verify
+  device.setUplinkBatch(8, 2000);
+  for (int i = 0; i < 8; i++) device.espPOST("temperatura", String(20 + i));
+  harnessRun(device, 10);
+
+  const FakeRequest &post = fakeNodeIoT.requests.back();
+  TEST_ASSERT_EQUAL_STRING(WIRE_MSGPACK_TYPE, post.headers.at("content-type").c_str());
+  TEST_ASSERT_EQUAL(post.body.size(), atoi(post.headers.at("content-length").c_str()));
+
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.dataRequests);
+  TEST_ASSERT_EQUAL(8, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL_STRING("27", fakeNodeIoT.samples[7].value.c_str());
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples[7].timestamp >= CLOCK_VALID_AFTER);
+}
+
+void test_chunked_responses()
+{
+  harnessReset();
+  harnessConfigure();
+  fakeNodeIoT.gpio = GPIO_LED;
+  fakeNodeIoT.latest = "[{\"ref\":\"led\",\"data\":[{\"value\":\"1\"}]}]";
+  fakeNodeIoT.chunked = true;
+
+  RemoteIO device;
+  device.begin(nullptr, nullptr);
+  TEST_ASSERT_TRUE(harnessConnect(device));
+
+  // verify e getdata lidos através das fronteiras de chunk
+  TEST_ASSERT_EQUAL(OUTPUT, stubPins.mode[5]);
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[5]);
+
+  device.setUplinkBatch(8, 2000);
+  for (int i = 0; i < 8; i++) device.espPOST("temperatura", "20");
+  harnessRun(device, 10);
+  TEST_ASSERT_EQUAL(8, fakeNodeIoT.samples.size());
+
+  // corpos lidos até o chunk final: a mesma conexão serviu as três requisições
+  TEST_ASSERT_EQUAL(1, stubTls.handshakes);
+  TEST_ASSERT_EQUAL(1, stubTls.probes);
+}
+
+void test_server_closes_connection()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  fakeNodeIoT.keepAlive = false;
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  device->setUplinkBatch(8, 2000);
+  for (int i = 0; i < 16; i++) device->espPOST("temperatura", "20");
+  harnessRun(*device, 50);
+
+  // "Connection: close" em cada resposta: uma conexão nova por requisição, sem falhas
+  TEST_ASSERT_EQUAL(16, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL(0, device->getUplinkStats().failures);
+  TEST_ASSERT_EQUAL(fakeNodeIoT.requests.size(), stubTls.handshakes);
+}
+
+void test_local_api_requires_key()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  AsyncWebServerRequest anonymous(HTTP_GET, "/api/io");
+  stubWebServer->handle(anonymous);
+  TEST_ASSERT_EQUAL(401, anonymous.response->code);
+
+  AsyncWebServerRequest list(HTTP_GET, "/api/io");
+  list.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY);
+  stubWebServer->handle(list);
+  TEST_ASSERT_EQUAL(200, list.response->code);
+  TEST_ASSERT_TRUE(list.response->body.indexOf("\"ref\":\"led\"") >= 0);
+
+  AsyncWebServerRequest command(HTTP_POST, "/api/io");
+  command.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY).param("ref", "led").param("value", "1");
+  stubWebServer->handle(command);
+  TEST_ASSERT_EQUAL(202, command.response->code);
+
+  harnessStep(*device);
+  TEST_ASSERT_EQUAL(HIGH, stubPins.level[5]);
+}
+
+void test_setup_requires_key_once_provisioned()
+{
+  // primeiro boot: a chave gerada já fica gravada, e a configuração inicial é livre
+  harnessReset();
+  RemoteIO fresh;
+  fresh.begin(nullptr, nullptr);
+
+  File file = SPIFFS.open("/config.json", "r");
+  JsonDocument saved;
+  deserializeJson(saved, file);
+  file.close();
+  TEST_ASSERT_EQUAL(LOCAL_KEY_LENGTH, strlen(saved["localKey"] | ""));
+
+  AsyncWebServerRequest first(HTTP_GET, "/get");
+  first.param("ssid", "rede").param("password", "senha").param("companyName", "remoteio").param("deviceId", "bancada").param("localKey", HARNESS_LOCAL_KEY);
+  stubWebServer->handle(first);
+  TEST_ASSERT_EQUAL(200, first.response->code);
+  TEST_ASSERT_TRUE(first.response->body.indexOf(HARNESS_LOCAL_KEY) < 0);
+
+  // configurado: trocar as credenciais exige a chave, que não volta na resposta nem no registro
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+
+  AsyncWebServerRequest anonymous(HTTP_GET, "/get");
+  anonymous.param("ssid", "outra").param("password", "senha").param("companyName", "remoteio").param("deviceId", "bancada");
+  stubWebServer->handle(anonymous);
+  TEST_ASSERT_EQUAL(401, anonymous.response->code);
+
+  AsyncWebServerRequest shortKey(HTTP_GET, "/get");
+  shortKey.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY).param("ssid", "outra").param("password", "senha").param("companyName", "remoteio").param("deviceId", "bancada").param("localKey", "curta");
+  stubWebServer->handle(shortKey);
+  TEST_ASSERT_EQUAL(400, shortKey.response->code);
+
+  AsyncWebServerRequest authorized(HTTP_GET, "/get");
+  authorized.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY).param("ssid", "outra").param("password", "senha").param("companyName", "remoteio").param("deviceId", "bancada");
+  stubWebServer->handle(authorized);
+  TEST_ASSERT_EQUAL(200, authorized.response->code);
+  TEST_ASSERT_TRUE(authorized.response->body.indexOf(HARNESS_LOCAL_KEY) < 0);
+
+  AsyncWebServerRequest log(HTTP_GET, "/log");
+  log.credentials(LOCAL_API_USER, HARNESS_LOCAL_KEY);
+  stubWebServer->handle(log);
+  TEST_ASSERT_EQUAL(200, log.response->code);
+  TEST_ASSERT_TRUE(log.response->body.indexOf("API local: usuário remoteio, chave 0123...") >= 0);
+  TEST_ASSERT_TRUE(log.response->body.indexOf(HARNESS_LOCAL_KEY) < 0);
+}
+void test_wifi_lease_survives_platform_outage()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  TEST_ASSERT_TRUE(SPIFFS.contents(CONFIG_FILE).find("wifiCache") != std::string::npos);
+
+  // plataforma fora do ar: a conexão direta associa e o DNS responde, a rede em cache fica;
+  // sem o cache de boot, a primeira requisição depois da associação é o verify
+  fakeNodeIoT.online = false;
+  SPIFFS.remove(BOOT_CACHE_FILE);
+  device.reset(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  harnessRun(*device, 2000);
+  TEST_ASSERT_EQUAL(1, device->getWiFiJoinStats().directJoins);
+  TEST_ASSERT_EQUAL(0, device->getWiFiJoinStats().leaseInvalidations);
+  TEST_ASSERT_TRUE(SPIFFS.contents(CONFIG_FILE).find("wifiCache") != std::string::npos);
+
+  // AP mudou de sub-rede: o IP fixo associa, mas não roteia, e a concessão é descartada
+  fakeNodeIoT.online = true;
+  stubNetwork.ip = IPAddress(10, 0, 1, 50);
+  stubNetwork.gateway = IPAddress(10, 0, 1, 1);
+  device.reset(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  TEST_ASSERT_EQUAL(1, device->getWiFiJoinStats().leaseInvalidations);
+  TEST_ASSERT_EQUAL(1, device->getWiFiJoinStats().scanJoins);
+}
+
+void test_revalidate_keeps_cache_on_garbled_response()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(GPIO_LED);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  TEST_ASSERT_TRUE(SPIFFS.exists(BOOT_CACHE_FILE));
+
+  // boot rápido: um 200 ilegível na revalidação não é recusa, o cache fica e a revalidação se repete
+  fakeNodeIoT.garbledVerify = true;
+  device.reset(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  harnessRun(*device, 2000);
+  TEST_ASSERT_EQUAL(0, ESP.restarts);
+  TEST_ASSERT_TRUE(SPIFFS.exists(BOOT_CACHE_FILE));
+
+  uint32_t verifies = fakeNodeIoT.count("/api/devices/verify");
+  TEST_ASSERT_TRUE(verifies >= 2);
+
+  fakeNodeIoT.garbledVerify = false;
+  harnessRun(*device, 60000);
+  TEST_ASSERT_TRUE(fakeNodeIoT.count("/api/devices/verify") > verifies);
+  TEST_ASSERT_EQUAL(0, ESP.restarts);
+
+  // revalidado, o dispositivo busca os últimos valores
+  TEST_ASSERT_EQUAL(2, fakeNodeIoT.count("/api/devices/getdata"));
+}
+
+void test_config_survives_interrupted_write()
+{
+  harnessReset();
+  harnessConfigure();
+  fakeNodeIoT.gpio = GPIO_LED;
+  std::string config = SPIFFS.contents(CONFIG_FILE);
+
+  // energia caiu no meio da cópia temporária: o arquivo atual vale e a cópia é descartada
+  File file = SPIFFS.open(CONFIG_TEMP_FILE, "w");
+  file.print("{\"deviceId\":\"band");
+  file.close();
+
+  std::unique_ptr<RemoteIO> device(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  TEST_ASSERT_FALSE(SPIFFS.exists(CONFIG_TEMP_FILE));
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+
+  // energia caiu entre o remove() e o rename(): a cópia completa assume o lugar do arquivo
+  config = SPIFFS.contents(CONFIG_FILE);
+  SPIFFS.remove(CONFIG_FILE);
+  file = SPIFFS.open(CONFIG_TEMP_FILE, "w");
+  file.print(config.c_str());
+  file.close();
+
+  device.reset(new RemoteIO());
+  device->begin(nullptr, nullptr);
+  TEST_ASSERT_FALSE(SPIFFS.exists(CONFIG_TEMP_FILE));
+  TEST_ASSERT_EQUAL_STRING(config.c_str(), SPIFFS.contents(CONFIG_FILE).c_str());
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  TEST_ASSERT_EQUAL(1, device->getWiFiJoinStats().directJoins);
+}
+
+void test_aggregate_summary_survives_failed_uplink()
+{
+  std::unique_ptr<RemoteIO> device = harnessDevice(
+    "[{\"ref\":\"nivel\",\"pin\":17,\"type\":\"INPUT_ANALOG\",\"mode\":\"aggregate\",\"delay\":5,\"percentiles\":true}]");
+  TEST_ASSERT_TRUE(harnessConnect(*device));
+  stubAnalogValue = 512;
+
+  // o resumo da janela segue pela fila de envio, como as demais amostras
+  harnessRun(*device, 7500);
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.samples.size());
+  TEST_ASSERT_EQUAL_STRING("nivel", fakeNodeIoT.samples[0].ref.c_str());
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples[0].hasStats);
+
+  // POST recusado seguidas vezes: o resumo vai para o diário inteiro e volta com o reenvio
+  fakeNodeIoT.dataStatus = 503;
+  harnessRun(*device, 30000);
+  TEST_ASSERT_TRUE(device->getUplinkStats().journaled > 0);
+  TEST_ASSERT_EQUAL(1, fakeNodeIoT.samples.size());
+
+  fakeNodeIoT.dataStatus = 200;
+  harnessRun(*device, 30000);
+  TEST_ASSERT_TRUE(fakeNodeIoT.samples.size() > 1);
+  for (const FakeSample &sample : fakeNodeIoT.samples) TEST_ASSERT_TRUE(sample.hasStats);
+}
+
+
+// Cada passagem do loop() em tempo simulado, do boot ao tráfego normal: só o connect com
+// handshake TLS (e a sondagem MFLN) ainda bloqueia, uma vez por passagem em que acontece.
+void test_loop_never_blocks()
+{
+  harnessReset();
+  harnessConfigure();
+  fakeNodeIoT.gpio = GPIO_LED;
+  fakeNodeIoT.latency = 40;
+  fakeNodeIoT.idleTimeout = 800;    // conexões ociosas caem: o teste passa por novos handshakes
+  stubTls.handshakeTime = 1200;
+  stubTls.resumedTime = 300;
+
+  RemoteIO device;
+  device.begin(nullptr, nullptr);
+  device.setUplinkBatch(8, 2000);
+
+  uint32_t worst = 0;
+  uint32_t tlsPasses = 0;
+
+  for (int i = 0; i < 30000; i++)
+  {
+    // sem tráfego entre 20 s e 25 s: o servidor fecha a conexão ociosa
+    bool quiet = (i >= 20000) && (i < 25000);
+
+    if (!quiet && (i % 20 == 0)) device.espPOST("temperatura", String(i));
+    if (!quiet && (i % 50 == 0) && device.getBootMetrics().connected) fakeNodeIoT.event("digitalOutput", "led", (i & 64) ? "1" : "0");
+    if (i == 15000) fakeNodeIoT.dataStatus = 503;   // falha: a fila vai para o diário, que é reenviado depois
+    if (i == 17000) fakeNodeIoT.dataStatus = 200;
+
+    uint32_t tls = stubTls.handshakes + stubTls.probes;
+    stubMillis++;
+    stubRunTickers();
+
+    uint32_t start = micros();
+    device.loop();
+    uint32_t elapsed = micros() - start;
+
+    if (stubTls.handshakes + stubTls.probes != tls) tlsPasses++;
+    else if (elapsed > worst) worst = elapsed;
+  }
+
+  TEST_ASSERT_TRUE(device.getBootMetrics().connected > 0);
+  TEST_ASSERT_TRUE(fakeNodeIoT.dataRequests > 0);
+  TEST_ASSERT_TRUE(device.getUplinkStats().failures > 0);
+  TEST_ASSERT_LESS_THAN(5000, worst);
+  TEST_ASSERT_EQUAL(stubTls.handshakes + stubTls.probes, tlsPasses);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_boot_connects_to_platform);
+  RUN_TEST(test_boot_without_credentials_stays_offline);
+  RUN_TEST(test_command_reaches_pin);
+  RUN_TEST(test_uplink_batch_reaches_platform);
+  RUN_TEST(test_uplink_retries_transient_failure);
+  RUN_TEST(test_journal_skips_rejected_batch);
+  RUN_TEST(test_journal_replays_before_sntp);
+  RUN_TEST(test_socket_uplink_one_event_per_batch);
+  RUN_TEST(test_config_update_replaces_io_table);
+  RUN_TEST(test_board_outputs_boot_at_safe_level);
+  RUN_TEST(test_rule_reads_cyclic_input_fresh);
+  RUN_TEST(test_wifi_lease_survives_platform_outage);
+  RUN_TEST(test_revalidate_keeps_cache_on_garbled_response);
+  RUN_TEST(test_config_survives_interrupted_write);
+  RUN_TEST(test_aggregate_summary_survives_failed_uplink);
+  RUN_TEST(test_msgpack_uplink);
+  RUN_TEST(test_chunked_responses);
+  RUN_TEST(test_server_closes_connection);
+  RUN_TEST(test_local_api_requires_key);
+  RUN_TEST(test_setup_requires_key_once_provisioned);
+  RUN_TEST(test_loop_never_blocks);
+  return UNITY_END();
+}
@@ -0,0 +1,252 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes das regras locais: limites, histerese, holdTime e       ##
+##   orçamento por chamada.                                         ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include "RemoteIORules.h"
+#include <stdio.h>
+#include <chrono>
+
+#define TEST_SLOTS 40
+#define NO_WRITE -1000
+#define RULES_THROUGHPUT_ROUNDS 200   // vezes que cada regra é avaliada no teste de vazão
+
+static int32_t inputs[TEST_SLOTS];
+static bool ready[TEST_SLOTS];
+static int32_t outputs[TEST_SLOTS];
+static uint8_t writes;
+
+static bool readSlot(uint8_t slot, int32_t &value, void *context)
+{
+  value = inputs[slot];
+  return ready[slot];
+}
+
+static void writeSlot(uint8_t slot, int32_t value, void *context)
+{
+  outputs[slot] = value;
+  writes++;
+}
+
+static Rule makeRule(uint8_t op, int32_t threshold, int32_t hysteresis, uint32_t holdTime, bool hasElse)
+{
+  Rule rule;
+  rule.input = 0;
+  rule.output = 1;
+  rule.op = op;
+  rule.flags = hasElse ? RULE_HAS_ELSE : 0;
+  rule.threshold = threshold;
+  rule.hysteresis = hysteresis;
+  rule.onValue = 1;
+  rule.offValue = 0;
+  rule.holdTime = holdTime;
+  rule.since = 0;
+  return rule;
+}
+
+void setUp()
+{
+  for (uint8_t i = 0; i < TEST_SLOTS; i++)
+  {
+    inputs[i] = 0;
+    ready[i] = true;
+    outputs[i] = NO_WRITE;
+  }
+  writes = 0;
+}
+
+void tearDown() {}
+
+void test_rules_op_from_string()
+{
+  TEST_ASSERT_EQUAL(RULE_GREATER, RemoteIORules::opFromString(">"));
+  TEST_ASSERT_EQUAL(RULE_GREATER_EQUAL, RemoteIORules::opFromString(">="));
+  TEST_ASSERT_EQUAL(RULE_LESS, RemoteIORules::opFromString("<"));
+  TEST_ASSERT_EQUAL(RULE_LESS_EQUAL, RemoteIORules::opFromString("<="));
+  TEST_ASSERT_EQUAL(RULE_EQUAL, RemoteIORules::opFromString("=="));
+  TEST_ASSERT_EQUAL(RULE_NOT_EQUAL, RemoteIORules::opFromString("!="));
+  TEST_ASSERT_EQUAL(RULE_INVALID, RemoteIORules::opFromString("=>"));
+}
+
+void test_rules_rejects_invalid_and_full()
+{
+  RemoteIORules rules;
+
+  TEST_ASSERT_FALSE(rules.add(makeRule(RULE_INVALID, 0, 0, 0, false)));
+
+  for (uint16_t i = 0; i < RULES_CAPACITY; i++) TEST_ASSERT_TRUE(rules.add(makeRule(RULE_GREATER, 0, 0, 0, false)));
+
+  TEST_ASSERT_FALSE(rules.add(makeRule(RULE_GREATER, 0, 0, 0, false)));
+  TEST_ASSERT_EQUAL(RULES_CAPACITY, rules.size());
+}
+
+void test_rules_threshold_with_hysteresis()
+{
+  RemoteIORules rules;
+  rules.add(makeRule(RULE_GREATER, 500, 20, 0, true));
+
+  inputs[0] = 501;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(1, outputs[1]);
+  TEST_ASSERT_EQUAL(1, rules.activations);
+
+  // dentro da histerese: continua ativa, sem nova escrita
+  writes = 0;
+  inputs[0] = 490;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(0, writes);
+
+  inputs[0] = 480;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(0, outputs[1]);
+  TEST_ASSERT_EQUAL(1, writes);
+}
+
+void test_rules_hold_time()
+{
+  RemoteIORules rules;
+  rules.add(makeRule(RULE_LESS, 100, 0, 1000, false));
+
+  inputs[0] = 50;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  rules.evaluate(999, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(NO_WRITE, outputs[1]);
+
+  rules.evaluate(1000, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(1, outputs[1]);
+
+  // sem "else", a saída fica como está quando a condição deixa de valer
+  inputs[0] = 200;
+  rules.evaluate(2000, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(1, outputs[1]);
+}
+
+void test_rules_hold_time_restarts()
+{
+  RemoteIORules rules;
+  rules.add(makeRule(RULE_EQUAL, 1, 0, 500, false));
+
+  inputs[0] = 1;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  inputs[0] = 0;
+  rules.evaluate(400, readSlot, writeSlot, NULL);
+  inputs[0] = 1;
+  rules.evaluate(600, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(NO_WRITE, outputs[1]);
+
+  rules.evaluate(1100, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(1, outputs[1]);
+}
+
+void test_rules_else_on_first_evaluation()
+{
+  RemoteIORules rules;
+  rules.add(makeRule(RULE_GREATER, 500, 0, 0, true));
+
+  inputs[0] = 10;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(0, outputs[1]);
+
+  // depois da primeira avaliação, o "else" só age na transição
+  writes = 0;
+  rules.evaluate(10, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(0, writes);
+}
+
+void test_rules_wait_for_first_reading()
+{
+  RemoteIORules rules;
+  rules.add(makeRule(RULE_GREATER, 500, 0, 0, true));
+
+  // entrada ainda sem leitura: nem o "else" inicial é aplicado
+  ready[0] = false;
+  rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(0, writes);
+
+  ready[0] = true;
+  inputs[0] = 600;
+  rules.evaluate(10, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(1, outputs[1]);
+  TEST_ASSERT_EQUAL(1, writes);
+}
+
+void test_rules_budget_per_call()
+{
+  RemoteIORules rules;
+
+  for (uint16_t i = 0; i < RULES_CAPACITY; i++)
+  {
+    Rule rule = makeRule(RULE_GREATER, 0, 0, 0, false);
+    rule.output = i % (TEST_SLOTS - 1) + 1;
+    rules.add(rule);
+  }
+
+  inputs[0] = 1;
+  TEST_ASSERT_EQUAL(RULES_BUDGET, rules.evaluate(0, readSlot, writeSlot, NULL));
+  TEST_ASSERT_EQUAL(RULES_BUDGET, writes);
+
+  // as chamadas seguintes continuam de onde a anterior parou
+  for (uint16_t call = 1; call < (RULES_CAPACITY + RULES_BUDGET - 1) / RULES_BUDGET; call++) rules.evaluate(0, readSlot, writeSlot, NULL);
+  TEST_ASSERT_EQUAL(RULES_CAPACITY, rules.activations);
+  for (uint16_t i = 0; i < RULES_CAPACITY && i < TEST_SLOTS - 1; i++) TEST_ASSERT_EQUAL(1, outputs[i + 1]);
+}
+
+void test_rules_throughput()
+{
+  RemoteIORules rules;
+
+  // centenas de regras: o build nativo compila com -DRULES_CAPACITY=512
+  TEST_ASSERT_TRUE(RULES_CAPACITY >= 256);
+
+  for (uint16_t i = 0; i < RULES_CAPACITY; i++)
+  {
+    Rule rule = makeRule(RULE_GREATER + i % 4, 100 * (i % 8), 20, i % 3, true);
+    rule.input = i % 8;
+    rule.output = 8 + i % (TEST_SLOTS - 8);
+    TEST_ASSERT_TRUE(rules.add(rule));
+  }
+
+  // entradas em rampa: as regras ativam e desativam ao longo da varredura
+  uint32_t calls = (uint32_t)RULES_THROUGHPUT_ROUNDS * RULES_CAPACITY / RULES_BUDGET;
+  uint32_t evaluated = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t call = 0; call < calls; call++)
+  {
+    for (uint8_t i = 0; i < 8; i++) inputs[i] = (call * 7 + i * 100) % 900;
+
+    uint8_t count = rules.evaluate(call, readSlot, writeSlot, NULL);
+    TEST_ASSERT_TRUE(count <= RULES_BUDGET);
+    evaluated += count;
+  }
+
+  uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)RULES_THROUGHPUT_ROUNDS * RULES_CAPACITY, evaluated);
+  TEST_ASSERT_TRUE(rules.activations > 0);
+
+  printf("[bench] regras: %u regras, %lu avaliações em %llu us no host (%.1f ns/regra), cada regra revista a cada %u chamadas de evaluate()\n",
+         (unsigned)RULES_CAPACITY, (unsigned long)evaluated, (unsigned long long)(nanos / 1000), (double)nanos / evaluated,
+         (unsigned)((RULES_CAPACITY + RULES_BUDGET - 1) / RULES_BUDGET));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_rules_op_from_string);
+  RUN_TEST(test_rules_rejects_invalid_and_full);
+  RUN_TEST(test_rules_threshold_with_hysteresis);
+  RUN_TEST(test_rules_hold_time);
+  RUN_TEST(test_rules_hold_time_restarts);
+  RUN_TEST(test_rules_else_on_first_evaluation);
+  RUN_TEST(test_rules_wait_for_first_reading);
+  RUN_TEST(test_rules_budget_per_call);
+  RUN_TEST(test_rules_throughput);
+  return UNITY_END();
+}
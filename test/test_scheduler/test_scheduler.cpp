@@ -0,0 +1,167 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes da agenda das leituras cíclicas.                        ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include "RemoteIOScheduler.h"
+
+#define SCHEDULER_TEST_BUDGET 4     // INPUT_SCHEDULER_BUDGET do firmware
+
+// uma passagem do schedulerLogic(): até budget leituras vencidas, cada uma reagendada
+static uint8_t runPass(RemoteIOScheduler &scheduler, uint32_t now, uint32_t interval, uint32_t samples[])
+{
+  uint8_t taken = 0;
+
+  for (; taken < SCHEDULER_TEST_BUDGET; taken++)
+  {
+    int slot = scheduler.next(now);
+    if (slot < 0) break;
+
+    TEST_ASSERT_TRUE((int32_t)(now - scheduler.dueAt(slot)) >= 0);
+    samples[slot]++;
+    scheduler.advance(slot, interval, now);
+  }
+  return taken;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_scheduler_orders_by_due_time()
+{
+  RemoteIOScheduler scheduler;
+
+  scheduler.add(3, 300);
+  scheduler.add(1, 100);
+  scheduler.add(2, 200);
+  TEST_ASSERT_EQUAL(3, scheduler.size());
+  TEST_ASSERT_FALSE(scheduler.add(1, 50));      // já agendado
+  TEST_ASSERT_FALSE(scheduler.add(SCHEDULER_CAPACITY, 50));
+
+  TEST_ASSERT_EQUAL(-1, scheduler.next(99));
+  TEST_ASSERT_EQUAL(1, scheduler.next(100));
+
+  scheduler.advance(1, 1000, 100);
+  TEST_ASSERT_EQUAL(1100, scheduler.dueAt(1));
+  TEST_ASSERT_EQUAL(2, scheduler.next(250));
+  scheduler.advance(2, 1000, 250);
+  TEST_ASSERT_EQUAL(3, scheduler.next(300));
+  scheduler.advance(3, 1000, 300);
+  TEST_ASSERT_EQUAL(-1, scheduler.next(1099));
+  TEST_ASSERT_EQUAL(1, scheduler.next(1100));
+}
+
+void test_scheduler_keeps_cadence()
+{
+  RemoteIOScheduler scheduler;
+  scheduler.add(0, 1000);
+
+  // atraso pequeno: a próxima leitura mantém a cadência original
+  scheduler.advance(0, 5000, 1200);
+  TEST_ASSERT_EQUAL(6000, scheduler.dueAt(0));
+
+  // atraso maior que o intervalo: recomeça a partir de agora, sem rajada de leituras atrasadas
+  scheduler.advance(0, 5000, 20000);
+  TEST_ASSERT_EQUAL(25000, scheduler.dueAt(0));
+}
+
+void test_scheduler_unscheduled_slot()
+{
+  RemoteIOScheduler scheduler;
+
+  // leitura pedida pelo sketch (updatePinInput) de um slot fora do heap
+  TEST_ASSERT_FALSE(scheduler.scheduled(5));
+  TEST_ASSERT_TRUE(scheduler.due(5, 0));
+  scheduler.advance(5, 5000, 100);
+  TEST_ASSERT_EQUAL(5000, scheduler.dueAt(5));
+  TEST_ASSERT_FALSE(scheduler.due(5, 4999));
+  TEST_ASSERT_TRUE(scheduler.due(5, 5000));
+  TEST_ASSERT_EQUAL(-1, scheduler.next(10000));
+}
+
+void test_scheduler_millis_wrap()
+{
+  RemoteIOScheduler scheduler;
+  uint32_t start = 0xFFFFFFFFUL - 12000;
+  uint32_t samples[SCHEDULER_CAPACITY] = {};
+
+  // intervalos diferentes, com vencimentos dos dois lados da volta do relógio
+  for (uint8_t slot = 0; slot < 8; slot++) scheduler.add(slot, start + slot * 3000);
+
+  uint32_t now = start;
+  for (uint32_t step = 0; step < 60000; step++, now++)
+  {
+    uint32_t before[SCHEDULER_CAPACITY];
+    for (uint8_t slot = 0; slot < 8; slot++) before[slot] = samples[slot];
+
+    runPass(scheduler, now, 5000, samples);
+
+    // nenhuma leitura antes da hora, e nenhuma vencida deixada para trás
+    for (uint8_t slot = 0; slot < 8; slot++)
+    {
+      if (samples[slot] != before[slot]) TEST_ASSERT_EQUAL(now + 5000, scheduler.dueAt(slot));
+      TEST_ASSERT_FALSE(scheduler.due(slot, now));
+    }
+  }
+
+  // 60 s em 5 s de intervalo, começando entre 0 e 21 s depois do início
+  for (uint8_t slot = 0; slot < 8; slot++)
+  {
+    uint32_t expected = (60000 - 1 - slot * 3000) / 5000 + 1;
+    TEST_ASSERT_EQUAL(expected, samples[slot]);
+  }
+}
+
+void test_scheduler_fair_budget()
+{
+  RemoteIOScheduler scheduler;
+  uint32_t samples[SCHEDULER_CAPACITY] = {};
+  uint32_t now = 1000;
+
+  // 32 leituras vencendo juntas: 4 por passagem, todas atendidas em 8 passagens, nenhuma duas vezes
+  for (uint8_t slot = 0; slot < SCHEDULER_CAPACITY; slot++) scheduler.add(slot, now);
+
+  for (uint8_t pass = 0; pass < SCHEDULER_CAPACITY / SCHEDULER_TEST_BUDGET; pass++)
+  {
+    TEST_ASSERT_EQUAL(SCHEDULER_TEST_BUDGET, runPass(scheduler, now, 5000, samples));
+  }
+  for (uint8_t slot = 0; slot < SCHEDULER_CAPACITY; slot++) TEST_ASSERT_EQUAL(1, samples[slot]);
+  TEST_ASSERT_EQUAL(0, runPass(scheduler, now, 5000, samples));
+
+  // sobrecarga a partir do próximo vencimento: com intervalo de 2 ms e 4 leituras por passagem
+  // de 1 ms, o ciclo dos 32 slots leva 8 ms; todos avançam juntos, nenhum fica para trás
+  for (uint8_t slot = 0; slot < SCHEDULER_CAPACITY; slot++) samples[slot] = 0;
+  now = scheduler.dueAt(0) - 1;
+
+  for (uint32_t step = 0; step < 8000; step++)
+  {
+    now++;
+    runPass(scheduler, now, 2, samples);
+  }
+
+  uint32_t least = samples[0];
+  uint32_t most = samples[0];
+  for (uint8_t slot = 1; slot < SCHEDULER_CAPACITY; slot++)
+  {
+    if (samples[slot] < least) least = samples[slot];
+    if (samples[slot] > most) most = samples[slot];
+  }
+  TEST_ASSERT_TRUE(most - least <= 1);
+  TEST_ASSERT_EQUAL(8000 * SCHEDULER_TEST_BUDGET / SCHEDULER_CAPACITY, least);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_scheduler_orders_by_due_time);
+  RUN_TEST(test_scheduler_keeps_cadence);
+  RUN_TEST(test_scheduler_unscheduled_slot);
+  RUN_TEST(test_scheduler_millis_wrap);
+  RUN_TEST(test_scheduler_fair_budget);
+  return UNITY_END();
+}
@@ -0,0 +1,339 @@
+/*
+######################################################################
+##      Integração das tecnologias da REMOTE IO com Node IOT        ##
+##                                                                  ##
+##   Testes da codificação dos corpos HTTP em JSON e MessagePack    ##
+##   e da leitura do getdata, um elemento por vez.                  ##
+##                                                                  ##
+######################################################################
+*/
+
+#include <unity.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <StreamString.h>
+#include "RemoteIOWire.h"
+
+#define WIRE_TEST_TIMESTAMP 1700000000    // 0x6553F100: o uint32 do MessagePack tem um byte 0x00
+
+// lote como o de sendUplinkBatch, com zeros em vários formatos
+static void buildBatch(JsonDocument &document)
+{
+  JsonArray batch = document.to<JsonArray>();
+
+  for (int i = 0; i < 3; i++)
+  {
+    JsonObject item = batch.add<JsonObject>();
+    item["deviceId"] = "bancada";
+    item["ref"] = "nivel";
+    item["value"] = i;
+    item["timestamp"] = WIRE_TEST_TIMESTAMP + i;
+  }
+  batch[0]["micros"] = 0;
+}
+
+static void checkBatch(JsonDocument &document)
+{
+  TEST_ASSERT_EQUAL(3, document.size());
+  for (int i = 0; i < 3; i++)
+  {
+    TEST_ASSERT_EQUAL_STRING("bancada", document[i]["deviceId"] | "");
+    TEST_ASSERT_EQUAL_STRING("nivel", document[i]["ref"] | "");
+    TEST_ASSERT_EQUAL(i, document[i]["value"].as<int>());
+    TEST_ASSERT_EQUAL(WIRE_TEST_TIMESTAMP + i, document[i]["timestamp"].as<uint32_t>());
+  }
+  TEST_ASSERT_EQUAL(0, document[0]["micros"].as<int>());
+  TEST_ASSERT_TRUE(document[0]["micros"].is<int>());
+}
+
+static void roundTrip(bool msgpack)
+{
+  JsonDocument document;
+  buildBatch(document);
+
+  size_t length = RemoteIOWire::measure(document, msgpack);
+  uint8_t buffer[256];
+  memset(buffer, 0xAA, sizeof(buffer));
+
+  TEST_ASSERT_EQUAL(length, RemoteIOWire::encode(document, msgpack, buffer, length + 1));
+  if (msgpack) TEST_ASSERT_NOT_NULL(memchr(buffer, 0x00, length));
+
+  // o corpo segue pelo tamanho, não por um terminador
+  StreamString stream;
+  stream.write(buffer, length);
+  TEST_ASSERT_EQUAL(length, stream.available());
+
+  JsonDocument filter;
+  filter.set(true);
+  JsonDocument decoded;
+  TEST_ASSERT_TRUE(RemoteIOWire::decode(decoded, stream, msgpack, filter) == DeserializationError::Ok);
+  checkBatch(decoded);
+}
+
+// Corpo que chega aos poucos: available() mostra só o que já chegou, e read() no fim do que chegou
+// espera pelo próximo trecho, como o read() com timeout do socket no meio de um elemento.
+class TrickleStream : public Stream
+{
+  public:
+    TrickleStream(const std::string &body, size_t chunk) : data(body), step(chunk), arrived(0), position(0), stalls(0) {}
+
+    void arrive() { arrived = std::min(data.size(), arrived + step); }
+    int available() override { return arrived - position; }
+    int read() override
+    {
+      wait();
+      return (position < arrived) ? (uint8_t)data[position++] : -1;
+    }
+    int peek() override
+    {
+      wait();
+      return (position < arrived) ? (uint8_t)data[position] : -1;
+    }
+    size_t write(uint8_t) override { return 0; }
+
+    void wait()
+    {
+      if ((position < arrived) || (arrived == data.size())) return;
+      stalls++;
+      arrive();
+    }
+
+    std::string data;
+    size_t step;
+    size_t arrived;
+    size_t position;
+    uint32_t stalls;      // leituras que esperaram no meio de um elemento
+};
+
+// resposta do getdata com count refs, com um campo a mais que o filtro descarta
+static std::string latestBody(int count, bool msgpack)
+{
+  if (msgpack)
+  {
+    JsonDocument document;
+    JsonArray array = document.to<JsonArray>();
+    for (int i = 0; i < count; i++)
+    {
+      JsonObject item = array.add<JsonObject>();
+      item["ref"] = "io" + std::to_string(i);
+      item["data"][0]["value"] = std::to_string(i * 3);
+      item["data"][0]["timestamp"] = WIRE_TEST_TIMESTAMP;
+      item["name"] = "descartado";
+    }
+    std::string body;
+    serializeMsgPack(document, body);
+    return body;
+  }
+
+  // JSON com espaços e quebras de linha entre os elementos
+  std::string body = "\r\n [";
+  for (int i = 0; i < count; i++)
+  {
+    if (i > 0) body += (i % 2) ? ",\n  " : " , ";
+    body += "{\"ref\":\"io" + std::to_string(i) + "\",\"data\":[{\"value\":\"" + std::to_string(i * 3) + "\",\"timestamp\":1700000000}],\"name\":\"descartado\"}";
+  }
+  return body + " ]";
+}
+
+static void parseLatest(int count, bool msgpack)
+{
+  TrickleStream stream(latestBody(count, msgpack), 61);
+  RemoteIOWireArray array;
+  JsonDocument filter;
+  filter["ref"] = true;
+  filter["data"][0]["value"] = true;
+  JsonDocument element;
+
+  uint8_t step;
+  int index = 0;
+  uint32_t waits = 0;
+
+  while ((step = array.next(stream, msgpack, element, filter)) != WIRE_END)
+  {
+    TEST_ASSERT_TRUE(step != WIRE_ERROR);
+
+    if (step == WIRE_WAIT)
+    {
+      // nada disponível: o chamador volta na próxima passagem, quando mais bytes chegaram
+      TEST_ASSERT_EQUAL(0, stream.available());
+      waits++;
+      stream.arrive();
+      continue;
+    }
+
+    TEST_ASSERT_EQUAL_STRING(("io" + std::to_string(index)).c_str(), element["ref"] | "");
+    TEST_ASSERT_EQUAL_STRING(std::to_string(index * 3).c_str(), element["data"][0]["value"] | "");
+    TEST_ASSERT_TRUE(element["name"].isNull());
+    TEST_ASSERT_TRUE(element["data"][0]["timestamp"].isNull());
+    index++;
+  }
+
+  TEST_ASSERT_EQUAL(count, index);
+  TEST_ASSERT_EQUAL(count, array.count);
+  TEST_ASSERT_EQUAL(stream.data.size(), stream.position);
+  TEST_ASSERT_TRUE(waits > 0);             // parou entre elementos
+  TEST_ASSERT_TRUE(stream.stalls > 0);     // e esperou no meio de um
+  TEST_ASSERT_EQUAL(WIRE_END, array.next(stream, msgpack, element, filter));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_wire_msgpack_round_trip()
+{
+  roundTrip(true);
+}
+
+void test_wire_json_round_trip()
+{
+  roundTrip(false);
+}
+
+void test_wire_encode_needs_capacity()
+{
+  JsonDocument document;
+  buildBatch(document);
+  uint8_t buffer[256];
+
+  size_t json = RemoteIOWire::measure(document, false);
+  size_t msgpack = RemoteIOWire::measure(document, true);
+
+  // o JSON precisa de um byte para o '\0'; o MessagePack cabe no tamanho exato
+  TEST_ASSERT_EQUAL(0, RemoteIOWire::encode(document, false, buffer, json));
+  TEST_ASSERT_EQUAL(json, RemoteIOWire::encode(document, false, buffer, json + 1));
+  TEST_ASSERT_EQUAL(0, RemoteIOWire::encode(document, true, buffer, msgpack - 1));
+  TEST_ASSERT_EQUAL(msgpack, RemoteIOWire::encode(document, true, buffer, msgpack));
+  TEST_ASSERT_TRUE(msgpack < json);
+}
+
+static void fillItem(JsonDocument &item, int i)
+{
+  item["deviceId"] = "bancada";
+  item["ref"] = "io" + std::to_string(i);
+  item["value"] = i * 7;
+  item["timestamp"] = WIRE_TEST_TIMESTAMP + i;
+}
+
+// o array gravado item a item tem os mesmos bytes do array montado num documento só
+static void batchMatchesDocument(int count, bool msgpack)
+{
+  JsonDocument whole;
+  JsonArray array = whole.to<JsonArray>();
+  size_t capacity = RemoteIOWireBatch::overhead(count, msgpack);
+
+  for (int i = 0; i < count; i++)
+  {
+    JsonDocument item;
+    fillItem(item, i);
+    array.add(item);
+    capacity += RemoteIOWire::measure(item, msgpack);
+  }
+
+  std::vector<uint8_t> expected(RemoteIOWire::measure(whole, msgpack) + 1);
+  size_t expectedLength = RemoteIOWire::encode(whole, msgpack, expected.data(), expected.size());
+
+  std::vector<uint8_t> body(capacity);
+  RemoteIOWireBatch batch;
+  batch.begin(body.data(), capacity, count, msgpack);
+  for (int i = 0; i < count; i++)
+  {
+    JsonDocument item;
+    fillItem(item, i);
+    TEST_ASSERT_TRUE(batch.add(item));
+  }
+
+  TEST_ASSERT_EQUAL(expectedLength, batch.end());
+  TEST_ASSERT_EQUAL_MEMORY(expected.data(), body.data(), expectedLength);
+}
+
+void test_wire_batch_by_element()
+{
+  // 20 elementos: no MessagePack, cabeçalho de array de 3 bytes
+  for (int count : { 0, 1, 3, 20 })
+  {
+    batchMatchesDocument(count, false);
+    batchMatchesDocument(count, true);
+  }
+
+  // buffer menor que o corpo: nada é enviado pela metade
+  uint8_t body[32];
+  RemoteIOWireBatch batch;
+  batch.begin(body, sizeof(body), 2, false);
+  JsonDocument item;
+  fillItem(item, 0);
+  TEST_ASSERT_FALSE(batch.add(item));
+  TEST_ASSERT_EQUAL(0, batch.end());
+}
+
+void test_wire_content_type()
+{
+  TEST_ASSERT_EQUAL_STRING(WIRE_MSGPACK_TYPE, RemoteIOWire::contentType(true));
+  TEST_ASSERT_EQUAL_STRING(WIRE_JSON_TYPE, RemoteIOWire::contentType(false));
+}
+
+void test_wire_latest_json()
+{
+  parseLatest(10, false);
+  parseLatest(100, false);
+  parseLatest(500, false);
+}
+
+void test_wire_latest_msgpack()
+{
+  // 10 refs: fixarray; 100 e 500: array 16
+  parseLatest(10, true);
+  parseLatest(100, true);
+  parseLatest(500, true);
+}
+
+void test_wire_latest_empty_and_invalid()
+{
+  JsonDocument filter;
+  filter.set(true);
+  JsonDocument element;
+
+  RemoteIOWireArray array;
+  TrickleStream empty(" [ ] ", 64);
+  empty.arrive();
+  TEST_ASSERT_EQUAL(WIRE_END, array.next(empty, false, element, filter));
+  TEST_ASSERT_EQUAL(0, array.count);
+
+  array.begin();
+  TrickleStream emptyMsgPack(std::string(1, (char)0x90), 64);
+  emptyMsgPack.arrive();
+  TEST_ASSERT_EQUAL(WIRE_END, array.next(emptyMsgPack, true, element, filter));
+
+  array.begin();
+  TrickleStream object("{\"ref\":\"io0\"}", 64);
+  object.arrive();
+  TEST_ASSERT_EQUAL(WIRE_ERROR, array.next(object, false, element, filter));
+  TEST_ASSERT_EQUAL(WIRE_END, array.next(object, false, element, filter));
+
+  array.begin();
+  TrickleStream objectMsgPack(std::string(1, (char)0x81), 64);
+  objectMsgPack.arrive();
+  TEST_ASSERT_EQUAL(WIRE_ERROR, array.next(objectMsgPack, true, element, filter));
+
+  // nada chegou ainda: espera, sem consumir
+  array.begin();
+  TrickleStream late("[]", 64);
+  TEST_ASSERT_EQUAL(WIRE_WAIT, array.next(late, false, element, filter));
+  late.arrive();
+  TEST_ASSERT_EQUAL(WIRE_END, array.next(late, false, element, filter));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_wire_msgpack_round_trip);
+  RUN_TEST(test_wire_json_round_trip);
+  RUN_TEST(test_wire_encode_needs_capacity);
+  RUN_TEST(test_wire_batch_by_element);
+  RUN_TEST(test_wire_content_type);
+  RUN_TEST(test_wire_latest_json);
+  RUN_TEST(test_wire_latest_msgpack);
+  RUN_TEST(test_wire_latest_empty_and_invalid);
+  return UNITY_END();
+}